@@ -116,8 +116,8 @@ class Client {
 
   Metrics metrics_;
 
-  // Transaction RSA signer
-  std::optional<bftEngine::impl::RSASigner> transaction_signer_;
+  // Transaction signer (RSA or Ed25519, depending on the key)
+  std::unique_ptr<bftEngine::impl::IRawSigner> transaction_signer_;
 
   static constexpr int64_t MAX_VALUE_NANOSECONDS = 1000 * 1000 * 1000;  // 1 second
   static constexpr int64_t MAX_TRANSACTION_SIZE = 100 * 1024 * 1024;    // 100MB
@@ -52,7 +52,7 @@ Client::Client(std::unique_ptr<bft::communication::ICommunication> comm, const C
       key_plaintext = smp.decryptFile(file_path);
     }
     if (!key_plaintext) throw InvalidPrivateKeyException(file_path, config.secrets_manager_config != std::nullopt);
-    transaction_signer_ = RSASigner(key_plaintext.value().c_str(), KeyFormat::PemFormat);
+    transaction_signer_ = createRawSigner(key_plaintext.value().c_str(), KeyFormat::PemFormat);
   }
   communication_->setReceiver(config_.id.val, &receiver_);
   communication_->Start();
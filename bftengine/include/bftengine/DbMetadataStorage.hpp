@@ -16,6 +16,7 @@
 #include <mutex>
 #include <map>
 #include <memory>
+#include <optional>
 #include "Logger.hpp"
 #include "bftengine/MetadataStorage.hpp"
 #include "storage/db_interface.h"
@@ -44,14 +45,18 @@ class DBMetadataStorage : public bftEngine::MetadataStorage {
   void atomicWrite(uint32_t objectId, const char *data, uint32_t dataLength) override;
   void beginAtomicWriteOnlyBatch() override;
   void writeInBatch(uint32_t objectId, const char *data, uint32_t dataLength) override;
+  void writeSliverInBatch(uint32_t objectId, concordUtils::Sliver &&data) override;
   void commitAtomicWriteOnlyBatch() override;
   concordUtils::Status multiDel(const ObjectIdsVector &objectIds);
   bool isNewStorage() override;
   void eraseData() override;
 
  private:
+  typedef std::map<ObjectId, concordUtils::Sliver> ObjectIdToDataMap;
+
   void verifyOperation(uint32_t objectId, uint32_t dataLen, const char *buffer, bool writeOperation) const;
   void cleanDB();
+  void addToBatch(uint32_t objectId, concordUtils::Sliver &&data);
 
  private:
   const char *WRONG_FLOW = "beginAtomicWriteOnlyBatch should be launched first";
@@ -61,7 +66,7 @@ class DBMetadataStorage : public bftEngine::MetadataStorage {
 
   logging::Logger logger_;
   IDBClient *dbClient_ = nullptr;
-  SetOfKeyValuePairs *batch_ = nullptr;
+  std::optional<ObjectIdToDataMap> batch_;
   std::mutex ioMutex_;
   ObjectIdToSizeMap objectIdToSizeMap_;
   uint32_t objectsNum_ = 0;
@@ -15,6 +15,8 @@
 
 #include <stdint.h>
 
+#include "sliver.hpp"
+
 namespace bftEngine {
 
 // MetadataStorage class functions could throw runtime_error exceptions.
@@ -47,6 +49,11 @@ class MetadataStorage {
   // Atomic write-only transactions
   virtual void beginAtomicWriteOnlyBatch() = 0;
   virtual void writeInBatch(uint32_t objectId, const char *data, uint32_t dataLength) = 0;
+  // Same as writeInBatch(), but takes ownership of an already serialized object. Storage implementations that keep
+  // the data around until commit can use it without copying.
+  virtual void writeSliverInBatch(uint32_t objectId, concordUtils::Sliver &&data) {
+    writeInBatch(objectId, data.data(), data.length());
+  }
   virtual void commitAtomicWriteOnlyBatch() = 0;
 
   // In some cases, we would like to load a new metadata after a crash (for example, on reconfiguration actions).
@@ -33,7 +33,7 @@ namespace bftEngine {
   CONFIG_PARAM_RO(param, type, default_val, description);   \
   void set##param(const type& val) { param = val; } /* NOLINT(bugprone-macro-parentheses) */
 
-enum BatchingPolicy { BATCH_SELF_ADJUSTED, BATCH_BY_REQ_SIZE, BATCH_BY_REQ_NUM, BATCH_ADAPTIVE };
+enum BatchingPolicy { BATCH_SELF_ADJUSTED, BATCH_BY_REQ_SIZE, BATCH_BY_REQ_NUM, BATCH_ADAPTIVE, BATCH_LATENCY_TARGET };
 
 class ReplicaConfig : public concord::serialize::SerializableFactory<ReplicaConfig> {
  public:
@@ -59,6 +59,10 @@ class ReplicaConfig : public concord::serialize::SerializableFactory<ReplicaConf
   CONFIG_PARAM(numOfClientProxies, uint16_t, 0, "number of objects that represent clients, numOfClientProxies >= 1");
   CONFIG_PARAM(numOfExternalClients, uint16_t, 0, "number of objects that represent external clients");
   CONFIG_PARAM(sizeOfInternalThreadPool, uint16_t, 8, "number of threads in the internal replica thread pool");
+  CONFIG_PARAM(numOfMsgPreValidationThreads,
+               uint16_t,
+               0,
+               "number of threads validating incoming messages ahead of the dispatcher thread (0 - disabled)");
   CONFIG_PARAM(statusReportTimerMillisec, uint16_t, 0, "how often the replica sends a status report to other replicas");
   CONFIG_PARAM(concurrencyLevel,
                uint16_t,
@@ -116,6 +120,10 @@ class ReplicaConfig : public concord::serialize::SerializableFactory<ReplicaConf
   CONFIG_PARAM(adaptiveBatchingMidIncCond, std::string, "0.9", "The mid increase condition");
   CONFIG_PARAM(adaptiveBatchingMinIncCond, std::string, "0.75", "The min increase condition");
   CONFIG_PARAM(adaptiveBatchingDecCond, std::string, "0.5", "The decrease condition");
+  CONFIG_PARAM(batchingLatencyTargetMillis,
+               uint32_t,
+               100,
+               "The p99 latency of consensus and execution of a batch that the BATCH_LATENCY_TARGET policy aims for");
 
   // Crypto system
   // RSA public keys of all replicas. map from replica identifier to a public key
@@ -139,9 +147,49 @@ class ReplicaConfig : public concord::serialize::SerializableFactory<ReplicaConf
   // Pruning parameters
   CONFIG_PARAM(pruningEnabled_, bool, false, "Enable pruning");
   CONFIG_PARAM(numBlocksToKeep_, uint64_t, 0, "how much blocks to keep while pruning");
+  CONFIG_PARAM(pruningOnline_,
+               bool,
+               false,
+               "prune batch_blocks_num blocks on every pruning tick (see PruneRequest) instead of stopping consensus "
+               "until all blocks are pruned");
 
   CONFIG_PARAM(debugPersistentStorageEnabled, bool, false, "whether persistent storage debugging is enabled");
   CONFIG_PARAM(deleteMetricsDumpInterval, uint64_t, 300, "delete metrics dump interval (s)");
+  CONFIG_PARAM(kvbcLatestValuesCacheSize,
+               uint64_t,
+               0,
+               "number of latest values of versioned and block merkle keys cached in memory by the blockchain (0 - "
+               "disabled)");
+  CONFIG_PARAM(blockArchiveHorizon,
+               uint64_t,
+               1000,
+               "blocks this many blocks older than the last block are copied to the block archive in the background, if "
+               "one is set; pruning closer than this to the last block waits for the archive (must be larger than 0)");
+  CONFIG_PARAM(kvbcBlockSegmentsPath,
+               std::string,
+               "",
+               "directory of the append-only segment files that keep the serialized blocks (empty - disabled)");
+  CONFIG_PARAM(kvbcBlockSegmentSize, uint64_t, 256 * 1024 * 1024, "size of a block segment file (bytes)");
+  CONFIG_PARAM(kvbcSTLinkPrefetchThreads,
+               uint32_t,
+               0,
+               "number of threads that read state transfer blocks ahead while they are linked to the blockchain (0 - "
+               "disabled)");
+  CONFIG_PARAM(kvbcBlockMerkleInternalNodesCacheSize,
+               uint64_t,
+               0,
+               "number of recently written block merkle tree internal nodes cached in memory per category (0 - "
+               "disabled)");
+  CONFIG_PARAM(kvbcUpdatesRecordingPath,
+               std::string,
+               "",
+               "path prefix of the files the categorized updates of added blocks are recorded to, e.g. for replaying "
+               "them with kvbcbench; every start records to a new file named after the start time (empty - disabled)");
+  CONFIG_PARAM(kvbcColumnFamilyProfilesBlockCacheSize,
+               uint64_t,
+               0,
+               "block cache size split between the per-access-pattern RocksDB profiles of the categorized blockchain "
+               "column families (bytes, 0 - disabled)");
 
   // Messages
   CONFIG_PARAM(maxExternalMessageSize, uint32_t, 131072, "maximum size of external message");
@@ -268,6 +316,17 @@ class ReplicaConfig : public concord::serialize::SerializableFactory<ReplicaConf
     serialize(outStream, timeServiceSoftLimitMillis);
     serialize(outStream, timeServiceEpsilonMillis);
     serialize(outStream, numWorkerThreadsForBlockIO);
+    serialize(outStream, numOfMsgPreValidationThreads);
+    serialize(outStream, batchingLatencyTargetMillis);
+    serialize(outStream, pruningOnline_);
+    serialize(outStream, kvbcLatestValuesCacheSize);
+    serialize(outStream, blockArchiveHorizon);
+    serialize(outStream, kvbcBlockSegmentsPath);
+    serialize(outStream, kvbcBlockSegmentSize);
+    serialize(outStream, kvbcSTLinkPrefetchThreads);
+    serialize(outStream, kvbcBlockMerkleInternalNodesCacheSize);
+    serialize(outStream, kvbcUpdatesRecordingPath);
+    serialize(outStream, kvbcColumnFamilyProfilesBlockCacheSize);
 
     serialize(outStream, config_params_);
   }
@@ -337,6 +396,17 @@ class ReplicaConfig : public concord::serialize::SerializableFactory<ReplicaConf
     deserialize(inStream, timeServiceSoftLimitMillis);
     deserialize(inStream, timeServiceEpsilonMillis);
     deserialize(inStream, numWorkerThreadsForBlockIO);
+    deserialize(inStream, numOfMsgPreValidationThreads);
+    deserialize(inStream, batchingLatencyTargetMillis);
+    deserialize(inStream, pruningOnline_);
+    deserialize(inStream, kvbcLatestValuesCacheSize);
+    deserialize(inStream, blockArchiveHorizon);
+    deserialize(inStream, kvbcBlockSegmentsPath);
+    deserialize(inStream, kvbcBlockSegmentSize);
+    deserialize(inStream, kvbcSTLinkPrefetchThreads);
+    deserialize(inStream, kvbcBlockMerkleInternalNodesCacheSize);
+    deserialize(inStream, kvbcUpdatesRecordingPath);
+    deserialize(inStream, kvbcColumnFamilyProfilesBlockCacheSize);
 
     deserialize(inStream, config_params_);
   }
@@ -407,7 +477,18 @@ inline std::ostream& operator<<(std::ostream& os, const ReplicaConfig& rc) {
               rc.timeServiceEpsilonMillis.count(),
               rc.numWorkerThreadsForBlockIO);
   os << ",";
-  os << KVLOG(rc.batchedPreProcessEnabled);
+  os << KVLOG(rc.batchedPreProcessEnabled,
+              rc.numOfMsgPreValidationThreads,
+              rc.batchingLatencyTargetMillis,
+              rc.pruningOnline_,
+              rc.kvbcLatestValuesCacheSize,
+              rc.blockArchiveHorizon,
+              rc.kvbcBlockSegmentsPath,
+              rc.kvbcBlockSegmentSize,
+              rc.kvbcSTLinkPrefetchThreads,
+              rc.kvbcBlockMerkleInternalNodesCacheSize,
+              rc.kvbcUpdatesRecordingPath,
+              rc.kvbcColumnFamilyProfilesBlockCacheSize);
 
   for (auto& [param, value] : rc.config_params_) os << param << ": " << value << "\n";
   return os;
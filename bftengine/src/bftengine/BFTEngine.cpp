@@ -72,6 +72,9 @@ bool ReplicaInternal::isRunning() const { return replica_->isRunning(); }
 
 void ReplicaInternal::start() {
   preprocessor::PreProcessor::setAggregator(replica_->getAggregator());
+  if (auto aggregator = replica_->getAggregator()) {
+    replica_->getMsgsCommunicator()->getIncomingMsgsStorage()->setAggregator(aggregator);
+  }
   replica_->start();
 }
 
@@ -190,7 +193,12 @@ IReplica::IReplicaPtr IReplica::createNewReplica(const ReplicaConfig &replicaCon
       std::make_unique<IncomingMsgsStorageImp>(msgHandlersPtr, timersResolution, replicaConfig.replicaId);
   auto &timers = incomingMsgsStorageImpPtr->timers();
   shared_ptr<IncomingMsgsStorage> incomingMsgsStoragePtr{std::move(incomingMsgsStorageImpPtr)};
-  shared_ptr<bft::communication::IReceiver> msgReceiverPtr(new MsgReceiver(incomingMsgsStoragePtr));
+  shared_ptr<MsgPreValidator> msgPreValidatorPtr;
+  if (replicaConfig.numOfMsgPreValidationThreads > 0) {
+    msgPreValidatorPtr = std::make_shared<MsgPreValidator>(
+        msgHandlersPtr, incomingMsgsStoragePtr, replicaConfig.numOfMsgPreValidationThreads);
+  }
+  shared_ptr<bft::communication::IReceiver> msgReceiverPtr(new MsgReceiver(incomingMsgsStoragePtr, msgPreValidatorPtr));
   shared_ptr<MsgsCommunicator> msgsCommunicatorPtr(
       new MsgsCommunicator(communication, incomingMsgsStoragePtr, msgReceiverPtr));
   if (isNewStorage) {
@@ -203,6 +211,7 @@ IReplica::IReplicaPtr IReplica::createNewReplica(const ReplicaConfig &replicaCon
                                                    timers,
                                                    pm,
                                                    sm);
+    replicaImp->setMsgPreValidator(msgPreValidatorPtr);
     replicaInternal = std::make_unique<ReplicaInternal>(replicaImp->ticksGenerator(), persistentStoragePtr);
     replicaInternal->replica_ = std::move(replicaImp);
   } else {
@@ -222,6 +231,7 @@ IReplica::IReplicaPtr IReplica::createNewReplica(const ReplicaConfig &replicaCon
                                                    timers,
                                                    pm,
                                                    sm);
+    replicaImp->setMsgPreValidator(msgPreValidatorPtr);
     replicaInternal = std::make_unique<ReplicaInternal>(replicaImp->ticksGenerator(), persistentStoragePtr);
     replicaInternal->replica_ = std::move(replicaImp);
   }
@@ -32,8 +32,11 @@
 
 #include "DigestType.h"
 #include <cryptopp/cryptlib.h>
+#include <cryptopp/asn.h>
 #include "cryptopp/ida.h"
 #include <cryptopp/eccrypto.h>
+#include <cryptopp/xed25519.h>
+#include <cryptopp/base64.h>
 
 using namespace CryptoPP;
 using namespace std;
@@ -296,5 +299,135 @@ bool RSAVerifier::verify(const char* data,
   return impl_->verify(data, lengthOfData, signature, lengthOfOSignature);
 }
 
+// Returns the DER encoding of a key in either format
+static string keyToDer(const char* key, KeyFormat format) {
+  string der;
+  if (format == KeyFormat::HexaDecimalStrippedFormat) {
+    StringSource s(key, true, new HexDecoder(new StringSink(der)));
+  } else if (format == KeyFormat::PemFormat) {
+    // Drop the armor lines, the rest is the base64 encoded DER
+    istringstream pem(key);
+    string line, base64;
+    while (getline(pem, line)) {
+      if (line.rfind("-----", 0) != 0) base64 += line;
+    }
+    StringSource s(base64, true, new Base64Decoder(new StringSink(der)));
+  } else {
+    throw runtime_error("Invalid keyType!");
+  }
+  return der;
+}
+
+// Decodes the algorithm of a PKCS #8 (SEQUENCE {version, AlgorithmIdentifier, key}) or an X.509 SubjectPublicKeyInfo
+// (SEQUENCE {AlgorithmIdentifier, key}) encoded key and compares it with the Ed25519 OID (1.3.101.112)
+static bool isEd25519Key(const char* key, KeyFormat format) {
+  static const OID ed25519Oid = OID(1) + 3 + 101 + 112;
+  try {
+    StringSource der(keyToDer(key, format), true);
+    BERSequenceDecoder keyInfo(der);
+    CryptoPP::byte tag = 0;
+    if (keyInfo.Peek(tag) && tag == INTEGER) {
+      word32 version = 0;
+      BERDecodeUnsigned<word32>(keyInfo, version, INTEGER, 0, 1);
+    }
+    BERSequenceDecoder algorithm(keyInfo);
+    OID oid;
+    oid.BERDecode(algorithm);
+    return oid == ed25519Oid;
+  } catch (const Exception&) {
+    return false;
+  }
+}
+
+class Ed25519Signer::Impl {
+ public:
+  Impl(BufferedTransformation& privateKey) : priv(privateKey) {}
+
+  size_t signatureLength() const { return priv.SignatureLength(); }
+
+  bool sign(const char* inBuffer,
+            size_t lengthOfInBuffer,
+            char* outBuffer,
+            size_t lengthOfOutBuffer,
+            size_t& lengthOfReturnedData) const {
+    const size_t sigLen = priv.SignatureLength();
+    if (lengthOfOutBuffer < sigLen) return false;
+    // Ed25519 signatures are deterministic, the generator is not used
+    lengthOfReturnedData =
+        priv.SignMessage(sGlobalRandGen, (CryptoPP::byte*)inBuffer, lengthOfInBuffer, (CryptoPP::byte*)outBuffer);
+    VERIFY(lengthOfReturnedData == sigLen);
+
+    return true;
+  }
+
+ private:
+  ed25519::Signer priv;
+};
+
+class Ed25519Verifier::Impl {
+ public:
+  Impl(BufferedTransformation& publicKey) : pub(publicKey) {}
+
+  size_t signatureLength() const { return pub.SignatureLength(); }
+
+  bool verify(const char* data, size_t lengthOfData, const char* signature, size_t lengthOfOSignature) const {
+    return pub.VerifyMessage((CryptoPP::byte*)data, lengthOfData, (CryptoPP::byte*)signature, lengthOfOSignature);
+  }
+
+ private:
+  ed25519::Verifier pub;
+};
+
+Ed25519Signer::Ed25519Signer(const char* privateKey, KeyFormat format) {
+  StringSource s(keyToDer(privateKey, format), true);
+  impl_ = std::make_unique<Impl>(s);
+}
+
+Ed25519Signer::Ed25519Signer(Ed25519Signer&&) = default;
+
+Ed25519Signer::~Ed25519Signer() = default;
+
+Ed25519Signer& Ed25519Signer::operator=(Ed25519Signer&&) = default;
+
+size_t Ed25519Signer::signatureLength() const { return impl_->signatureLength(); }
+
+bool Ed25519Signer::sign(const char* inBuffer,
+                         size_t lengthOfInBuffer,
+                         char* outBuffer,
+                         size_t lengthOfOutBuffer,
+                         size_t& lengthOfReturnedData) const {
+  return impl_->sign(inBuffer, lengthOfInBuffer, outBuffer, lengthOfOutBuffer, lengthOfReturnedData);
+}
+
+Ed25519Verifier::Ed25519Verifier(const char* publicKey, KeyFormat format) {
+  StringSource s(keyToDer(publicKey, format), true);
+  impl_ = std::make_unique<Impl>(s);
+}
+
+Ed25519Verifier::Ed25519Verifier(Ed25519Verifier&&) = default;
+
+Ed25519Verifier::~Ed25519Verifier() = default;
+
+Ed25519Verifier& Ed25519Verifier::operator=(Ed25519Verifier&&) = default;
+
+size_t Ed25519Verifier::signatureLength() const { return impl_->signatureLength(); }
+
+bool Ed25519Verifier::verify(const char* data,
+                             size_t lengthOfData,
+                             const char* signature,
+                             size_t lengthOfOSignature) const {
+  return impl_->verify(data, lengthOfData, signature, lengthOfOSignature);
+}
+
+std::unique_ptr<IRawSigner> createRawSigner(const char* privateKey, KeyFormat format) {
+  if (isEd25519Key(privateKey, format)) return std::make_unique<Ed25519Signer>(privateKey, format);
+  return std::make_unique<RSASigner>(privateKey, format);
+}
+
+std::unique_ptr<IRawVerifier> createRawVerifier(const char* publicKey, KeyFormat format) {
+  if (isEd25519Key(publicKey, format)) return std::make_unique<Ed25519Verifier>(publicKey, format);
+  return std::make_unique<RSAVerifier>(publicKey, format);
+}
+
 }  // namespace impl
 }  // namespace bftEngine
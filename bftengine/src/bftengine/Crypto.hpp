@@ -64,7 +64,26 @@ class ECDSAVerifier : public IVerifier {
   std::unique_ptr<Impl> impl_;
 };
 
-class RSASigner {
+// Signer and verifier of raw buffers, so that the scheme (RSA or Ed25519) of a principal can be chosen by its key
+class IRawSigner {
+ public:
+  virtual size_t signatureLength() const = 0;
+  virtual bool sign(const char* inBuffer,
+                    size_t lengthOfInBuffer,
+                    char* outBuffer,
+                    size_t lengthOfOutBuffer,
+                    size_t& lengthOfReturnedData) const = 0;
+  virtual ~IRawSigner() = default;
+};
+
+class IRawVerifier {
+ public:
+  virtual size_t signatureLength() const = 0;
+  virtual bool verify(const char* data, size_t lengthOfData, const char* signature, size_t lengthOfOSignature) const = 0;
+  virtual ~IRawVerifier() = default;
+};
+
+class RSASigner : public IRawSigner {
  public:
   RSASigner(const char* privteKey, const char* randomSeed);
   explicit RSASigner(const char* privateKey, KeyFormat format = KeyFormat::HexaDecimalStrippedFormat);
@@ -73,19 +92,19 @@ class RSASigner {
   ~RSASigner();
   RSASigner& operator=(const RSASigner&) = delete;
   RSASigner& operator=(RSASigner&&);
-  size_t signatureLength() const;
+  size_t signatureLength() const override;
   bool sign(const char* inBuffer,
             size_t lengthOfInBuffer,
             char* outBuffer,
             size_t lengthOfOutBuffer,
-            size_t& lengthOfReturnedData) const;
+            size_t& lengthOfReturnedData) const override;
 
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
 };
 
-class RSAVerifier {
+class RSAVerifier : public IRawVerifier {
  public:
   RSAVerifier(const char* publicKey, const char* randomSeed);
   explicit RSAVerifier(const char* publicKey, KeyFormat format = KeyFormat::HexaDecimalStrippedFormat);
@@ -95,14 +114,56 @@ class RSAVerifier {
   ~RSAVerifier();
   RSAVerifier& operator=(const RSAVerifier&) = delete;
   RSAVerifier& operator=(RSAVerifier&&);
-  size_t signatureLength() const;
-  bool verify(const char* data, size_t lengthOfData, const char* signature, size_t lengthOfOSignature) const;
+  size_t signatureLength() const override;
+  bool verify(const char* data, size_t lengthOfData, const char* signature, size_t lengthOfOSignature) const override;
 
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
 };
 
+// Ed25519 keys are DER encoded (PKCS #8 private keys and X.509 public keys), either as stripped hex or as PEM.
+// Signatures are 64 bytes long.
+class Ed25519Signer : public IRawSigner {
+ public:
+  explicit Ed25519Signer(const char* privateKey, KeyFormat format = KeyFormat::HexaDecimalStrippedFormat);
+  Ed25519Signer(const Ed25519Signer&) = delete;
+  Ed25519Signer(Ed25519Signer&&);
+  ~Ed25519Signer();
+  Ed25519Signer& operator=(const Ed25519Signer&) = delete;
+  Ed25519Signer& operator=(Ed25519Signer&&);
+  size_t signatureLength() const override;
+  bool sign(const char* inBuffer,
+            size_t lengthOfInBuffer,
+            char* outBuffer,
+            size_t lengthOfOutBuffer,
+            size_t& lengthOfReturnedData) const override;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+class Ed25519Verifier : public IRawVerifier {
+ public:
+  explicit Ed25519Verifier(const char* publicKey, KeyFormat format = KeyFormat::HexaDecimalStrippedFormat);
+  Ed25519Verifier(const Ed25519Verifier&) = delete;
+  Ed25519Verifier(Ed25519Verifier&&);
+  ~Ed25519Verifier();
+  Ed25519Verifier& operator=(const Ed25519Verifier&) = delete;
+  Ed25519Verifier& operator=(Ed25519Verifier&&);
+  size_t signatureLength() const override;
+  bool verify(const char* data, size_t lengthOfData, const char* signature, size_t lengthOfOSignature) const override;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+// Return an Ed25519 signer/verifier for Ed25519 keys and an RSA one otherwise
+std::unique_ptr<IRawSigner> createRawSigner(const char* privateKey, KeyFormat format);
+std::unique_ptr<IRawVerifier> createRawVerifier(const char* publicKey, KeyFormat format);
+
 class DigestUtil {
  public:
   static size_t digestLength();
@@ -99,22 +99,30 @@ void DBMetadataStorage::beginAtomicWriteOnlyBatch() {
     LOG_INFO(logger_, "Transaction has been opened before; ignoring");
     return;
   }
-  batch_ = new SetOfKeyValuePairs;
+  batch_.emplace();
 }
 
 void DBMetadataStorage::writeInBatch(uint32_t objectId, const char *data, uint32_t dataLength) {
   LOG_TRACE(logger_, "writeInBatch: objectId=" << objectId << ", dataLength=" << dataLength);
   verifyOperation(objectId, dataLength, data, true);
-  Sliver copy = Sliver::copy(data, dataLength);
+  addToBatch(objectId, Sliver::copy(data, dataLength));
+}
+
+void DBMetadataStorage::writeSliverInBatch(uint32_t objectId, Sliver &&data) {
+  LOG_TRACE(logger_, "writeSliverInBatch: objectId=" << objectId << ", dataLength=" << data.length());
+  verifyOperation(objectId, data.length(), data.data(), true);
+  addToBatch(objectId, std::move(data));
+}
+
+void DBMetadataStorage::addToBatch(uint32_t objectId, Sliver &&data) {
   lock_guard<mutex> lock(ioMutex_);
   if (!batch_) {
     LOG_ERROR(logger_, WRONG_FLOW);
     throw runtime_error(WRONG_FLOW);
   }
-  // Delete an older parameter with the same key (if exists) before inserting a new one.
-  auto elem = batch_->find(metadataKeyManipulator_->generateMetadataKey(objectId));
-  if (elem != batch_->end()) batch_->erase(elem);
-  batch_->insert(KeyValuePair(metadataKeyManipulator_->generateMetadataKey(objectId), copy));
+  // An older parameter with the same id (if exists) is replaced by the new one.
+  // Keys are generated once per object at commit time.
+  batch_->insert_or_assign(objectId, std::move(data));
 }
 
 void DBMetadataStorage::commitAtomicWriteOnlyBatch() {
@@ -124,14 +132,18 @@ void DBMetadataStorage::commitAtomicWriteOnlyBatch() {
     LOG_ERROR(logger_, WRONG_FLOW);
     throw runtime_error(WRONG_FLOW);
   }
-  Status status = dbClient_->multiPut(*batch_);
+  SetOfKeyValuePairs batch;
+  batch.reserve(batch_->size());
+  for (const auto &[objectId, data] : *batch_) {
+    batch.emplace(metadataKeyManipulator_->generateMetadataKey(objectId), data);
+  }
+  Status status = dbClient_->multiPut(batch);
   LOG_DEBUG(logger_, "End Commit atomic transaction");
   if (!status.isOK()) {
     LOG_ERROR(logger_, "DBClient multiPut operation failed");
     throw runtime_error("DBClient multiPut operation failed");
   }
-  delete batch_;
-  batch_ = nullptr;
+  batch_.reset();
 }
 
 Status DBMetadataStorage::multiDel(const ObjectIdsVector &objectIds) {
@@ -17,6 +17,7 @@
 #include "messages/MessageBase.hpp"
 #include "messages/InternalMessage.hpp"
 #include "messages/IncomingMsg.hpp"
+#include "Metrics.hpp"
 
 #include <functional>
 #include <memory>
@@ -33,6 +34,8 @@ class IncomingMsgsStorage {
 
   virtual bool isRunning() const = 0;
 
+  virtual void setAggregator(const std::shared_ptr<concordMetrics::Aggregator>& aggregator) = 0;
+
   using Callback = std::function<void()>;
 
   // Below methods return true if message is pushed and false otherwise (e.g. queue capacity has been reached).
@@ -28,26 +28,34 @@ IncomingMsgsStorageImp::IncomingMsgsStorageImp(const std::shared_ptr<MsgHandlers
     : IncomingMsgsStorage(),
       msgHandlers_(msgHandlersPtr),
       msgWaitTimeout_(msgWaitTimeout),
+      metrics_{concordMetrics::Component("incomingMsgsStorage", std::make_shared<concordMetrics::Aggregator>())},
+      droppedClientMsgs_{metrics_.RegisterAtomicCounter("droppedClientMsgs")},
+      droppedConsensusMsgs_{metrics_.RegisterAtomicCounter("droppedConsensusMsgs")},
       take_lock_recorder_(histograms_.take_lock),
       wait_for_cv_recorder_(histograms_.wait_for_cv) {
   replicaId_ = replicaId;
-  ptrProtectedQueueForExternalMessages_ = new queue<MessageWithCallback>();
+  metrics_.Register();
+  for (size_t i = 0; i < numOfShards_; i++) {
+    consensusQueues_.push_back(std::make_unique<ExternalMsgsQueue>(maxNumberOfPendingExternalMsgs_));
+    clientQueues_.push_back(std::make_unique<ExternalMsgsQueue>(maxNumberOfPendingExternalMsgs_ / numOfShards_));
+  }
   ptrProtectedQueueForInternalMessages_ = new queue<InternalMessage>();
   lastOverflowWarning_ = MinTime;
-  ptrThreadLocalQueueForExternalMessages_ = new queue<MessageWithCallback>();
   ptrThreadLocalQueueForInternalMessages_ = new queue<InternalMessage>();
 }
 
 IncomingMsgsStorageImp::~IncomingMsgsStorageImp() {
-  delete ptrProtectedQueueForExternalMessages_;
   delete ptrProtectedQueueForInternalMessages_;
-  delete ptrThreadLocalQueueForExternalMessages_;
   delete ptrThreadLocalQueueForInternalMessages_;
 }
 
 void IncomingMsgsStorageImp::start() {
   if (!dispatcherThread_.joinable()) {
     std::future<void> futureObj = signalStarted_.get_future();
+    metricsTimer_ = timers_.add(
+        milliseconds(100), concordUtil::Timers::Timer::RECURRING, [this](concordUtil::Timers::Handle) {
+          metrics_.UpdateAggregator();
+        });
     dispatcherThread_ = std::thread([=] { dispatchMessages(signalStarted_); });
     // Wait until thread starts
     futureObj.get();
@@ -58,6 +66,7 @@ void IncomingMsgsStorageImp::stop() {
   if (dispatcherThread_.joinable()) {
     stopped_ = true;
     dispatcherThread_.join();
+    timers_.cancel(metricsTimer_);
     LOG_INFO(GL, "Dispatching thread stopped");
   }
 }
@@ -66,25 +75,45 @@ bool IncomingMsgsStorageImp::pushExternalMsg(std::unique_ptr<MessageBase> msg) {
   return pushExternalMsg(std::move(msg), Callback{});
 }
 
+bool IncomingMsgsStorageImp::isClientMsg(const MessageBase& msg) {
+  switch (msg.type()) {
+    case MsgCode::ClientPreProcessRequest:
+    case MsgCode::ClientRequest:
+    case MsgCode::ClientBatchRequest:
+      return true;
+    default:
+      return false;
+  }
+}
+
+IncomingMsgsStorageImp::ExternalMsgsQueue& IncomingMsgsStorageImp::queueOf(const MessageBase& msg) {
+  auto shard = msg.senderId() % numOfShards_;
+  return isClientMsg(msg) ? *clientQueues_[shard] : *consensusQueues_[shard];
+}
+
 // can be called by any thread
 bool IncomingMsgsStorageImp::pushExternalMsg(std::unique_ptr<MessageBase> msg, Callback onMsgPopped) {
   MsgCode::Type type = static_cast<MsgCode::Type>(msg->type());
   LOG_TRACE(MSGS, type);
-  std::unique_lock<std::mutex> mlock(lock_);
-  if (ptrProtectedQueueForExternalMessages_->size() >= maxNumberOfPendingExternalMsgs_) {
+  auto& queue = queueOf(*msg);
+  const auto isClient = isClientMsg(*msg);
+  if (!queue.tryPush(std::make_pair(std::move(msg), std::move(onMsgPopped)))) {
     Time now = getMonotonicTime();
-    auto msg_type = static_cast<MsgCode::Type>(msg->type());
-    if ((now - lastOverflowWarning_) > (milliseconds(minTimeBetweenOverflowWarningsMilli_))) {
-      LOG_WARN(GL, "Queue Full. Dropping some msgs." << KVLOG(maxNumberOfPendingExternalMsgs_, msg_type));
-      lastOverflowWarning_ = now;
+    auto msg_type = type;
+    auto lastOverflowWarning = lastOverflowWarning_.load();
+    if ((now - lastOverflowWarning) > (milliseconds(minTimeBetweenOverflowWarningsMilli_)) &&
+        lastOverflowWarning_.compare_exchange_strong(lastOverflowWarning, now)) {
+      LOG_WARN(GL, "Queue Full. Dropping some msgs." << KVLOG(queue.capacity(), msg_type));
     }
-    dropped_msgs++;
+    (isClient ? droppedClientMsgs_ : droppedConsensusMsgs_)++;
+    droppedMsgs_++;
     return false;
   }
-  histograms_.dropped_msgs_in_a_row->record(dropped_msgs);
-  dropped_msgs = 0;
-  ptrProtectedQueueForExternalMessages_->push(std::make_pair(std::move(msg), std::move(onMsgPopped)));
-  condVar_.notify_one();
+  if (droppedMsgs_ > 0) histograms_.dropped_msgs_in_a_row->record(droppedMsgs_.exchange(0));
+  if (dispatcherWaiting_) {
+    std::lock_guard<std::mutex> mlock(lock_);
+    condVar_.notify_one();
+  }
   return true;
 }
 
@@ -105,6 +134,27 @@ void IncomingMsgsStorageImp::pushInternalMsg(InternalMessage&& msg) {
   condVar_.notify_one();
 }
 
+bool IncomingMsgsStorageImp::externalQueuesEmpty() const {
+  for (const auto& q : consensusQueues_)
+    if (!q->empty()) return false;
+  for (const auto& q : clientQueues_)
+    if (!q->empty()) return false;
+  return true;
+}
+
+// should only be called by the dispatching thread
+size_t IncomingMsgsStorageImp::takeExternalMsgs(std::vector<std::unique_ptr<ExternalMsgsQueue>>& queues,
+                                                size_t maxPerQueue) {
+  size_t taken = 0;
+  MessageWithCallback item;
+  for (auto& q : queues) {
+    for (size_t i = 0; i < maxPerQueue && q->tryPop(item); i++, taken++) {
+      threadLocalQueueForExternalMessages_.push(std::move(item));
+    }
+  }
+  return taken;
+}
+
 // should only be called by the dispatching thread
 IncomingMsg IncomingMsgsStorageImp::getMsgForProcessing() {
   auto msg = popThreadLocal();
@@ -114,31 +164,37 @@ IncomingMsg IncomingMsgsStorageImp::getMsgForProcessing() {
     std::unique_lock<std::mutex> mlock(lock_);
     take_lock_recorder_.end();
     {
-      if (ptrProtectedQueueForExternalMessages_->empty() && ptrProtectedQueueForInternalMessages_->empty()) {
-        LOG_TRACE(MSGS, "Waiting for condition variable");
-        wait_for_cv_recorder_.start();
-        condVar_.wait_for(mlock, msgWaitTimeout_);
-        wait_for_cv_recorder_.end();
+      if (ptrProtectedQueueForInternalMessages_->empty() && externalQueuesEmpty()) {
+        // Producers of external messages check dispatcherWaiting_ after pushing, so check the queues again after
+        // setting it, in order not to miss a message that was pushed in between
+        dispatcherWaiting_ = true;
+        if (externalQueuesEmpty()) {
+          LOG_TRACE(MSGS, "Waiting for condition variable");
+          wait_for_cv_recorder_.start();
+          condVar_.wait_for(mlock, msgWaitTimeout_);
+          wait_for_cv_recorder_.end();
+        }
+        dispatcherWaiting_ = false;
       }
 
-      // no new message
-      if (ptrProtectedQueueForExternalMessages_->empty() && ptrProtectedQueueForInternalMessages_->empty()) {
-        LOG_DEBUG(MSGS, "No pending messages");
-        return IncomingMsg();
-      }
-
-      // swap queues
-      auto t1 = ptrThreadLocalQueueForExternalMessages_;
-      ptrThreadLocalQueueForExternalMessages_ = ptrProtectedQueueForExternalMessages_;
-      ptrProtectedQueueForExternalMessages_ = t1;
-      histograms_.external_queue_len_at_swap->record(ptrThreadLocalQueueForExternalMessages_->size());
-
+      // swap internal queues
       auto* t2 = ptrThreadLocalQueueForInternalMessages_;
       ptrThreadLocalQueueForInternalMessages_ = ptrProtectedQueueForInternalMessages_;
       ptrProtectedQueueForInternalMessages_ = t2;
       histograms_.internal_queue_len_at_swap->record(ptrThreadLocalQueueForInternalMessages_->size());
     }
   }
+
+  // Consensus messages first, and more of them, so that client load doesn't delay the protocol
+  auto taken = takeExternalMsgs(consensusQueues_, consensusMsgsPerShardAndRound_);
+  taken += takeExternalMsgs(clientQueues_, clientMsgsPerShardAndRound_);
+  histograms_.external_msgs_taken_per_round->record(taken);
+
+  // no new message
+  if (threadLocalQueueForExternalMessages_.empty() && ptrThreadLocalQueueForInternalMessages_->empty()) {
+    LOG_DEBUG(MSGS, "No pending messages");
+    return IncomingMsg();
+  }
   return popThreadLocal();
 }
 
@@ -147,13 +203,13 @@ IncomingMsg IncomingMsgsStorageImp::popThreadLocal() {
     auto msg = IncomingMsg{std::move(ptrThreadLocalQueueForInternalMessages_->front())};
     ptrThreadLocalQueueForInternalMessages_->pop();
     return msg;
-  } else if (!ptrThreadLocalQueueForExternalMessages_->empty()) {
-    auto& item = ptrThreadLocalQueueForExternalMessages_->front();
+  } else if (!threadLocalQueueForExternalMessages_.empty()) {
+    auto& item = threadLocalQueueForExternalMessages_.front();
     if (item.second) {
       item.second();
     }
     auto msg = IncomingMsg{std::move(item.first)};
-    ptrThreadLocalQueueForExternalMessages_->pop();
+    threadLocalQueueForExternalMessages_.pop();
     return msg;
   } else {
     return IncomingMsg{};
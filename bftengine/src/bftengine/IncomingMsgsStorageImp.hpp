@@ -16,8 +16,10 @@
 #include "IncomingMsgsStorage.hpp"
 #include "MsgHandlersRegistrator.hpp"
 #include "Timers.hpp"
+#include "bounded_mpsc_queue.hpp"
 #include "diagnostics.h"
 #include "performance_handler.h"
+#include "Metrics.hpp"
 
 #include <queue>
 #include <atomic>
@@ -26,6 +28,7 @@
 #include <condition_variable>
 #include <future>
 #include <utility>
+#include <vector>
 
 namespace bftEngine::impl {
 
@@ -39,7 +42,7 @@ class IncomingMsgsStorageImp : public IncomingMsgsStorage {
   void start() override;
   void stop() override;
 
-  // Can be called by any thread
+  // Can be called by any thread. Never blocks: if the queue of the message is full, the message is dropped and counted.
   bool pushExternalMsg(std::unique_ptr<MessageBase> msg) override;
   bool pushExternalMsg(std::unique_ptr<MessageBase> msg, Callback onMsgPopped) override;
 
@@ -52,43 +55,71 @@ class IncomingMsgsStorageImp : public IncomingMsgsStorage {
 
   [[nodiscard]] bool isRunning() const override { return dispatcherThread_.joinable(); }
 
+  void setAggregator(const std::shared_ptr<concordMetrics::Aggregator>& aggregator) override {
+    metrics_.SetAggregator(aggregator);
+  }
+
   auto& timers() { return timers_; }
 
  private:
+  using MessageWithCallback = std::pair<std::unique_ptr<MessageBase>, Callback>;
+  using ExternalMsgsQueue = concord::util::BoundedMpscQueue<MessageWithCallback>;
+
   void dispatchMessages(std::promise<void>& signalStarted);
   IncomingMsg getMsgForProcessing();
   IncomingMsg popThreadLocal();
 
+  static bool isClientMsg(const MessageBase& msg);
+  ExternalMsgsQueue& queueOf(const MessageBase& msg);
+  bool externalQueuesEmpty() const;
+  size_t takeExternalMsgs(std::vector<std::unique_ptr<ExternalMsgsQueue>>& queues, size_t maxPerQueue);
+
  private:
   const uint64_t minTimeBetweenOverflowWarningsMilli_ = 5 * 1000;
   const uint16_t maxNumberOfPendingExternalMsgs_ = 20000;
 
+  // External messages are sharded by sender, so that the communication threads don't contend on a single lock and the
+  // messages of each sender keep their order. The client queues of all shards share maxNumberOfPendingExternalMsgs_,
+  // while each consensus queue can hold maxNumberOfPendingExternalMsgs_ by itself: the few replicas land in few
+  // shards, and a burst of a single replica (e.g. state transfer) must not be dropped because clients are busy.
+  static constexpr size_t numOfShards_ = 8;
+  // Messages of the replicas have priority over client requests: every round the dispatcher takes more of them
+  static constexpr size_t consensusMsgsPerShardAndRound_ = 64;
+  static constexpr size_t clientMsgsPerShardAndRound_ = 16;
+
   uint16_t replicaId_;
 
   std::mutex lock_;
   std::condition_variable condVar_;
+  // Set while the dispatcher waits on condVar_, so that producers of external messages only take lock_ to wake it up
+  std::atomic_bool dispatcherWaiting_ = false;
 
   std::shared_ptr<MsgHandlersRegistrator> msgHandlers_;
   std::chrono::milliseconds msgWaitTimeout_;
 
-  using MessageWithCallback = std::pair<std::unique_ptr<MessageBase>, Callback>;
+  std::vector<std::unique_ptr<ExternalMsgsQueue>> consensusQueues_;
+  std::vector<std::unique_ptr<ExternalMsgsQueue>> clientQueues_;
 
-  // New messages are pushed to ptrProtectedQueue.... ; protected by lock
-  std::queue<MessageWithCallback>* ptrProtectedQueueForExternalMessages_;
+  // New internal messages are pushed to ptrProtectedQueue.... ; protected by lock
   std::queue<InternalMessage>* ptrProtectedQueueForInternalMessages_;
 
-  // Time of last queue overflow; protected by lock
-  Time lastOverflowWarning_ = Time::min();
-  size_t dropped_msgs = 0;
+  // Time of last queue overflow
+  std::atomic<Time> lastOverflowWarning_ = Time::min();
+  std::atomic_size_t droppedMsgs_ = 0;
 
-  // Messages are fetched from ptrThreadLocalQueue...; should be accessed only by the dispatching thread
-  std::queue<MessageWithCallback>* ptrThreadLocalQueueForExternalMessages_;
+  // Messages are fetched from threadLocal/ptrThreadLocalQueue...; should be accessed only by the dispatching thread
+  std::queue<MessageWithCallback> threadLocalQueueForExternalMessages_;
   std::queue<InternalMessage>* ptrThreadLocalQueueForInternalMessages_;
 
   std::thread dispatcherThread_;
   std::promise<void> signalStarted_;
   std::atomic<bool> stopped_ = false;
   concordUtil::Timers timers_;
+  concordUtil::Timers::Handle metricsTimer_;
+
+  concordMetrics::Component metrics_;
+  concordMetrics::AtomicCounterHandle droppedClientMsgs_;
+  concordMetrics::AtomicCounterHandle droppedConsensusMsgs_;
 
   // 5 seconds
   static constexpr int64_t MAX_VALUE_NANOSECONDS = 1000 * 1000 * 1000 * 5l;
@@ -101,7 +132,7 @@ class IncomingMsgsStorageImp : public IncomingMsgsStorage {
       const auto component = "incomingMsgsStorageImp";
       if (!registrar.perf.isRegisteredComponent(component)) {
         registrar.perf.registerComponent(component,
-                                         {external_queue_len_at_swap,
+                                         {external_msgs_taken_per_round,
                                           internal_queue_len_at_swap,
                                           evaluate_timers,
                                           take_lock,
@@ -109,7 +140,8 @@ class IncomingMsgsStorageImp : public IncomingMsgsStorage {
                                           dropped_msgs_in_a_row});
       }
     }
-    DEFINE_SHARED_RECORDER(external_queue_len_at_swap, 1, 10000, 3, concord::diagnostics::Unit::COUNT);
+    // The number of external messages taken from all shards in one round (bounded by the per-shard quotas above)
+    DEFINE_SHARED_RECORDER(external_msgs_taken_per_round, 1, 10000, 3, concord::diagnostics::Unit::COUNT);
     DEFINE_SHARED_RECORDER(internal_queue_len_at_swap, 1, 10000, 3, concord::diagnostics::Unit::COUNT);
     DEFINE_SHARED_RECORDER(take_lock, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
     DEFINE_SHARED_RECORDER(wait_for_cv, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
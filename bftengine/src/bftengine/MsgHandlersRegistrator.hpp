@@ -20,6 +20,9 @@ namespace bftEngine::impl {
 
 typedef std::function<void(MessageBase*)> MsgHandlerCallback;
 typedef std::function<void(InternalMessage&&)> InternalMsgHandlerCallback;
+// Returns true if the message passed the stateless checks (size, format, signatures) of its type.
+// Called concurrently by the pre-validation threads, so it must not touch the replica state.
+typedef std::function<bool(MessageBase*)> MsgValidatorCallback;
 
 // MsgHandlersRegistrator class contains message handling callback functions.
 // Logically it's a singleton - only one message handler could be registered for every message type,
@@ -34,6 +37,11 @@ class MsgHandlersRegistrator {
     msgHandlers_[msgId] = callbackFunc;
   }
 
+  // Validators must be registered before the communication is started.
+  void registerMsgValidator(uint16_t msgId, const MsgValidatorCallback& callbackFunc) {
+    msgValidators_[msgId] = callbackFunc;
+  }
+
   void registerInternalMsgHandler(const InternalMsgHandlerCallback& cb) { internalMsgHandler_ = cb; }
 
   MsgHandlerCallback getCallback(uint16_t msgId) {
@@ -42,10 +50,17 @@ class MsgHandlersRegistrator {
     return nullptr;
   }
 
+  MsgValidatorCallback getValidator(uint16_t msgId) const {
+    auto iterator = msgValidators_.find(msgId);
+    if (iterator != msgValidators_.end()) return iterator->second;
+    return nullptr;
+  }
+
   void handleInternalMsg(InternalMessage&& msg) { internalMsgHandler_(std::move(msg)); }
 
  private:
   std::unordered_map<uint16_t, MsgHandlerCallback> msgHandlers_;
+  std::unordered_map<uint16_t, MsgValidatorCallback> msgValidators_;
   InternalMsgHandlerCallback internalMsgHandler_;
 };
 
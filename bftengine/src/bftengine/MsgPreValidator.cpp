@@ -0,0 +1,99 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0
+// License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "MsgPreValidator.hpp"
+#include "assertUtils.hpp"
+#include "Logger.hpp"
+
+using namespace std::chrono;
+using namespace concord::diagnostics;
+
+namespace bftEngine::impl {
+
+MsgPreValidator::MsgPreValidator(const std::shared_ptr<MsgHandlersRegistrator>& msgHandlersPtr,
+                                 const std::shared_ptr<IncomingMsgsStorage>& storage,
+                                 uint16_t numOfThreads)
+    : msgHandlers_(msgHandlersPtr), storage_(storage) {
+  ConcordAssertGT(numOfThreads, 0);
+  for (auto i = 0u; i < numOfThreads; i++) shards_.push_back(std::make_unique<Shard>());
+}
+
+MsgPreValidator::~MsgPreValidator() { stop(); }
+
+void MsgPreValidator::start() {
+  stopped_ = false;
+  for (auto& shard : shards_) {
+    if (!shard->thread.joinable()) shard->thread = std::thread([this, &shard = *shard] { validateMessages(shard); });
+  }
+  LOG_INFO(GL, "Messages pre-validation started" << KVLOG(shards_.size()));
+}
+
+void MsgPreValidator::stop() {
+  stopped_ = true;
+  for (auto& shard : shards_) {
+    shard->condVar.notify_one();
+    if (shard->thread.joinable()) shard->thread.join();
+  }
+}
+
+// can be called by any thread
+bool MsgPreValidator::pushExternalMsg(std::unique_ptr<MessageBase> msg) {
+  // All the messages of a sender go through the same shard, in order to keep their order
+  auto& shard = *shards_[msg->senderId() % shards_.size()];
+  std::unique_lock<std::mutex> mlock(shard.lock);
+  if (shard.queue.size() >= maxNumberOfPendingMsgsPerShard_) {
+    Time now = getMonotonicTime();
+    auto msg_type = static_cast<MsgCode::Type>(msg->type());
+    if ((now - shard.lastOverflowWarning) > (milliseconds(minTimeBetweenOverflowWarningsMilli_))) {
+      LOG_WARN(GL,
+               "Pre-validation queue full. Dropping some msgs." << KVLOG(maxNumberOfPendingMsgsPerShard_, msg_type));
+      shard.lastOverflowWarning = now;
+    }
+    return false;
+  }
+  shard.queue.push(std::move(msg));
+  shard.condVar.notify_one();
+  return true;
+}
+
+void MsgPreValidator::validateMessages(Shard& shard) {
+  std::queue<std::unique_ptr<MessageBase>> msgs;
+  while (!stopped_) {
+    {
+      std::unique_lock<std::mutex> mlock(shard.lock);
+      shard.condVar.wait_for(mlock, msgWaitTimeout_, [&] { return stopped_ || !shard.queue.empty(); });
+      if (stopped_) return;
+      histograms_.queue_len_at_swap->record(shard.queue.size());
+      msgs.swap(shard.queue);
+    }
+    while (!msgs.empty()) {
+      validateAndForward(std::move(msgs.front()));
+      msgs.pop();
+    }
+  }
+}
+
+void MsgPreValidator::validateAndForward(std::unique_ptr<MessageBase> msg) {
+  if (auto validator = msgHandlers_->getValidator(msg->type())) {
+    TimeRecorder scoped_timer(*histograms_.validate_msg);
+    // The validator reports the reason of the failure
+    if (!validator(msg.get())) {
+      invalidMsgs_++;
+      return;
+    }
+    msg->markPreValidated();
+  }
+  storage_->pushExternalMsg(std::move(msg));
+}
+
+}  // namespace bftEngine::impl
@@ -0,0 +1,92 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0
+// License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include "IncomingMsgsStorage.hpp"
+#include "MsgHandlersRegistrator.hpp"
+#include "TimeUtils.hpp"
+#include "diagnostics.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace bftEngine::impl {
+
+// MsgPreValidator runs the stateless validation of external messages (size and format checks, signature
+// verification) on a number of worker threads before the messages reach the IncomingMsgsStorage, so that the
+// dispatcher thread only handles messages that are already known to be valid.
+// Messages are sharded between the workers by their sender, so messages of the same sender are pushed to the storage
+// in the order in which they were received. Invalid messages are dropped. Messages without a registered validator
+// (see MsgHandlersRegistrator::registerMsgValidator) are passed through and validated by the dispatcher thread.
+class MsgPreValidator {
+ public:
+  MsgPreValidator(const std::shared_ptr<MsgHandlersRegistrator>& msgHandlersPtr,
+                  const std::shared_ptr<IncomingMsgsStorage>& storage,
+                  uint16_t numOfThreads);
+  ~MsgPreValidator();
+
+  void start();
+  void stop();
+
+  // Can be called by any thread. Returns false if the message was dropped because the queue of its shard is full.
+  bool pushExternalMsg(std::unique_ptr<MessageBase> msg);
+
+  uint64_t numOfInvalidMsgs() const { return invalidMsgs_; }
+
+ private:
+  struct Shard {
+    std::mutex lock;
+    std::condition_variable condVar;
+    // protected by lock
+    std::queue<std::unique_ptr<MessageBase>> queue;
+    Time lastOverflowWarning = MinTime;
+    std::thread thread;
+  };
+
+  void validateMessages(Shard& shard);
+  void validateAndForward(std::unique_ptr<MessageBase> msg);
+
+ private:
+  const uint64_t minTimeBetweenOverflowWarningsMilli_ = 5 * 1000;
+  const size_t maxNumberOfPendingMsgsPerShard_ = 20000;
+  const std::chrono::milliseconds msgWaitTimeout_{100};
+
+  std::shared_ptr<MsgHandlersRegistrator> msgHandlers_;
+  std::shared_ptr<IncomingMsgsStorage> storage_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic_bool stopped_ = false;
+  std::atomic_uint64_t invalidMsgs_ = 0;
+
+  // 60 seconds
+  static constexpr int64_t MAX_VALUE_MICROSECONDS = 1000 * 1000 * 60l;
+  struct Recorders {
+    Recorders() {
+      auto& registrar = concord::diagnostics::RegistrarSingleton::getInstance();
+      const auto component = "msgPreValidator";
+      if (!registrar.perf.isRegisteredComponent(component)) {
+        registrar.perf.registerComponent(component, {queue_len_at_swap, validate_msg});
+      }
+    }
+    DEFINE_SHARED_RECORDER(queue_len_at_swap, 1, 10000, 3, concord::diagnostics::Unit::COUNT);
+    DEFINE_SHARED_RECORDER(validate_msg, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
+  };
+  Recorders histograms_;
+};
+
+}  // namespace bftEngine::impl
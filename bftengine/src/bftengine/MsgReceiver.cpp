@@ -11,6 +11,7 @@
 
 #include "MsgReceiver.hpp"
 #include "messages/MessageBase.hpp"
+#include "ClientMsgs.hpp"
 #include "ReplicaConfig.hpp"
 #include <cstring>
 
@@ -21,6 +22,9 @@ using namespace bft::communication;
 
 MsgReceiver::MsgReceiver(std::shared_ptr<IncomingMsgsStorage> &storage) : incomingMsgsStorage_(storage) {}
 
+MsgReceiver::MsgReceiver(std::shared_ptr<IncomingMsgsStorage> &storage, std::shared_ptr<MsgPreValidator> preValidator)
+    : incomingMsgsStorage_(storage), preValidator_(std::move(preValidator)) {}
+
 void MsgReceiver::onNewMessage(NodeNum sourceNode, const char *const message, size_t messageLength) {
   if (messageLength > ReplicaConfig::instance().getmaxExternalMessageSize()) return;
   if (messageLength < sizeof(MessageBase::Header)) return;
@@ -32,6 +36,16 @@ void MsgReceiver::onNewMessage(NodeNum sourceNode, const char *const message, si
 
   std::unique_ptr<MessageBase> pMsg(new MessageBase(node, msgBody, messageLength, true));
 
+  if (preValidator_) {
+    // The pre-validation threads compute the digest of valid unsigned requests
+    preValidator_->pushExternalMsg(std::move(pMsg));
+    return;
+  }
+  // The digest of an unsigned client request is part of the digest of the PrePrepare that carries it (see
+  // PrePrepareMsg::addRequest), so compute it here rather than on the dispatcher thread
+  if (pMsg->type() == MsgCode::ClientRequest && messageLength >= sizeof(ClientRequestMsgHeader) &&
+      reinterpret_cast<const ClientRequestMsgHeader *>(msgBody)->reqSignatureLength == 0)
+    pMsg->setDigestOfMsg(Digest(pMsg->body(), pMsg->size()));
   incomingMsgsStorage_->pushExternalMsg(std::move(pMsg));
 }
 
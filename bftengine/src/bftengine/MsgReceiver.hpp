@@ -14,12 +14,15 @@
 #include "PrimitiveTypes.hpp"
 #include "communication/ICommunication.hpp"
 #include "IncomingMsgsStorage.hpp"
+#include "MsgPreValidator.hpp"
 
 namespace bftEngine::impl {
 
 class MsgReceiver : public bft::communication::IReceiver {
  public:
   explicit MsgReceiver(std::shared_ptr<IncomingMsgsStorage>& storage);
+  // Messages are passed through the preValidator (if not null) on their way to the storage
+  MsgReceiver(std::shared_ptr<IncomingMsgsStorage>& storage, std::shared_ptr<MsgPreValidator> preValidator);
   virtual ~MsgReceiver() = default;
 
   void onNewMessage(bft::communication::NodeNum sourceNode, const char* const message, size_t messageLength) override;
@@ -28,6 +31,7 @@ class MsgReceiver : public bft::communication::IReceiver {
 
  private:
   std::shared_ptr<IncomingMsgsStorage> incomingMsgsStorage_;
+  std::shared_ptr<MsgPreValidator> preValidator_;
 };
 
 }  // namespace bftEngine::impl
@@ -19,6 +19,7 @@
 
 using namespace std;
 using namespace concord::serialize;
+using concordUtils::Sliver;
 
 namespace bftEngine {
 namespace impl {
@@ -280,7 +281,7 @@ void PersistentStorageImp::saveDescriptorOfLastExecution(const DescriptorOfLastE
   size_t actualSize = 0;
   newDesc.serialize(descBufPtr, bufLen, actualSize);
   ConcordAssertNE(actualSize, 0);
-  metadataStorage_->writeInBatch(LAST_EXEC_DESC, descBuf.get(), actualSize);
+  metadataStorage_->writeSliverInBatch(LAST_EXEC_DESC, Sliver(descBuf.release(), actualSize));
 }
 
 void PersistentStorageImp::setDescriptorOfLastExecution(const DescriptorOfLastExecution &desc, bool init) {
@@ -296,7 +297,7 @@ void PersistentStorageImp::setDescriptorOfLastStableCheckpoint(
   size_t actualSize = 0;
   stableCheckDesc.serialize(descBufPtr, bufLen, actualSize);
   ConcordAssertNE(actualSize, 0);
-  metadataStorage_->writeInBatch(LAST_STABLE_CHECKPOINT_DESC, descBuf.get(), actualSize);
+  metadataStorage_->writeSliverInBatch(LAST_STABLE_CHECKPOINT_DESC, Sliver(descBuf.release(), actualSize));
 }
 
 void PersistentStorageImp::initDescriptorOfLastExecution() {
@@ -444,7 +445,7 @@ void PersistentStorageImp::setMsgInSeqNumWindow(SeqNum seqNum,
   const SeqNum convertedIndex = BEGINNING_OF_SEQ_NUM_WINDOW + parameterId + convertSeqNumWindowIndex(seqNum);
   ConcordAssertLT(convertedIndex, BEGINNING_OF_CHECK_WINDOW);
   LOG_DEBUG(GL, "PersistentStorageImp::setMsgInSeqNumWindow convertedIndex=" << convertedIndex);
-  metadataStorage_->writeInBatch(convertedIndex, buf.get(), actualSize);
+  metadataStorage_->writeSliverInBatch(convertedIndex, Sliver(buf.release(), actualSize));
 }
 
 void PersistentStorageImp::setPrePrepareMsgInSeqNumWindow(SeqNum seqNum, PrePrepareMsg *msg) {
@@ -497,7 +498,7 @@ void PersistentStorageImp::setCheckpointMsgInCheckWindow(SeqNum seqNum, Checkpoi
   const SeqNum convertedIndex = BEGINNING_OF_CHECK_WINDOW + CHECKPOINT_MSG + convertCheckWindowIndex(seqNum);
   ConcordAssertLT(convertedIndex, WIN_PARAMETERS_NUM);
   LOG_DEBUG(GL, "PersistentStorageImp::setCheckpointMsgInCheckWindow convertedIndex=" << convertedIndex);
-  metadataStorage_->writeInBatch(convertedIndex, buf.get(), actualSize);
+  metadataStorage_->writeSliverInBatch(convertedIndex, Sliver(buf.release(), actualSize));
 }
 
 void PersistentStorageImp::setUserDataAtomically(const void *data, std::size_t numberOfBytes) {
@@ -84,6 +84,7 @@ class ReplicaBase {
   bool validateMessage(MessageBase* msg) {
     try {
       if (config_.debugStatisticsEnabled) DebugStatistics::onReceivedExMessage(msg->type());
+      if (msg->isPreValidated()) return true;
 
       msg->validate(*repsInfo);
       return true;
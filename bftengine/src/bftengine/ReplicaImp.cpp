@@ -18,6 +18,7 @@
 #include "SysConsts.hpp"
 #include "ReplicaConfig.hpp"
 #include "MsgsCommunicator.hpp"
+#include "MsgPreValidator.hpp"
 #include "MsgHandlersRegistrator.hpp"
 #include "ReplicaLoader.hpp"
 #include "PersistentStorage.hpp"
@@ -120,12 +121,47 @@ void ReplicaImp::registerMsgHandlers() {
   msgHandlers_->registerMsgHandler(MsgCode::ReplicasRestartReadyProof,
                                    bind(&ReplicaImp::messageHandler<ReplicasRestartReadyProofMsg>, this, _1));
 
+  // Validation of these messages doesn't depend on the replica state, so it can be done by the pre-validation threads
+  msgHandlers_->registerMsgValidator(MsgCode::Checkpoint,
+                                     bind(&ReplicaImp::preValidateMessage<CheckpointMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::CommitPartial,
+                                     bind(&ReplicaImp::preValidateMessage<CommitPartialMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::CommitFull,
+                                     bind(&ReplicaImp::preValidateMessage<CommitFullMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::FullCommitProof,
+                                     bind(&ReplicaImp::preValidateMessage<FullCommitProofMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::NewView, bind(&ReplicaImp::preValidateMessage<NewViewMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::PrePrepare,
+                                     bind(&ReplicaImp::preValidateMessage<PrePrepareMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::PartialCommitProof,
+                                     bind(&ReplicaImp::preValidateMessage<PartialCommitProofMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::PreparePartial,
+                                     bind(&ReplicaImp::preValidateMessage<PreparePartialMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::PrepareFull,
+                                     bind(&ReplicaImp::preValidateMessage<PrepareFullMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::StartSlowCommit,
+                                     bind(&ReplicaImp::preValidateMessage<StartSlowCommitMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::ViewChange,
+                                     bind(&ReplicaImp::preValidateMessage<ViewChangeMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::ClientRequest,
+                                     bind(&ReplicaImp::preValidateMessage<ClientRequestMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(
+      MsgCode::PreProcessResult, bind(&ReplicaImp::preValidateMessage<preprocessor::PreProcessResultMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::ReplicaAsksToLeaveView,
+                                     bind(&ReplicaImp::preValidateMessage<ReplicaAsksToLeaveViewMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::ReplicaRestartReady,
+                                     bind(&ReplicaImp::preValidateMessage<ReplicaRestartReadyMsg>, this, _1));
+  msgHandlers_->registerMsgValidator(MsgCode::ReplicasRestartReadyProof,
+                                     bind(&ReplicaImp::preValidateMessage<ReplicasRestartReadyProofMsg>, this, _1));
+
   msgHandlers_->registerInternalMsgHandler([this](InternalMessage &&msg) { onInternalMsg(std::move(msg)); });
 }
 
 template <typename T>
 void ReplicaImp::messageHandler(MessageBase *msg) {
   T *trueTypeObj = new T(msg);
+  if (msg->isPreValidated()) trueTypeObj->markPreValidated();
+  if (msg->digestOfMsg()) trueTypeObj->setDigestOfMsg(*msg->digestOfMsg());
   delete msg;
   if (bftEngine::ControlStateManager::instance().getPruningProcessStatus()) {
     if constexpr (!std::is_same_v<T, ClientRequestMsg>) {
@@ -140,6 +176,27 @@ void ReplicaImp::messageHandler(MessageBase *msg) {
     delete trueTypeObj;
 }
 
+// Called by the pre-validation threads (see MsgPreValidator)
+template <typename T>
+bool ReplicaImp::preValidateMessage(MessageBase *msg) {
+  // Borrow the body of msg for the validation and give it back afterwards
+  T trueTypeObj(msg);
+  trueTypeObj.releaseOwnership();
+  msg->acquireOwnership();
+  try {
+    trueTypeObj.validate(*repsInfo);
+    if constexpr (std::is_same_v<T, ClientRequestMsg>) {
+      // The digest of an unsigned request is part of the digest of the PrePrepare that carries it (see
+      // PrePrepareMsg::addRequest), so compute it here rather than on the dispatcher thread
+      if (trueTypeObj.requestSignatureLength() == 0) msg->setDigestOfMsg(Digest(msg->body(), msg->size()));
+    }
+    return true;
+  } catch (std::exception &e) {
+    onReportAboutInvalidMessage(&trueTypeObj, e.what());
+    return false;
+  }
+}
+
 template <class T>
 void onMessage(T *);
 
@@ -147,6 +204,7 @@ bool ReplicaImp::validateMessage(MessageBase *msg) {
   if (config_.debugStatisticsEnabled) {
     DebugStatistics::onReceivedExMessage(msg->type());
   }
+  if (msg->isPreValidated()) return true;
   try {
     msg->validate(*repsInfo);
     return true;
@@ -482,7 +540,7 @@ ClientRequestMsg *ReplicaImp::addRequestToPrePrepareMessage(ClientRequestMsg *&n
   if (nextRequest->size() <= prePrepareMsg.remainingSizeForRequests()) {
     SCOPED_MDC_CID(nextRequest->getCid());
     if (clientsManager->canBecomePending(nextRequest->clientProxyId(), nextRequest->requestSeqNum())) {
-      prePrepareMsg.addRequest(nextRequest->body(), nextRequest->size());
+      prePrepareMsg.addRequest(*nextRequest);
       clientsManager->addPendingRequest(
           nextRequest->clientProxyId(), nextRequest->requestSeqNum(), nextRequest->getCid());
     }
@@ -3844,6 +3902,7 @@ ReplicaImp::ReplicaImp(bool firstTime,
 ReplicaImp::~ReplicaImp() {
   // TODO(GG): rewrite this method !!!!!!!! (notice that the order may be important here ).
   // TODO(GG): don't delete objects that are passed as params (TBD)
+  if (msgPreValidator_) msgPreValidator_->stop();
   internalThreadPool.stop();
 
   delete viewsManager;
@@ -3870,6 +3929,8 @@ void ReplicaImp::stop() {
   timers_.cancel(statusReportTimer_);
   if (viewChangeProtocolEnabled) timers_.cancel(viewChangeTimer_);
   ReplicaForStateTransfer::stop();
+  // Communication is stopped, so no new messages reach the pre-validation threads
+  if (msgPreValidator_) msgPreValidator_->stop();
 }
 
 void ReplicaImp::addTimers() {
@@ -3910,6 +3971,7 @@ void ReplicaImp::start() {
   LOG_INFO(GL, "Running ReplicaImp");
   sigManager_->SetAggregator(aggregator_);
   KeyExchangeManager::instance().setAggregator(aggregator_);
+  if (msgPreValidator_) msgPreValidator_->start();
   ReplicaForStateTransfer::start();
 
   if (config_.timeServiceEnabled) {
@@ -61,6 +61,7 @@ class PrepareFullMsg;
 class SimpleAckMsg;
 class ReplicaStatusMsg;
 class ReplicaImp;
+class MsgPreValidator;
 struct LoadedReplicaData;
 class PersistentStorage;
 class ReplicaRestartReadyMsg;
@@ -83,6 +84,9 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
   // thread pool of this replica
   util::SimpleThreadPool internalThreadPool;  // TODO(GG): !!!! rename
 
+  // Pre-validation threads (can be null). They call the validators of this replica, so it starts and stops them.
+  std::shared_ptr<MsgPreValidator> msgPreValidator_;
+
   // retransmissions manager (can be disabled)
   RetransmissionsManager* retransmissionsManager = nullptr;
 
@@ -281,6 +285,11 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
   void start() override;
   void stop() override;
 
+  // Must be called before start()
+  void setMsgPreValidator(const std::shared_ptr<MsgPreValidator>& msgPreValidator) {
+    msgPreValidator_ = msgPreValidator;
+  }
+
   std::shared_ptr<concord::cron::TicksGenerator> ticksGenerator() const { return ticks_gen_; }
 
   virtual bool isReadOnly() const override { return false; }
@@ -335,6 +344,9 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
   template <typename T>
   void messageHandler(MessageBase* msg);
 
+  template <typename T>
+  bool preValidateMessage(MessageBase* msg);
+
   void send(MessageBase*, NodeIdType) override;
   void sendAndIncrementMetric(MessageBase*, NodeIdType, CounterHandle&);
 
@@ -10,6 +10,7 @@
 // as noted in the LICENSE file.
 
 #include "RequestsBatchingLogic.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace bftEngine::batchingLogic {
@@ -24,10 +25,16 @@ RequestsBatchingLogic::RequestsBatchingLogic(InternalReplicaApi &replica,
                                              concordUtil::Timers &timers)
     : replica_(replica),
       metric_not_enough_client_requests_event_{metrics.RegisterCounter("notEnoughClientRequestsEvent")},
+      metric_batching_max_reqs_in_batch_{
+          metrics.RegisterGauge("batchingMaxNumOfRequestsInBatch", config.maxNumOfRequestsInBatch)},
+      metric_batching_flush_period_{metrics.RegisterGauge("batchingFlushPeriod", config.batchFlushPeriod)},
+      metric_batching_observed_p99_latency_{metrics.RegisterGauge("batchingObservedP99LatencyMicros", 0)},
+      metric_batching_latency_target_missed_{metrics.RegisterCounter("batchingLatencyTargetMissed")},
       batchingPolicy_((BatchingPolicy)config.batchingPolicy),
       batchingFactorCoefficient_(config.batchingFactorCoefficient),
       maxInitialBatchSize_(config.maxInitialBatchSize),
       batchFlushPeriodMs_(config.batchFlushPeriod),
+      currentFlushPeriodMs_(config.batchFlushPeriod),
       maxNumOfRequestsInBatch_(config.maxNumOfRequestsInBatch),
       increaseRate_(stod(config.adaptiveBatchingIncFactor)),
       decreaseCondition_(stod(config.adaptiveBatchingDecCond)),
@@ -36,6 +43,11 @@ RequestsBatchingLogic::RequestsBatchingLogic(InternalReplicaApi &replica,
       minIncreaseCondition_(stod(config.adaptiveBatchingMinIncCond)),
       initialBatchSize_(config.maxNumOfRequestsInBatch),
       maxBatchSizeInBytes_(config.maxBatchSizeInBytes),
+      latencyTarget_(config.batchingLatencyTargetMillis * 1000ul,
+                     config.batchFlushPeriod,
+                     config.maxNumOfRequestsInBatch,
+                     increaseRate_,
+                     minIncreaseCondition_),
       timers_(timers) {
   if (batchingPolicy_ != BATCH_SELF_ADJUSTED)
     batchFlushTimer_ = timers_.add(milliseconds(batchFlushPeriodMs_),
@@ -52,9 +64,10 @@ void RequestsBatchingLogic::onBatchFlushTimer(Timers::Handle) {
     concord::diagnostics::TimeRecorder scoped_timer(*histograms_.onBatchFlushTimer);
     lock_guard<mutex> lock(batchProcessingLock_);
     if (replica_.tryToSendPrePrepareMsg(false)) {
-      LOG_INFO(GL, "Batching flush period expired" << KVLOG(batchFlushPeriodMs_));
+      LOG_INFO(GL, "Batching flush period expired" << KVLOG(currentFlushPeriodMs_));
       closedOnFlush_ += 1;
-      timers_.reset(batchFlushTimer_, milliseconds(batchFlushPeriodMs_));
+      if (batchingPolicy_ == BATCH_LATENCY_TARGET) adjustToLatencyTarget();
+      timers_.reset(batchFlushTimer_, milliseconds(currentFlushPeriodMs_));
     }
   }
 }
@@ -115,6 +128,78 @@ void RequestsBatchingLogic::adjustPreprepareSize() {
   LOG_INFO(GL, "increasing maxBatchSize to:" << maxNumOfRequestsInBatch_);
 }
 
+LatencyTargetController::LatencyTargetController(uint64_t latencyTargetMicros,
+                                                 uint32_t maxFlushPeriodMs,
+                                                 uint32_t initialBatchSize,
+                                                 double increaseRate,
+                                                 double minIncreaseCondition)
+    : latencyTargetMicros_(latencyTargetMicros),
+      maxFlushPeriodMs_(maxFlushPeriodMs),
+      initialBatchSize_(initialBatchSize),
+      increaseRate_(std::max(increaseRate, 0.0)),
+      // Rates of 0.5 and above would make the factor 0 or negative
+      decreaseFactor_(std::clamp(1 - 2 * increaseRate, 0.0, 1.0)),
+      minIncreaseCondition_(minIncreaseCondition),
+      maxNumOfRequestsInBatch_(initialBatchSize),
+      flushPeriodMs_(maxFlushPeriodMs) {
+  if (increaseRate < 0 || increaseRate >= 0.5) {
+    LOG_WARN(GL, "The batching increase rate should be in [0, 0.5), clamping it" << KVLOG(increaseRate));
+  }
+}
+
+void LatencyTargetController::adjust(uint64_t batchLatencyMicros, double perClosedOnLogic) {
+  // Besides the latency of its batch, a request may wait in the queue for up to a flush period
+  observedLatencyMicros_ = batchLatencyMicros + flushPeriodMs_ * 1000ul;
+
+  if (targetMissed()) {
+    // Smaller batches are agreed on and executed faster
+    maxNumOfRequestsInBatch_ = (uint32_t)std::max(1.0, maxNumOfRequestsInBatch_ * decreaseFactor_);
+  } else if (perClosedOnLogic >= minIncreaseCondition_ && maxNumOfRequestsInBatch_ <= 3 * initialBatchSize_) {
+    // Batches are filled before the flush timer expires and there is room for more latency: larger batches give
+    // a higher throughput
+    maxNumOfRequestsInBatch_ += (uint32_t)std::max(1.0, maxNumOfRequestsInBatch_ * increaseRate_);
+  }
+
+  // Let requests wait for a batch to fill for as long as the latency target allows, up to the configured period
+  const auto remainingMillis =
+      latencyTargetMicros_ > batchLatencyMicros ? (latencyTargetMicros_ - batchLatencyMicros) / 1000 : 0;
+  flushPeriodMs_ = (uint32_t)std::clamp(remainingMillis, (uint64_t)1, (uint64_t)maxFlushPeriodMs_);
+}
+
+void RequestsBatchingLogic::adjustToLatencyTarget() {
+  const auto period = duration_cast<milliseconds>(steady_clock::now() - start_timer_).count();
+  if (period < latencyTargetAdjustPeriodMs_) return;
+  start_timer_ = steady_clock::now();
+
+  const auto totalConsensusesCount = closedOnLogic_ + closedOnFlush_;
+  const auto perClosedOnLogic = totalConsensusesCount ? (double)closedOnLogic_ / totalConsensusesCount : 0;
+  closedOnFlush_ = 0;
+  closedOnLogic_ = 0;
+
+  auto &perf = concord::diagnostics::RegistrarSingleton::getInstance().perf;
+  const auto component = "replica";
+  if (!perf.isRegisteredComponent(component)) return;
+  const auto consensus = perf.valuesSince(component, "consensus", consensusReading_);
+  const auto execution = perf.valuesSince(component, "executeRequestsInPrePrepareMsg", executionReading_);
+  if (consensus.count == 0) return;  // No batch was committed since the previous adjustment
+
+  // consensus is recorded in microseconds and executeRequestsInPrePrepareMsg in nanoseconds
+  const auto batchLatency = static_cast<uint64_t>(consensus.pct_99 + execution.pct_99 / 1000);
+  latencyTarget_.adjust(batchLatency, perClosedOnLogic);
+  maxNumOfRequestsInBatch_ = latencyTarget_.maxNumOfRequestsInBatch();
+  currentFlushPeriodMs_ = latencyTarget_.flushPeriodMs();
+
+  if (latencyTarget_.targetMissed()) metric_batching_latency_target_missed_++;
+  metric_batching_observed_p99_latency_.Get().Set(latencyTarget_.observedLatencyMicros());
+  metric_batching_max_reqs_in_batch_.Get().Set(maxNumOfRequestsInBatch_);
+  metric_batching_flush_period_.Get().Set(currentFlushPeriodMs_);
+  LOG_INFO(GL,
+           "Adjusted batching to the latency target" << KVLOG(latencyTarget_.observedLatencyMicros(),
+                                                               perClosedOnLogic,
+                                                               maxNumOfRequestsInBatch_,
+                                                               currentFlushPeriodMs_));
+}
+
 PrePrepareMsg *RequestsBatchingLogic::batchRequests() {
   const auto requestsInQueue = replica_.getRequestsInQueue();
   if (requestsInQueue == 0) return nullptr;
@@ -147,6 +232,15 @@ PrePrepareMsg *RequestsBatchingLogic::batchRequests() {
         if (period > batchFlushPeriodMs_ * 20) adjustPreprepareSize();
       }
     } break;
+    case BATCH_LATENCY_TARGET: {
+      lock_guard<mutex> lock(batchProcessingLock_);
+      prePrepareMsg = replica_.buildPrePrepareMsgBatchByRequestsNum(maxNumOfRequestsInBatch_);
+      if (prePrepareMsg) {
+        closedOnLogic_ += 1;
+        adjustToLatencyTarget();
+        timers_.reset(batchFlushTimer_, milliseconds(currentFlushPeriodMs_));
+      }
+    } break;
   }
   return prePrepareMsg;
 }
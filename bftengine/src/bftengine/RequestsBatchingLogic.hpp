@@ -21,6 +21,38 @@
 
 namespace bftEngine::batchingLogic {
 
+// The decisions of the BATCH_LATENCY_TARGET policy, i.e. the batch size and the flush period for the next period given
+// the latencies observed in the previous one.
+class LatencyTargetController {
+ public:
+  LatencyTargetController(uint64_t latencyTargetMicros,
+                          uint32_t maxFlushPeriodMs,
+                          uint32_t initialBatchSize,
+                          double increaseRate,
+                          double minIncreaseCondition);
+
+  // `batchLatencyMicros` is the p99 latency of agreeing on and executing a batch and `perClosedOnLogic` is the share
+  // of the batches that were filled before the flush timer expired.
+  void adjust(uint64_t batchLatencyMicros, double perClosedOnLogic);
+
+  uint32_t maxNumOfRequestsInBatch() const { return maxNumOfRequestsInBatch_; }
+  uint32_t flushPeriodMs() const { return flushPeriodMs_; }
+  // The estimated p99 latency of a request in the previous period, including the time it waited for its batch to fill.
+  uint64_t observedLatencyMicros() const { return observedLatencyMicros_; }
+  bool targetMissed() const { return observedLatencyMicros_ > latencyTargetMicros_; }
+
+ private:
+  const uint64_t latencyTargetMicros_;
+  const uint32_t maxFlushPeriodMs_;
+  const uint32_t initialBatchSize_;
+  const double increaseRate_;
+  const double decreaseFactor_;
+  const double minIncreaseCondition_;
+  uint32_t maxNumOfRequestsInBatch_;
+  uint32_t flushPeriodMs_;
+  uint64_t observedLatencyMicros_ = 0;
+};
+
 class RequestsBatchingLogic {
  public:
   RequestsBatchingLogic(InternalReplicaApi &replica,
@@ -42,9 +74,18 @@ class RequestsBatchingLogic {
 
   void adjustPreprepareSize();
 
+  // BATCH_LATENCY_TARGET: every latencyTargetAdjustPeriodMs_, feeds the p99 of the consensus and execution latencies
+  // recorded by the replica (see ReplicaImp::Recorders) since the previous adjustment to latencyTarget_. The
+  // histograms are read without taking a snapshot, so that snapshots taken via the diagnostics server are not affected
+  void adjustToLatencyTarget();
+
  private:
   InternalReplicaApi &replica_;
   concordMetrics::CounterHandle metric_not_enough_client_requests_event_;
+  concordMetrics::GaugeHandle metric_batching_max_reqs_in_batch_;
+  concordMetrics::GaugeHandle metric_batching_flush_period_;
+  concordMetrics::GaugeHandle metric_batching_observed_p99_latency_;
+  concordMetrics::CounterHandle metric_batching_latency_target_missed_;
   BatchingPolicy batchingPolicy_;
   // Variables used to heuristically compute the 'optimal' batch size
   uint32_t maxNumberOfPendingRequestsInRecentHistory_ = 0;
@@ -53,6 +94,7 @@ class RequestsBatchingLogic {
   const uint32_t batchingFactorCoefficient_;
   const uint32_t maxInitialBatchSize_;
   const uint32_t batchFlushPeriodMs_;
+  uint32_t currentFlushPeriodMs_;
   uint16_t closedOnLogic_ = 0;
   uint16_t closedOnFlush_ = 0;
   uint32_t maxNumOfRequestsInBatch_;
@@ -63,6 +105,10 @@ class RequestsBatchingLogic {
   const double minIncreaseCondition_;
   const uint32_t initialBatchSize_;
   const uint32_t maxBatchSizeInBytes_;
+  LatencyTargetController latencyTarget_;
+  concord::diagnostics::HistogramReading consensusReading_;
+  concord::diagnostics::HistogramReading executionReading_;
+  const uint32_t latencyTargetAdjustPeriodMs_ = 1000;
   concordUtil::Timers &timers_;
   concordUtil::Timers::Handle batchFlushTimer_;
   std::mutex batchProcessingLock_;
@@ -126,11 +126,11 @@ SigManager::SigManager(PrincipalId myId,
           metrics_component_.RegisterAtomicCounter("peer_replicas_signature_verification_failed"),
           metrics_component_.RegisterAtomicCounter("peer_replicas_signatures_verified"),
           metrics_component_.RegisterAtomicCounter("signature_verification_failed_on_unrecognized_participant_id")} {
-  map<KeyIndex, std::shared_ptr<RSAVerifier>> publicKeyIndexToVerifier;
+  map<KeyIndex, std::shared_ptr<IRawVerifier>> publicKeyIndexToVerifier;
   size_t numPublickeys = publickeys.size();
 
   ConcordAssert(publicKeysMapping.size() >= numPublickeys);
-  mySigner_.reset(new RSASigner(mySigPrivateKey.first.c_str(), mySigPrivateKey.second));
+  mySigner_ = createRawSigner(mySigPrivateKey.first.c_str(), mySigPrivateKey.second);
   for (const auto& p : publicKeysMapping) {
     ConcordAssert(verifiers_.count(p.first) == 0);
     ConcordAssert(p.second < numPublickeys);
@@ -138,7 +138,7 @@ SigManager::SigManager(PrincipalId myId,
     auto iter = publicKeyIndexToVerifier.find(p.second);
     const auto& [key, format] = publickeys[p.second];
     if (iter == publicKeyIndexToVerifier.end()) {
-      verifiers_[p.first] = std::make_shared<RSAVerifier>(key.c_str(), format);
+      verifiers_[p.first] = createRawVerifier(key.c_str(), format);
       publicKeyIndexToVerifier[p.second] = verifiers_[p.first];
     } else {
       verifiers_[p.first] = iter->second;
@@ -203,6 +203,42 @@ bool SigManager::verifySig(
       return false;
     }
   }
+  updateVerificationMetrics(pid, result);
+  return result;
+}
+
+std::vector<size_t> SigManager::verifySigs(const std::vector<SigToVerify>& sigs) const {
+  std::vector<size_t> invalid;
+  std::vector<std::pair<size_t, bool>> results;
+  results.reserve(sigs.size());
+  {
+    // Take the lock once for the whole batch, and look up the verifier only when the signer changes
+    std::shared_lock lock(mutex_);
+    const IRawVerifier* verifier = nullptr;
+    for (size_t i = 0; i < sigs.size(); i++) {
+      const auto& s = sigs[i];
+      if (!verifier || sigs[i - 1].pid != s.pid) {
+        auto pos = verifiers_.find(s.pid);
+        if (pos == verifiers_.end()) {
+          LOG_ERROR(GL, "Unrecognized pid " << s.pid);
+          metrics_.sigVerificationFailedOnUnrecognizedParticipantId_++;
+          metrics_component_.UpdateAggregator();
+          verifier = nullptr;
+          invalid.push_back(i);
+          continue;
+        }
+        verifier = pos->second.get();
+      }
+      const bool result = verifier->verify(s.data, s.dataLength, s.sig, s.sigLength);
+      if (!result) invalid.push_back(i);
+      results.emplace_back(i, result);
+    }
+  }
+  for (const auto& [i, result] : results) updateVerificationMetrics(sigs[i].pid, result);
+  return invalid;
+}
+
+void SigManager::updateVerificationMetrics(PrincipalId pid, bool result) const {
   bool idOfReplica = false, idOfExternalClient = false;
   idOfExternalClient = replicasInfo_.isIdOfExternalClient(pid);
   if (!idOfExternalClient) {
@@ -226,7 +262,6 @@ bool SigManager::verifySig(
         metrics_component_.UpdateAggregator();
     }
   }
-  return result;
 }
 
 void SigManager::sign(const char* data, size_t dataLength, char* outSig, uint16_t outSigLength) const {
@@ -242,7 +277,7 @@ void SigManager::setClientPublicKey(const std::string& key, PrincipalId id, KeyF
   if (replicasInfo_.isIdOfExternalClient(id)) {
     try {
       std::unique_lock lock(mutex_);
-      verifiers_.insert_or_assign(id, std::make_shared<RSAVerifier>(key.c_str(), format));
+      verifiers_.insert_or_assign(id, createRawVerifier(key.c_str(), format));
     } catch (const std::exception& e) {
       LOG_ERROR(KEY_EX_LOG, "failed to add a key for client: " << id << " reason: " << e.what());
       throw;
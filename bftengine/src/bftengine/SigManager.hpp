@@ -59,6 +59,17 @@ class SigManager {
   uint16_t getSigLength(PrincipalId pid) const;
   // returns false if actual verification failed, or if pid is invalid
   bool verifySig(PrincipalId pid, const char* data, size_t dataLength, const char* sig, uint16_t sigLength) const;
+  // A signature to verify as part of a batch (see verifySigs)
+  struct SigToVerify {
+    PrincipalId pid;
+    const char* data;
+    size_t dataLength;
+    const char* sig;
+    uint16_t sigLength;
+  };
+  // Verifies the signatures of a number of requests at once (e.g. all the client requests of a PrePrepareMsg).
+  // Returns the indices of the signatures that failed verification, or an empty vector if all are valid.
+  std::vector<size_t> verifySigs(const std::vector<SigToVerify>& sigs) const;
   void sign(const char* data, size_t dataLength, char* outSig, uint16_t outSigLength) const;
   uint16_t getMySigLength() const;
   bool isClientTransactionSigningEnabled() { return clientTransactionSigningEnabled_; }
@@ -85,6 +96,8 @@ class SigManager {
              bool clientTransactionSigningEnabled,
              ReplicasInfo& replicasInfo);
 
+  void updateVerificationMetrics(PrincipalId pid, bool result) const;
+
   static SigManager* initImpl(ReplicaId myId,
                               const Key& mySigPrivateKey,
                               const std::set<std::pair<PrincipalId, const std::string>>& publicKeysOfReplicas,
@@ -94,8 +107,8 @@ class SigManager {
                               ReplicasInfo& replicasInfo);
 
   const PrincipalId myId_;
-  std::unique_ptr<RSASigner> mySigner_;
-  std::map<PrincipalId, std::shared_ptr<RSAVerifier>> verifiers_;
+  std::unique_ptr<IRawSigner> mySigner_;
+  std::map<PrincipalId, std::shared_ptr<IRawVerifier>> verifiers_;
   bool clientTransactionSigningEnabled_ = true;
   ReplicasInfo& replicasInfo_;
 
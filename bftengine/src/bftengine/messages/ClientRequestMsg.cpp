@@ -85,7 +85,8 @@ ClientRequestMsg::ClientRequestMsg(ClientRequestMsgHeader* body)
 
 bool ClientRequestMsg::isReadOnly() const { return (msgBody()->flags & READ_ONLY_REQ) != 0; }
 
-void ClientRequestMsg::validateImp(const ReplicasInfo& repInfo) const {
+void ClientRequestMsg::validateImp(const ReplicasInfo& repInfo,
+                                   std::vector<SigManager::SigToVerify>* sigsToVerify) const {
   const auto* header = msgBody();
   PrincipalId clientId = header->idOfClientProxy;
   ConcordAssert(this->senderId() != repInfo.myId());
@@ -154,7 +155,10 @@ void ClientRequestMsg::validateImp(const ReplicasInfo& repInfo) const {
     LOG_ERROR(GL, msg.str());
     throw std::runtime_error(msg.str());
   }
-  if (doSigVerify) {
+  if (doSigVerify && sigsToVerify) {
+    sigsToVerify->push_back(
+        {clientId, requestBuf(), header->requestLength, requestSignature(), header->reqSignatureLength});
+  } else if (doSigVerify) {
     if (!sigManager->verifySig(
             clientId, requestBuf(), header->requestLength, requestSignature(), header->reqSignatureLength)) {
       std::stringstream msg;
@@ -13,6 +13,7 @@
 
 #include "MessageBase.hpp"
 #include "ReplicasInfo.hpp"
+#include "SigManager.hpp"
 #include "ClientMsgs.hpp"
 #include "diagnostics.h"
 #include "performance_handler.h"
@@ -71,10 +72,16 @@ class ClientRequestMsg : public MessageBase {
 
   void validate(const ReplicasInfo& repInfo) const override { validateImp(repInfo); }
 
+  // Same as validate(), except that the client signature (if it needs to be verified) is appended to sigsToVerify
+  // instead, so that the signatures of a number of requests can be verified together (see SigManager::verifySigs)
+  void validateWithoutSig(const ReplicasInfo& repInfo, std::vector<SigManager::SigToVerify>& sigsToVerify) const {
+    validateImp(repInfo, &sigsToVerify);
+  }
+
  protected:
   ClientRequestMsgHeader* msgBody() const { return ((ClientRequestMsgHeader*)msgBody_); }
 
-  void validateImp(const ReplicasInfo& repInfo) const;
+  void validateImp(const ReplicasInfo& repInfo, std::vector<SigManager::SigToVerify>* sigsToVerify = nullptr) const;
 
   // Returns a pair of pointer and size to the extra buffer which was allocated during initialisation
   std::pair<char*, uint32_t> getExtraBufPtr() {
@@ -11,8 +11,10 @@
 
 #pragma once
 
+#include <optional>
 #include <type_traits>
 #include "OpenTracing.hpp"
+#include "Digest.hpp"
 #include "SysConsts.hpp"
 #include "PrimitiveTypes.hpp"
 #include "MsgCode.hpp"
@@ -46,6 +48,19 @@ class MessageBase {
 
   void releaseOwnership() { owner_ = false; }
 
+  // Set by the pre-validation stage (see MsgPreValidator) once validate() has passed, so that the dispatcher thread
+  // does not need to validate the message again
+  void markPreValidated() { preValidated_ = true; }
+
+  bool isPreValidated() const { return preValidated_; }
+
+  // The digest of the whole message (body() and size()), if it was already computed off the dispatcher thread (on
+  // receipt, see MsgReceiver, or by the pre-validation stage), so that it does not need to be computed again. Only
+  // valid for messages whose body is not modified after it is set.
+  void setDigestOfMsg(const Digest& digest) { digestOfMsg_ = digest; }
+
+  const std::optional<Digest>& digestOfMsg() const { return digestOfMsg_; }
+
   virtual ~MessageBase();
 
   virtual void validate(const ReplicasInfo &) const;
@@ -99,6 +114,8 @@ class MessageBase {
   NodeIdType sender_;
   // true IFF this instance is not responsible for de-allocating the body:
   bool owner_ = true;
+  bool preValidated_ = false;
+  std::optional<Digest> digestOfMsg_;
   static constexpr uint32_t magicNumOfRawFormat = 0x5555897BU;
 
   template <typename MessageT>
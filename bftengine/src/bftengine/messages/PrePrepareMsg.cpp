@@ -47,6 +47,9 @@ void PrePrepareMsg::calculateDigestOfRequests(Digest& digest) const {
     if (sig != nullptr) {
       sigOrDigestOfRequest[local_id].first = sig;
       sigOrDigestOfRequest[local_id].second = req.requestSignatureLength();
+    } else if (local_id < knownDigestsOfRequests_.size() && knownDigestsOfRequests_[local_id]) {
+      sigOrDigestOfRequest[local_id].first = knownDigestsOfRequests_[local_id]->content();
+      sigOrDigestOfRequest[local_id].second = sizeof(Digest);
     } else {
       tasks.push_back(RequestThreadPool::getThreadPool().async(
           [&sigOrDigestOfRequest, &digestBuffer, local_id](auto* request, auto requestLength) {
@@ -105,11 +108,14 @@ void PrePrepareMsg::validate(const ReplicasInfo& repInfo) const {
     auto it = RequestsIterator(this);
     char* requestBody = nullptr;
     // Here we validate each of the client requests arriving encapsulated inside the pre-prepare message
-    // This might also include validating the request's client signature
+    // The client signatures of all the requests are verified together at the end
+    std::vector<SigManager::SigToVerify> sigsToVerify;
     while (it.getAndGoToNext(requestBody)) {
       ClientRequestMsg req((ClientRequestMsgHeader*)requestBody);
-      req.validate(repInfo);
+      req.validateWithoutSig(repInfo, sigsToVerify);
     }
+    if (!sigsToVerify.empty() && !SigManager::instance()->verifySigs(sigsToVerify).empty())
+      throw std::runtime_error(__PRETTY_FUNCTION__ + std::string(": client signatures"));
   }
 }
 
@@ -180,6 +186,14 @@ void PrePrepareMsg::addRequest(const char* pRequest, uint32_t requestSize) {
   b()->numberOfRequests++;
 }
 
+void PrePrepareMsg::addRequest(const ClientRequestMsg& req) {
+  if (req.digestOfMsg()) {
+    knownDigestsOfRequests_.resize(b()->numberOfRequests);
+    knownDigestsOfRequests_.push_back(req.digestOfMsg());
+  }
+  addRequest(req.body(), req.size());
+}
+
 void PrePrepareMsg::finishAddingRequests() {
   ConcordAssert(!isNull());
   ConcordAssert(!isReady());
@@ -195,6 +209,8 @@ void PrePrepareMsg::finishAddingRequests() {
   ConcordAssert(isReady());
 
   calculateDigestOfRequests(b()->digestOfRequests);
+  knownDigestsOfRequests_.clear();
+  knownDigestsOfRequests_.shrink_to_fit();
 
   // size
   setMsgSize(b()->endLocationOfLastRequest);
@@ -12,6 +12,8 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
+#include <vector>
 
 #include "PrimitiveTypes.hpp"
 #include "assertUtils.hpp"
@@ -22,6 +24,7 @@
 namespace bftEngine {
 namespace impl {
 class RequestsIterator;
+class ClientRequestMsg;
 
 class PrePrepareMsg : public MessageBase {
  protected:
@@ -85,6 +88,10 @@ class PrePrepareMsg : public MessageBase {
 
   void addRequest(const char* pRequest, uint32_t requestSize);
 
+  // Same as addRequest(req.body(), req.size()), except that the digest of the request is taken from req if it was
+  // already computed (see MessageBase::digestOfMsg), so finishAddingRequests() does not need to hash it again
+  void addRequest(const ClientRequestMsg& req);
+
   void finishAddingRequests();
 
   // getter methods
@@ -122,6 +129,10 @@ class PrePrepareMsg : public MessageBase {
 
   uint32_t payloadShift() const;
   friend class RequestsIterator;
+
+  // The digests of the requests that were already known when they were added, by their index in the message. Only
+  // used by the primary, until finishAddingRequests() is called.
+  std::vector<std::optional<Digest>> knownDigestsOfRequests_;
 };
 
 class RequestsIterator {
@@ -474,6 +474,8 @@ bool PreProcessor::checkClientBatchMsgCorrectness(const ClientBatchRequestMsgUni
   }
   const auto &clientRequestMsgs = clientBatchReqMsg->getClientPreProcessRequestMsgs();
   bool valid = true;
+  // The client signatures of all the messages in the batch are verified together
+  vector<impl::SigManager::SigToVerify> sigsToVerify;
   for (const auto &msg : clientRequestMsgs) {
     if (!checkClientMsgCorrectness(msg->requestSeqNum(),
                                    msg->getCid(),
@@ -483,8 +485,22 @@ bool PreProcessor::checkClientBatchMsgCorrectness(const ClientBatchRequestMsgUni
                                    clientBatchReqMsg->getCid())) {
       preProcessorMetrics_.preProcReqIgnored++;
       valid = false;
-    } else if (!validateMessage(msg.get())) {
-      preProcessorMetrics_.preProcReqInvalid++;
+    } else {
+      try {
+        msg->validateWithoutSig(myReplica_.getReplicasInfo(), sigsToVerify);
+      } catch (std::exception &e) {
+        LOG_ERROR(logger(), "Message validation failed: " << e.what());
+        preProcessorMetrics_.preProcReqInvalid++;
+        valid = false;
+      }
+    }
+  }
+  if (valid && !sigsToVerify.empty()) {
+    const auto invalidSigs = impl::SigManager::instance()->verifySigs(sigsToVerify);
+    if (!invalidSigs.empty()) {
+      LOG_ERROR(logger(),
+                "Client signature verification failed" << KVLOG(clientBatchReqMsg->getCid(), invalidSigs.size()));
+      preProcessorMetrics_.preProcReqInvalid += invalidSigs.size();
       valid = false;
     }
   }
@@ -18,6 +18,8 @@
 #include <cryptopp/osrng.h>
 #include <cryptopp/base64.h>
 #include <cryptopp/files.h>
+#include <cryptopp/hex.h>
+#include <cryptopp/xed25519.h>
 #include "gtest/gtest.h"
 
 #include <string>
@@ -74,6 +76,28 @@ void corrupt(char* data, size_t len) {
   }
 }
 
+// Returns a hex encoded DER private and public Ed25519 key pair
+pair<string, string> generateEd25519KeyPair() {
+  CryptoPP::AutoSeededRandomPool prng;
+  CryptoPP::ed25519::Signer signer(prng);
+  CryptoPP::ed25519::Verifier verifier(signer);
+  string privKey, pubKey;
+  CryptoPP::HexEncoder privEncoder(new CryptoPP::StringSink(privKey));
+  signer.GetPrivateKey().Save(privEncoder);
+  privEncoder.MessageEnd();
+  CryptoPP::HexEncoder pubEncoder(new CryptoPP::StringSink(pubKey));
+  verifier.GetPublicKey().Save(pubEncoder);
+  pubEncoder.MessageEnd();
+  return make_pair(privKey, pubKey);
+}
+
+string hexToPem(const string& hexKey, const string& label) {
+  string base64;
+  CryptoPP::StringSource s(
+      hexKey, true, new CryptoPP::HexDecoder(new CryptoPP::Base64Encoder(new CryptoPP::StringSink(base64))));
+  return "-----BEGIN " + label + "-----\n" + base64 + "-----END " + label + "-----\n";
+}
+
 TEST(RsaSignerAndRsaVerifierTest, LoadSignVerifyFromPemfiles) {
   string publicKeyFullPath({string(KEYS_BASE_PATH) + string("/1/") + PUB_KEY_NAME});
   string privateKeyFullPath({string(KEYS_BASE_PATH) + string("/1/") + PRIV_KEY_NAME});
@@ -110,6 +134,87 @@ TEST(RsaSignerAndRsaVerifierTest, LoadSignVerifyFromPemfiles) {
   ASSERT_FALSE(verifier_->verify(data, RANDOM_DATA_SIZE, sig.data(), expectedVerifierSigLen));
 }
 
+TEST(Ed25519SignerAndVerifierTest, SignVerifyInBothFormats) {
+  const auto [privKey, pubKey] = generateEd25519KeyPair();
+  const vector<pair<string, string>> keys{{privKey, pubKey},
+                                          {hexToPem(privKey, "PRIVATE KEY"), hexToPem(pubKey, "PUBLIC KEY")}};
+  const vector<KeyFormat> formats{KeyFormat::HexaDecimalStrippedFormat, KeyFormat::PemFormat};
+  for (size_t f{0}; f < formats.size(); ++f) {
+    auto signer = createRawSigner(keys[f].first.c_str(), formats[f]);
+    auto verifier = createRawVerifier(keys[f].second.c_str(), formats[f]);
+    ASSERT_NE(nullptr, dynamic_cast<Ed25519Signer*>(signer.get()));
+    ASSERT_NE(nullptr, dynamic_cast<Ed25519Verifier*>(verifier.get()));
+    ASSERT_EQ(64u, signer->signatureLength());
+    ASSERT_EQ(64u, verifier->signatureLength());
+
+    char data[RANDOM_DATA_SIZE]{0};
+    string sig(signer->signatureLength(), '\0');
+    size_t lenRetData;
+    generateRandomData(data, RANDOM_DATA_SIZE);
+    ASSERT_TRUE(signer->sign(data, RANDOM_DATA_SIZE, sig.data(), sig.size(), lenRetData));
+    ASSERT_EQ(sig.size(), lenRetData);
+    ASSERT_TRUE(verifier->verify(data, RANDOM_DATA_SIZE, sig.data(), sig.size()));
+
+    corrupt(data + 10, 1);
+    ASSERT_FALSE(verifier->verify(data, RANDOM_DATA_SIZE, sig.data(), sig.size()));
+  }
+}
+
+TEST(SigManagerTest, Ed25519ReplicasBatchVerify) {
+  constexpr size_t numReplicas{4};
+  constexpr PrincipalId myId{0};
+  constexpr size_t sigsPerReplica{10};
+  string myPrivKey;
+  unique_ptr<IRawSigner> signers[numReplicas];
+  set<pair<PrincipalId, const string>> publicKeysOfReplicas;
+
+  for (PrincipalId pid{0}; pid < numReplicas; ++pid) {
+    auto [privKey, pubKey] = generateEd25519KeyPair();
+    if (pid == myId) {
+      myPrivKey = privKey;
+      continue;
+    }
+    signers[pid] = createRawSigner(privKey.c_str(), KeyFormat::HexaDecimalStrippedFormat);
+    publicKeysOfReplicas.insert(make_pair(pid, pubKey));
+  }
+
+  ReplicasInfo replicaInfo(createReplicaConfig(), false, false);
+  unique_ptr<SigManager> sigManager(SigManager::init(myId,
+                                                     myPrivKey,
+                                                     publicKeysOfReplicas,
+                                                     KeyFormat::HexaDecimalStrippedFormat,
+                                                     nullptr,
+                                                     KeyFormat::HexaDecimalStrippedFormat,
+                                                     replicaInfo));
+  ASSERT_EQ(64, sigManager->getMySigLength());
+
+  vector<vector<char>> data;
+  vector<string> sigs;
+  vector<SigManager::SigToVerify> sigsToVerify;
+  for (PrincipalId pid{1}; pid < numReplicas; ++pid) {
+    for (size_t i{0}; i < sigsPerReplica; ++i) {
+      data.emplace_back(RANDOM_DATA_SIZE);
+      generateRandomData(data.back().data(), RANDOM_DATA_SIZE);
+      sigs.emplace_back(signers[pid]->signatureLength(), '\0');
+      size_t lenRetData;
+      signers[pid]->sign(data.back().data(), RANDOM_DATA_SIZE, sigs.back().data(), sigs.back().size(), lenRetData);
+    }
+  }
+  for (size_t i{0}; i < data.size(); ++i) {
+    PrincipalId pid = 1 + i / sigsPerReplica;
+    sigsToVerify.push_back({pid, data[i].data(), RANDOM_DATA_SIZE, sigs[i].data(), (uint16_t)sigs[i].size()});
+  }
+  ASSERT_TRUE(sigManager->verifySigs(sigsToVerify).empty());
+
+  // Corrupt a single signature, expect exactly that one to fail
+  corrupt(sigs[sigsPerReplica + 3].data(), 1);
+  ASSERT_EQ(vector<size_t>{sigsPerReplica + 3}, sigManager->verifySigs(sigsToVerify));
+
+  // An unrecognized principal fails as well, and doesn't affect the others
+  sigsToVerify[0].pid = numReplicas + 100;
+  ASSERT_EQ((vector<size_t>{0, sigsPerReplica + 3}), sigManager->verifySigs(sigsToVerify));
+}
+
 TEST(SigManagerTest, ReplicasOnlyCheckVerify) {
   constexpr size_t numReplicas{4};
   constexpr PrincipalId myId{0};
@@ -23,6 +23,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace {
 
@@ -142,4 +143,71 @@ TEST_F(incoming_msgs_storage_test, push_external_raw_callback_not_called_before_
   ASSERT_FALSE(popped);
 }
 
+// Client requests and consensus messages that are queued together are dispatched consensus messages first, while the
+// order of the messages of each class is kept.
+TEST_F(incoming_msgs_storage_test, consensus_msgs_are_dispatched_before_client_requests) {
+  const auto consensus_msg_id = static_cast<std::uint16_t>(msg_id_ + 1);
+  const auto client_msg_id = std::uint16_t{MsgCode::ClientRequest};
+  auto consumed = std::vector<std::pair<std::uint16_t, char>>{};
+  auto done = std::promise<void>{};
+  auto reg = std::make_shared<MsgHandlersRegistrator>();
+  auto consumer = [&](MessageBase* msg) {
+    auto owned = own(msg);
+    consumed.emplace_back(owned->type(), owned->body()[sizeof(MessageBase::Header)]);
+    if (consumed.size() == 6) done.set_value();
+  };
+  reg->registerMsgHandler(consensus_msg_id, consumer);
+  reg->registerMsgHandler(client_msg_id, consumer);
+  auto storage = IncomingMsgsStorageImp{reg, msg_wait_timeout_, replica_id_};
+  for (char i = 0; i < 3; i++) {
+    auto msg = std::make_unique<MessageBase>(sender_, client_msg_id, msg_size_ + 1);
+    msg->body()[sizeof(MessageBase::Header)] = i;
+    ASSERT_TRUE(storage.pushExternalMsg(std::move(msg)));
+  }
+  for (char i = 0; i < 3; i++) {
+    auto msg = std::make_unique<MessageBase>(sender_, consensus_msg_id, msg_size_ + 1);
+    msg->body()[sizeof(MessageBase::Header)] = i;
+    ASSERT_TRUE(storage.pushExternalMsg(std::move(msg)));
+  }
+  storage.start();
+  done.get_future().wait();
+  storage.stop();
+  const auto expected = std::vector<std::pair<std::uint16_t, char>>{{consensus_msg_id, 0},
+                                                                    {consensus_msg_id, 1},
+                                                                    {consensus_msg_id, 2},
+                                                                    {client_msg_id, 0},
+                                                                    {client_msg_id, 1},
+                                                                    {client_msg_id, 2}};
+  ASSERT_EQ(expected, consumed);
+}
+
+// Client requests of all shards share the capacity of the client queues; a full client queue doesn't block the
+// producer, the message is dropped.
+TEST_F(incoming_msgs_storage_test, pending_client_requests_are_bounded) {
+  const auto max_pending_client_msgs = 20000u;
+  const auto num_senders = NodeIdType{16};
+  auto storage = IncomingMsgsStorageImp{reg_, msg_wait_timeout_, replica_id_};
+  auto accepted = 0u;
+  for (auto i = 0u; i < 2 * max_pending_client_msgs / num_senders; i++) {
+    for (auto sender = NodeIdType{0}; sender < num_senders; sender++) {
+      auto msg = std::make_unique<MessageBase>(sender, std::uint16_t{MsgCode::ClientRequest}, msg_size_);
+      if (storage.pushExternalMsg(std::move(msg))) accepted++;
+    }
+  }
+  ASSERT_EQ(max_pending_client_msgs, accepted);
+}
+
+// A burst of a single replica isn't limited by the client requests, nor by its share of the shards.
+TEST_F(incoming_msgs_storage_test, replica_msgs_have_their_own_capacity) {
+  const auto max_pending_msgs_of_a_shard = 20000u;
+  auto storage = IncomingMsgsStorageImp{reg_, msg_wait_timeout_, replica_id_};
+  while (storage.pushExternalMsg(std::make_unique<MessageBase>(sender_, MsgCode::ClientRequest, msg_size_))) {
+  }
+  auto accepted = 0u;
+  for (auto i = 0u; i < 2 * max_pending_msgs_of_a_shard; i++) {
+    if (storage.pushExternalMsg(std::make_unique<MessageBase>(sender_, msg_id_, msg_size_))) accepted++;
+  }
+  ASSERT_EQ(max_pending_msgs_of_a_shard, accepted);
+}
+
 }  // namespace
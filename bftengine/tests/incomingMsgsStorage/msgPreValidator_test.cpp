@@ -0,0 +1,137 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "gtest/gtest.h"
+
+#include "IncomingMsgsStorageImp.hpp"
+#include "MsgHandlersRegistrator.hpp"
+#include "MsgPreValidator.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace {
+
+using namespace bftEngine::impl;
+using namespace std::chrono_literals;
+
+// The sequence number of a test message is written after the header
+struct TestMsgBody {
+  MessageBase::Header header;
+  uint32_t seqNum;
+};
+
+class msg_pre_validator_test : public ::testing::Test {
+  void SetUp() override {
+    reg_->registerMsgHandler(valid_msg_id_, [this](MessageBase* msg) { consume(msg); });
+    reg_->registerMsgHandler(invalid_msg_id_, [this](MessageBase* msg) { consume(msg); });
+    reg_->registerMsgHandler(unchecked_msg_id_, [this](MessageBase* msg) { consume(msg); });
+    reg_->registerMsgValidator(valid_msg_id_, [](MessageBase*) { return true; });
+    reg_->registerMsgValidator(invalid_msg_id_, [](MessageBase*) { return false; });
+    storage_ = std::make_shared<IncomingMsgsStorageImp>(reg_, msg_wait_timeout_, replica_id_);
+    storage_->start();
+    pre_validator_.emplace(reg_, storage_, num_of_threads_);
+    pre_validator_->start();
+  }
+
+  void TearDown() override {
+    pre_validator_->stop();
+    storage_->stop();
+  }
+
+ protected:
+  auto newMsg(std::uint16_t msg_id, NodeIdType sender, uint32_t seq_num) const {
+    auto msg = std::make_unique<MessageBase>(sender, msg_id, sizeof(TestMsgBody));
+    reinterpret_cast<TestMsgBody*>(msg->body())->seqNum = seq_num;
+    return msg;
+  }
+
+  void consume(MessageBase* msg) {
+    std::unique_ptr<MessageBase> owned{msg};
+    std::lock_guard<std::mutex> lock(lock_);
+    consumed_.push_back(std::move(owned));
+    cv_.notify_one();
+  }
+
+  bool waitForConsumed(size_t count) {
+    std::unique_lock<std::mutex> lock(lock_);
+    return cv_.wait_for(lock, 10s, [&] { return consumed_.size() >= count; });
+  }
+
+ protected:
+  const std::uint16_t replica_id_{0};
+  const std::uint16_t num_of_threads_{4};
+  const std::uint16_t valid_msg_id_{1};
+  const std::uint16_t invalid_msg_id_{2};
+  const std::uint16_t unchecked_msg_id_{3};
+  const std::chrono::milliseconds msg_wait_timeout_{100ms};
+  const std::shared_ptr<MsgHandlersRegistrator> reg_ = std::make_shared<MsgHandlersRegistrator>();
+  std::shared_ptr<IncomingMsgsStorage> storage_;
+  std::optional<MsgPreValidator> pre_validator_;
+
+  std::mutex lock_;
+  std::condition_variable cv_;
+  std::vector<std::unique_ptr<MessageBase>> consumed_;
+};
+
+TEST_F(msg_pre_validator_test, valid_msgs_are_marked) {
+  ASSERT_TRUE(pre_validator_->pushExternalMsg(newMsg(valid_msg_id_, 0, 0)));
+  ASSERT_TRUE(waitForConsumed(1));
+  std::lock_guard<std::mutex> lock(lock_);
+  ASSERT_EQ(valid_msg_id_, consumed_[0]->type());
+  ASSERT_TRUE(consumed_[0]->isPreValidated());
+}
+
+TEST_F(msg_pre_validator_test, msgs_without_validator_pass_unmarked) {
+  ASSERT_TRUE(pre_validator_->pushExternalMsg(newMsg(unchecked_msg_id_, 0, 0)));
+  ASSERT_TRUE(waitForConsumed(1));
+  std::lock_guard<std::mutex> lock(lock_);
+  ASSERT_EQ(unchecked_msg_id_, consumed_[0]->type());
+  ASSERT_FALSE(consumed_[0]->isPreValidated());
+}
+
+TEST_F(msg_pre_validator_test, invalid_msgs_are_dropped) {
+  ASSERT_TRUE(pre_validator_->pushExternalMsg(newMsg(invalid_msg_id_, 0, 0)));
+  ASSERT_TRUE(pre_validator_->pushExternalMsg(newMsg(valid_msg_id_, 0, 1)));
+  ASSERT_TRUE(waitForConsumed(1));
+  ASSERT_EQ(1, pre_validator_->numOfInvalidMsgs());
+  std::lock_guard<std::mutex> lock(lock_);
+  ASSERT_EQ(1, consumed_.size());
+  ASSERT_EQ(valid_msg_id_, consumed_[0]->type());
+}
+
+TEST_F(msg_pre_validator_test, order_of_each_sender_is_kept) {
+  const NodeIdType num_of_senders = 7;
+  const uint32_t msgs_per_sender = 1000;
+  for (auto i = 0u; i < msgs_per_sender; i++) {
+    for (NodeIdType sender = 0; sender < num_of_senders; sender++) {
+      ASSERT_TRUE(pre_validator_->pushExternalMsg(newMsg(valid_msg_id_, sender, i)));
+    }
+  }
+  ASSERT_TRUE(waitForConsumed(num_of_senders * msgs_per_sender));
+
+  std::map<NodeIdType, uint32_t> next;
+  std::lock_guard<std::mutex> lock(lock_);
+  for (const auto& msg : consumed_) {
+    auto seq_num = reinterpret_cast<TestMsgBody*>(msg->body())->seqNum;
+    ASSERT_EQ(next[msg->senderId()]++, seq_num);
+  }
+}
+
+}  // namespace
@@ -147,6 +147,41 @@ TEST_F(PrePrepareMsgTestFixture, finalize_and_validate) {
   EXPECT_NO_THROW(msg.validate(replicaInfo));  // validate the same digest
 }
 
+TEST_F(PrePrepareMsgTestFixture, known_digests_of_requests_are_used) {
+  ReplicasInfo replicaInfo(createReplicaConfig(), false, false);
+  const char rawSpanContext[] = {"span_\0context"};
+  const std::string spanContext{rawSpanContext, sizeof(rawSpanContext)};
+  std::vector<std::shared_ptr<ClientRequestMsg>> crmv;
+  create_random_client_requests(crmv, 20u);
+  size_t req_size = 0;
+  for (const auto& crm : crmv) {
+    req_size += crm->size();
+  }
+
+  // Only some of the requests come with their digest, the rest are hashed by finishAddingRequests()
+  PrePrepareMsg msg(1u, 2u, 3u, CommitPath::SLOW, concordUtils::SpanContext{spanContext}, req_size);
+  PrePrepareMsg raw(1u, 2u, 3u, CommitPath::SLOW, concordUtils::SpanContext{spanContext}, req_size);
+  for (size_t i = 0; i < crmv.size(); i++) {
+    if (i % 3 == 0) crmv[i]->setDigestOfMsg(Digest(crmv[i]->body(), crmv[i]->size()));
+    msg.addRequest(*crmv[i]);
+    raw.addRequest(crmv[i]->body(), crmv[i]->size());
+  }
+  msg.finishAddingRequests();
+  raw.finishAddingRequests();
+  EXPECT_EQ(raw.digestOfRequests(), msg.digestOfRequests());
+  EXPECT_NO_THROW(msg.validate(replicaInfo));
+
+  // A known digest is not computed again, so a wrong one results in a PrePrepare that backups reject
+  PrePrepareMsg bad(1u, 2u, 3u, CommitPath::SLOW, concordUtils::SpanContext{spanContext}, req_size);
+  crmv[1]->setDigestOfMsg(Digest(static_cast<unsigned char>(0x1)));
+  for (const auto& crm : crmv) {
+    bad.addRequest(*crm);
+  }
+  bad.finishAddingRequests();
+  EXPECT_NE(raw.digestOfRequests(), bad.digestOfRequests());
+  EXPECT_THROW(bad.validate(replicaInfo), std::runtime_error);
+}
+
 TEST_F(PrePrepareMsgTestFixture, create_and_compare) {
   ReplicasInfo replicaInfo(createReplicaConfig(), false, false);
 
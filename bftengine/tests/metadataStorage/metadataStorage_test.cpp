@@ -163,6 +163,50 @@ TEST(metadataStorage_test, clear_db_test) {
   delete db;
   delete dbClient_;
 }
+
+// Reads an object directly from the DB client.
+uint32_t readFromDbClient(Client *dbClient, ObjectId objectId, uint8_t *outBuf, uint32_t bufSize) {
+  uint32_t realSize = 0;
+  auto status = dbClient->get(MetadataKeyManipulator{}.generateMetadataKey(objectId), (char *)outBuf, bufSize, realSize);
+  if (status.isNotFound()) return 0;
+  return realSize;
+}
+
+Client *createCleanDbClient(const std::string &dbPath) {
+  std::experimental::filesystem::remove_all(dbPath.c_str());
+  auto *dbClient = new Client(dbPath, make_unique<KeyComparator>(new DBKeyComparator));
+  dbClient->init();
+  return dbClient;
+}
+
+TEST(metadataStorage_test, write_sliver_in_batch_test) {
+  Client *dbClient_ = createCleanDbClient("./metadataStorage_test_db_sliver");
+  auto db = initiateMetadataStorage(dbClient_, "./metadataStorage_test_db_sliver", false);
+
+  auto *firstBuf = createAndFillBuf(initialObjDataSize);
+  auto *secondBuf = createAndFillBuf(initialObjDataSize);
+  secondBuf[0] = firstBuf[0] + 1;
+  auto *outBuf = new uint8_t[initialObjDataSize];
+
+  // A later write of an object in the same transaction supersedes the earlier one.
+  db->beginAtomicWriteOnlyBatch();
+  db->writeSliverInBatch(initialObjectId, concordUtils::Sliver::copy((const char *)firstBuf, initialObjDataSize));
+  db->writeInBatch(initialObjectId + 1, (const char *)firstBuf, initialObjDataSize);
+  db->writeSliverInBatch(initialObjectId, concordUtils::Sliver::copy((const char *)secondBuf, initialObjDataSize));
+  ASSERT_EQ(0, readFromDbClient(dbClient_, initialObjectId, outBuf, initialObjDataSize));
+  db->commitAtomicWriteOnlyBatch();
+
+  ASSERT_EQ(initialObjDataSize, readFromDbClient(dbClient_, initialObjectId, outBuf, initialObjDataSize));
+  ASSERT_TRUE(is_match(secondBuf, outBuf, initialObjDataSize));
+  ASSERT_EQ(initialObjDataSize, readFromDbClient(dbClient_, initialObjectId + 1, outBuf, initialObjDataSize));
+  ASSERT_TRUE(is_match(firstBuf, outBuf, initialObjDataSize));
+
+  delete[] firstBuf;
+  delete[] secondBuf;
+  delete[] outBuf;
+  delete db;
+  delete dbClient_;
+}
 }  // end namespace
 
 int main(int argc, char **argv) {
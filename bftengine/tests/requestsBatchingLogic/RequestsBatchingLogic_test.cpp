@@ -0,0 +1,94 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the sub-component's license, as noted in the LICENSE
+// file.
+
+#include "RequestsBatchingLogic.hpp"
+#include "gtest/gtest.h"
+
+using namespace bftEngine::batchingLogic;
+
+namespace {
+
+constexpr auto latencyTargetMicros = uint64_t{100 * 1000};
+constexpr auto maxFlushPeriodMs = uint32_t{50};
+constexpr auto initialBatchSize = uint32_t{100};
+constexpr auto increaseRate = 0.1;
+constexpr auto minIncreaseCondition = 0.75;
+
+LatencyTargetController controller(double rate = increaseRate) {
+  return LatencyTargetController{latencyTargetMicros, maxFlushPeriodMs, initialBatchSize, rate, minIncreaseCondition};
+}
+
+TEST(LatencyTargetController, decreases_batch_size_when_target_is_missed) {
+  auto c = controller();
+  c.adjust(latencyTargetMicros, 1.0);
+  ASSERT_TRUE(c.targetMissed());
+  ASSERT_EQ(c.observedLatencyMicros(), latencyTargetMicros + maxFlushPeriodMs * 1000);
+  ASSERT_EQ(c.maxNumOfRequestsInBatch(), 80);
+  // No budget is left for waiting on a batch to fill
+  ASSERT_EQ(c.flushPeriodMs(), 1);
+}
+
+TEST(LatencyTargetController, increases_batch_size_when_batches_fill_within_target) {
+  auto c = controller();
+  c.adjust(10 * 1000, 0.8);
+  ASSERT_FALSE(c.targetMissed());
+  ASSERT_EQ(c.maxNumOfRequestsInBatch(), 110);
+  ASSERT_EQ(c.flushPeriodMs(), maxFlushPeriodMs);
+
+  c.adjust(40 * 1000, 0.8);
+  ASSERT_FALSE(c.targetMissed());
+  ASSERT_EQ(c.maxNumOfRequestsInBatch(), 121);
+  ASSERT_EQ(c.flushPeriodMs(), maxFlushPeriodMs);
+
+  // Waiting for the batch to fill misses the target, so the flush period is cut to the remaining latency budget
+  c.adjust(60 * 1000, 0.8);
+  ASSERT_TRUE(c.targetMissed());
+  ASSERT_EQ(c.maxNumOfRequestsInBatch(), 96);
+  ASSERT_EQ(c.flushPeriodMs(), 40);
+  c.adjust(60 * 1000, 0.8);
+  ASSERT_FALSE(c.targetMissed());
+  ASSERT_EQ(c.maxNumOfRequestsInBatch(), 105);
+  ASSERT_EQ(c.flushPeriodMs(), 40);
+}
+
+TEST(LatencyTargetController, keeps_batch_size_when_batches_are_flushed) {
+  auto c = controller();
+  c.adjust(10 * 1000, 0.5);
+  ASSERT_FALSE(c.targetMissed());
+  ASSERT_EQ(c.maxNumOfRequestsInBatch(), initialBatchSize);
+}
+
+TEST(LatencyTargetController, batch_size_is_bounded) {
+  auto c = controller();
+  for (auto i = 0; i < 100; ++i) {
+    c.adjust(0, 1.0);
+  }
+  ASSERT_LE(c.maxNumOfRequestsInBatch(), 4 * initialBatchSize);
+  for (auto i = 0; i < 100; ++i) {
+    c.adjust(latencyTargetMicros, 1.0);
+  }
+  ASSERT_EQ(c.maxNumOfRequestsInBatch(), 1);
+}
+
+TEST(LatencyTargetController, large_increase_rate_is_clamped) {
+  for (const auto rate : {0.5, 0.9, 2.0}) {
+    auto c = controller(rate);
+    c.adjust(latencyTargetMicros, 1.0);
+    ASSERT_EQ(c.maxNumOfRequestsInBatch(), 1);
+  }
+  auto c = controller(-1.0);
+  c.adjust(latencyTargetMicros, 1.0);
+  ASSERT_EQ(c.maxNumOfRequestsInBatch(), initialBatchSize);
+  c.adjust(0, 1.0);
+  ASSERT_EQ(c.maxNumOfRequestsInBatch(), initialBatchSize + 1);
+}
+
+}  // namespace
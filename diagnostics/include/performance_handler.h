@@ -237,8 +237,12 @@ struct Histogram {
   ~Histogram() {
     hdr_close(snapshot);
     hdr_close(history);
+    if (pending) hdr_close(pending);
+    if (sampled) hdr_close(sampled);
     snapshot = nullptr;
     history = nullptr;
+    pending = nullptr;
+    sampled = nullptr;
   }
 
   Histogram(const Histogram&) = delete;
@@ -246,6 +250,12 @@ struct Histogram {
 
   void takeSnapshot();
 
+  // Move the values recorded so far to `pending`, without taking a snapshot.
+  void sample();
+
+  // Return a new histogram with all the values sampled so far, i.e. history, snapshot and pending.
+  hdr_histogram* total() const;
+
   std::shared_ptr<Recorder> recorder;
 
   std::chrono::system_clock::time_point start;
@@ -257,6 +267,25 @@ struct Histogram {
 
   // History doesn't include the latest snapshot.
   hdr_histogram* history = nullptr;
+
+  // Values sampled by sample() that will be part of the next snapshot. Only allocated if sample() is called.
+  hdr_histogram* pending = nullptr;
+  hdr_histogram* sampled = nullptr;
+};
+
+// The total values of a histogram at the time it was read via PerformanceHandler::valuesSince().
+class HistogramReading {
+ public:
+  HistogramReading() = default;
+  ~HistogramReading() {
+    if (total_) hdr_close(total_);
+  }
+  HistogramReading(const HistogramReading&) = delete;
+  HistogramReading& operator=(const HistogramReading&) = delete;
+
+ private:
+  friend class PerformanceHandler;
+  hdr_histogram* total_ = nullptr;
 };
 
 using Name = std::string;
@@ -367,6 +396,11 @@ class PerformanceHandler {
   // Snapshot all histograms for the given component
   void snapshot(const std::string& component);
 
+  // Return the values recorded since `reading` was taken (or since the histogram was registered on the first call) and
+  // update `reading`. Unlike snapshot(), this doesn't affect the values returned by get(), so that components can track
+  // their own interval of a shared histogram.
+  HistogramValues valuesSince(const std::string& component, const std::string& histogram, HistogramReading& reading);
+
   // DO NOT USE THIS IN PRODUCTION. THIS IS ONLY FOR TESTING, SO THAT WE CAN CLEAR THE SINGLETON AND REREGISTER.
   void clear() {
     std::lock_guard<std::mutex> guard(mutex_);
@@ -106,6 +106,29 @@ void PerformanceHandler::snapshot(const std::string& name) {
   }
 }
 
+HistogramValues PerformanceHandler::valuesSince(const std::string& component_name,
+                                                const std::string& histogram_name,
+                                                HistogramReading& reading) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto& histogram = getHistogram(component_name, histogram_name);
+  histogram.sample();
+  auto total = histogram.total();
+  if (!reading.total_) {
+    reading.total_ = total;
+    return HistogramValues(total);
+  }
+  ConcordAssertEQ(total->counts_len, reading.total_->counts_len);
+  // Counts only grow, so the values since the reading are the difference of the counts
+  for (int32_t i = 0; i < total->counts_len; ++i) {
+    reading.total_->counts[i] = total->counts[i] - reading.total_->counts[i];
+  }
+  hdr_reset_internal_counters(reading.total_);
+  const auto values = HistogramValues(reading.total_);
+  hdr_close(reading.total_);
+  reading.total_ = total;
+  return values;
+}
+
 Histograms& PerformanceHandler::getHistograms(const std::string& name) {
   try {
     return components_.at(name);
@@ -242,6 +265,34 @@ void Histogram::takeSnapshot() {
                                                     history->highest_trackable_value));
   }
   snapshot = hdr_interval_recorder_sample_and_recycle(&(recorder->recorder), snapshot);
+  if (pending) {
+    hdr_add(snapshot, pending);
+    hdr_reset(pending);
+  }
+}
+
+void Histogram::sample() {
+  if (!pending) {
+    auto rv = hdr_init(
+        history->lowest_trackable_value, history->highest_trackable_value, history->significant_figures, &pending);
+    ConcordAssertEQ(0, rv);
+    rv = hdr_init(
+        history->lowest_trackable_value, history->highest_trackable_value, history->significant_figures, &sampled);
+    ConcordAssertEQ(0, rv);
+  }
+  sampled = hdr_interval_recorder_sample_and_recycle(&(recorder->recorder), sampled);
+  hdr_add(pending, sampled);
+}
+
+hdr_histogram* Histogram::total() const {
+  hdr_histogram* total = nullptr;
+  auto rv =
+      hdr_init(history->lowest_trackable_value, history->highest_trackable_value, history->significant_figures, &total);
+  ConcordAssertEQ(0, rv);
+  hdr_add(total, history);
+  hdr_add(total, snapshot);
+  if (pending) hdr_add(total, pending);
+  return total;
 }
 
 }  // namespace concord::diagnostics
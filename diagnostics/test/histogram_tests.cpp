@@ -72,3 +72,44 @@ TEST(histogram_tests, snapshots) {
   ASSERT_ANY_THROW(handler.get("bad_replica"));
   ASSERT_ANY_THROW(handler.get("test_replica", "bad_histogram"));
 }
+
+TEST(histogram_tests, values_since_reading) {
+  const std::string component_name("test_replica");
+  const std::string hist_name("some_histogram");
+  auto recorder = std::make_shared<Recorder>(hist_name, 1, MAX_VALUE_MICROSECONDS, 3, Unit::MICROSECONDS);
+  PerformanceHandler handler;
+  handler.registerComponent(component_name, {recorder});
+
+  // The first reading covers all values since the histogram was registered
+  recorder->record(1);
+  HistogramReading reading;
+  auto values = handler.valuesSince(component_name, hist_name, reading);
+  ASSERT_EQ(1, values.count);
+  ASSERT_EQ(1, values.max);
+
+  // The next reading only covers the values since the previous one
+  recorder->record(100);
+  recorder->record(200);
+  values = handler.valuesSince(component_name, hist_name, reading);
+  ASSERT_EQ(2, values.count);
+  ASSERT_EQ(100, values.min);
+  ASSERT_EQ(200, values.max);
+  values = handler.valuesSince(component_name, hist_name, reading);
+  ASSERT_EQ(0, values.count);
+
+  // Readings don't affect snapshots
+  auto hist_data = handler.get(component_name, hist_name);
+  ASSERT_EQ(0, hist_data.last_snapshot.count);
+  handler.snapshot(component_name);
+  hist_data = handler.get(component_name, hist_name);
+  ASSERT_EQ(0, hist_data.history.count);
+  ASSERT_EQ(3, hist_data.last_snapshot.count);
+  ASSERT_EQ(200, hist_data.last_snapshot.max);
+
+  // Snapshots don't affect readings
+  recorder->record(300);
+  handler.snapshot(component_name);
+  values = handler.valuesSince(component_name, hist_name, reading);
+  ASSERT_EQ(1, values.count);
+  ASSERT_EQ(300, values.max);
+}
@@ -18,6 +18,7 @@
 #include <iostream>
 #include <memory>
 #include <random>
+#include <thread>
 
 #include <boost/program_options.hpp>
 #include <boost/program_options/errors.hpp>
@@ -32,9 +33,11 @@
 
 #include "categorization/base_types.h"
 #include "categorization/column_families.h"
+#include "categorization/column_family_profiles.h"
 #include "categorization/updates.h"
 #include "categorized_kvbc_msgs.cmf.hpp"
 #include "categorization/kv_blockchain.h"
+#include "categorization/updates_recorder.h"
 #include "performance_handler.h"
 #include "rocksdb/native_client.h"
 #include "diagnostics.h"
@@ -100,6 +103,24 @@ std::pair<po::options_description, po::variables_map> parseArgs(int argc, char**
     po::value<size_t>()->default_value(CACHE_SIZE_DEFAULT),
     "Rocksdb Block Cache size")
 
+    ("rocksdb-cf-profiles",
+    po::bool_switch()->default_value(false),
+    "Split the block cache between per-access-pattern column family profiles instead of sharing it between all "
+    "column families (see ReplicaConfig::kvbcColumnFamilyProfilesBlockCacheSize)")
+
+    /*********************************
+     Replay Config
+     *********************************/
+    ("replay-updates-path",
+    po::value<std::string>()->default_value(""s),
+    "Add the blocks recorded by a replica (one of the files of ReplicaConfig::kvbcUpdatesRecordingPath) instead of "
+    "generated ones. "
+    "The block generation options and pre-execution are not used when replaying.")
+
+    ("replay-at-recorded-rate",
+    po::bool_switch()->default_value(false),
+    "Add the replayed blocks at the rate they were recorded at instead of as fast as possible")
+
     /*********************************
      Block Merkle Category Config
      *********************************/
@@ -180,9 +201,12 @@ std::pair<po::options_description, po::variables_map> parseArgs(int argc, char**
 
 void printHistograms() {
   auto& registrar = diagnostics::RegistrarSingleton::getInstance();
-  registrar.perf.snapshot("bench");
-  auto data = registrar.perf.get("bench");
-  cout << registrar.perf.toString(data) << endl;
+  // The kvbc component contains the per-category add latencies.
+  for (const auto& component : {"bench"s, "kvbc"s}) {
+    registrar.perf.snapshot(component);
+    auto data = registrar.perf.get(component);
+    cout << registrar.perf.toString(data) << endl;
+  }
 }
 
 void printRocksDbProperty(std::shared_ptr<storage::rocksdb::NativeClient>& db,
@@ -224,8 +248,38 @@ void printRocksDbProperties(std::shared_ptr<storage::rocksdb::NativeClient>& db)
   }
 }
 
+void printRocksDbStallAndCompactionStats(std::shared_ptr<storage::rocksdb::NativeClient>& db,
+                                          const std::shared_ptr<::rocksdb::Statistics>& stats) {
+  cout << "RocksDB Stalls and Compactions: " << endl;
+  if (stats) {
+    cout << "  Stall micros: " << stats->getTickerCount(::rocksdb::STALL_MICROS) << endl;
+    cout << "  Compaction read bytes: " << stats->getTickerCount(::rocksdb::COMPACT_READ_BYTES) << endl;
+    cout << "  Compaction write bytes: " << stats->getTickerCount(::rocksdb::COMPACT_WRITE_BYTES) << endl;
+    cout << "  Flush write bytes: " << stats->getTickerCount(::rocksdb::FLUSH_WRITE_BYTES) << endl;
+  }
+  for (auto& cf : db->columnFamilies()) {
+    cout << "  Column Family: " << cf << endl;
+    for (auto& prop : std::array{"rocksdb.is-write-stopped"s,
+                                 "rocksdb.actual-delayed-write-rate"s,
+                                 "rocksdb.compaction-pending"s,
+                                 "rocksdb.estimate-pending-compaction-bytes"s,
+                                 "rocksdb.num-running-compactions"s,
+                                 "rocksdb.num-immutable-mem-table"s}) {
+      printRocksDbProperty(db, db->columnFamilyHandle(cf), prop);
+    }
+  }
+}
+
 std::shared_ptr<rocksdb::Statistics> completeRocksdbConfiguration(
-    ::rocksdb::Options& db_options, std::vector<::rocksdb::ColumnFamilyDescriptor>& cf_descs, size_t cache_size) {
+    ::rocksdb::Options& db_options,
+    std::vector<::rocksdb::ColumnFamilyDescriptor>& cf_descs,
+    size_t cache_size,
+    const std::shared_ptr<const storage::rocksdb::ColumnFamilyProfiles>& cf_profiles) {
+  if (cf_profiles) {
+    cf_profiles->apply(cf_descs);
+    return db_options.statistics;
+  }
+
   auto table_options = ::rocksdb::BlockBasedTableOptions{};
   table_options.block_cache = ::rocksdb::NewLRUCache(cache_size);
   table_options.filter_policy.reset(::rocksdb::NewBloomFilterPolicy(10, false));
@@ -241,6 +295,14 @@ std::shared_ptr<rocksdb::Statistics> completeRocksdbConfiguration(
   return db_options.statistics;
 }
 
+// Expose live per column family RocksDB stats via the diagnostics server while the benchmark runs.
+void registerColumnFamilyStatsHandler(const kvbc::categorization::KeyValueBlockchain& kvbc) {
+  auto& registrar = diagnostics::RegistrarSingleton::getInstance();
+  auto handler = diagnostics::StatusHandler(
+      "rocksdb-column-families", "RocksDB Column Family Stats", [&kvbc]() { return kvbc.getColumnFamilyStats(); });
+  registrar.status.registerHandler(handler);
+}
+
 size_t numMerkleVersionsToRead(const po::variables_map& config, size_t num_read_keys) {
   return std::min(config["num-block-merkle-read-keys-per-transaction"].as<size_t>(), num_read_keys);
 }
@@ -325,6 +387,32 @@ void addBlocks(const po::variables_map& config,
   }
 }
 
+// Returns the number of replayed blocks.
+size_t replayBlocks(const po::variables_map& config,
+                    std::shared_ptr<storage::rocksdb::NativeClient>& db,
+                    categorization::KeyValueBlockchain& kvbc,
+                    categorization::UpdatesRecording& recording,
+                    std::shared_ptr<diagnostics::Recorder>& add_block_recorder) {
+  auto stats_dump_period_in_blocks = config["stats-dump-period-in-blocks"].as<size_t>();
+  auto at_recorded_rate = config["replay-at-recorded-rate"].as<bool>();
+  auto start = std::chrono::steady_clock::now();
+  auto num_blocks = size_t{0};
+  while (auto record = recording.next()) {
+    num_blocks++;
+    if (num_blocks % stats_dump_period_in_blocks == 0) {
+      cout << "Adding Block " << num_blocks << endl;
+      printRocksDbProperties(db);
+    }
+    if (at_recorded_rate) {
+      std::this_thread::sleep_until(start + record->time);
+    }
+    // Per-category add latencies are recorded by the blockchain itself.
+    diagnostics::TimeRecorder<> guard(*add_block_recorder);
+    kvbc.addBlock(categorization::Updates{std::move(record->updates)});
+  }
+  return num_blocks;
+}
+
 }  // namespace concord::kvbc::bench
 
 using namespace concord::kvbc::bench;
@@ -347,6 +435,48 @@ int main(int argc, char** argv) {
 
     diagnostics_server.start(registrar, INADDR_ANY, 6888);
 
+    auto rocksdb_stats = std::shared_ptr<::rocksdb::Statistics>{};
+    auto rocksdb_cache_size = config["rocksdb-cache-size"].as<size_t>();
+    auto cf_profiles = std::shared_ptr<const storage::rocksdb::ColumnFamilyProfiles>{};
+    if (config["rocksdb-cf-profiles"].as<bool>()) {
+      cf_profiles = kvbc::categorization::detail::defaultColumnFamilyProfiles(rocksdb_cache_size);
+    }
+    auto completeInit = [&rocksdb_stats, rocksdb_cache_size, &cf_profiles](auto& db_options, auto& cf_descs) {
+      rocksdb_stats = completeRocksdbConfiguration(db_options, cf_descs, rocksdb_cache_size, cf_profiles);
+    };
+    auto opts = storage::rocksdb::NativeClient::UserOptions{"kvbcbench_rocksdb_opts.ini", completeInit};
+    auto newDbClient = [&config, &opts, &cf_profiles]() {
+      auto db = storage::rocksdb::NativeClient::newClient(config["rocksdb-path"].as<std::string>(), false, opts);
+      if (cf_profiles) {
+        db->setColumnFamilyProfiles(cf_profiles);
+      }
+      return db;
+    };
+
+    if (const auto& replay_path = config["replay-updates-path"].as<std::string>(); !replay_path.empty()) {
+      auto recording = kvbc::categorization::UpdatesRecording{replay_path};
+      auto db = newDbClient();
+      auto kvbc = kvbc::categorization::KeyValueBlockchain(db, false, recording.categoryTypes());
+      registerColumnFamilyStatsHandler(kvbc);
+
+      cout << "Starting to Replay Blocks from " << replay_path << "..." << endl;
+      auto start = std::chrono::steady_clock::now();
+      auto replayed_blocks = replayBlocks(config, db, kvbc, recording, add_block_recorder);
+      auto end = std::chrono::steady_clock::now();
+      auto replay_duration = chrono::duration_cast<chrono::milliseconds>(end - start).count();
+      cout << "Replaying " << replayed_blocks << " blocks completed in = " << replay_duration / 1000.0 << " seconds"
+           << endl
+           << endl;
+
+      printRocksDbProperties(db);
+      printRocksDbStallAndCompactionStats(db, rocksdb_stats);
+      printHistograms();
+
+      cout << "Avg. Throughput = " << replayed_blocks / (replay_duration / 1000.0) << " blocks/s" << endl;
+      diagnostics_server.stop();
+      return 0;
+    }
+
     cout << "Starting Input Data Generation..." << endl;
     auto start = std::chrono::steady_clock::now();
     auto input = createBlockInput(config);
@@ -354,13 +484,7 @@ int main(int argc, char** argv) {
     cout << "Input Data Generation completed in " << chrono::duration_cast<chrono::seconds>(end - start).count()
          << " seconds." << endl;
 
-    auto rocksdb_stats = std::shared_ptr<::rocksdb::Statistics>{};
-    auto rocksdb_cache_size = config["rocksdb-cache-size"].as<size_t>();
-    auto completeInit = [&rocksdb_stats, rocksdb_cache_size](auto& db_options, auto& cf_descs) {
-      rocksdb_stats = completeRocksdbConfiguration(db_options, cf_descs, rocksdb_cache_size);
-    };
-    auto opts = storage::rocksdb::NativeClient::UserOptions{"kvbcbench_rocksdb_opts.ini", completeInit};
-    auto db = storage::rocksdb::NativeClient::newClient(config["rocksdb-path"].as<std::string>(), false, opts);
+    auto db = newDbClient();
     auto kvbc = kvbc::categorization::KeyValueBlockchain(
         db,
         false,
@@ -368,6 +492,7 @@ int main(int argc, char** argv) {
             {kCategoryMerkle, kvbc::categorization::CATEGORY_TYPE::block_merkle},
             {kCategoryImmutable, kvbc::categorization::CATEGORY_TYPE::immutable},
             {kCategoryVersioned, kvbc::categorization::CATEGORY_TYPE::versioned_kv}});
+    registerColumnFamilyStatsHandler(kvbc);
 
     auto pre_exec_config = preExecConfig(config, input.block_merkle_read_keys.size(), input.ver_read_keys.size());
     auto pre_exec_sim = PreExecutionSimulator(pre_exec_config, input.block_merkle_read_keys, input.ver_read_keys, kvbc);
@@ -383,6 +508,7 @@ int main(int argc, char** argv) {
     pre_exec_sim.stop();
 
     printRocksDbProperties(db);
+    printRocksDbStallAndCompactionStats(db, rocksdb_stats);
     printHistograms();
 
     cout << "Avg. Throughput = " << config["total-blocks"].as<size_t>() / (add_block_duration / 1000.0) << " blocks/s"
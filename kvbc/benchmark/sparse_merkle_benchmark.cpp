@@ -26,6 +26,21 @@
 #include "sparse_merkle/base_types.h"
 #include "sparse_merkle/internal_node.h"
 
+#ifdef USE_ROCKSDB
+#include "categorization/block_merkle_category.h"
+#include "rocksdb/native_client.h"
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#error "Missing filesystem support"
+#endif
+#endif
+
 #include <cstddef>
 #include <cstdint>
 #include <future>
@@ -401,6 +416,72 @@ BENCHMARK_DEFINE_F(Blockchain, getRawBlock)(benchmark::State &state) {
   }
 }
 
+#ifdef USE_ROCKSDB
+// Adds blocks to a block merkle category one after the other, as the blockchain does, so that the tree internal
+// nodes written by a block are read by the following ones.
+struct BlockMerkle : benchmark::Fixture {
+  using BlockMerkleCategory = ::concord::kvbc::categorization::detail::BlockMerkleCategory;
+  using BlockMerkleInput = ::concord::kvbc::categorization::BlockMerkleInput;
+  using NativeClient = ::concord::storage::rocksdb::NativeClient;
+
+  void SetUp(const benchmark::State &state) override {
+    keyCount = state.range(0);
+    const auto cacheSize = state.range(1);
+    currentKeyValue = 0;
+    lastBlockId = 0;
+
+    fs::remove_all(dbPath);
+    db = NativeClient::newClient(dbPath, false, NativeClient::DefaultOptions{});
+    category = std::make_unique<BlockMerkleCategory>(db, cacheSize);
+
+    for (auto i = 0ull; i < initialBlockCount; ++i) {
+      addBlock(createBlockUpdates());
+    }
+  }
+
+  BlockMerkleInput createBlockUpdates() {
+    auto updates = BlockMerkleInput{};
+    for (auto i = 0ll; i < keyCount; ++i) {
+      updates.kv[toBigEndianStringBuffer(currentKeyValue++)] = randomString(valueSize);
+    }
+    return updates;
+  }
+
+  void addBlock(BlockMerkleInput &&updates) {
+    auto batch = db->getBatch();
+    const auto output = category->add(++lastBlockId, std::move(updates), batch);
+    benchmark::DoNotOptimize(output);
+    db->write(std::move(batch));
+  }
+
+  void TearDown(const benchmark::State &) override {
+    category.reset();
+    db.reset();
+    fs::remove_all(dbPath);
+  }
+
+  const std::string dbPath{"./sparse_merkle_benchmark_rocksdb"};
+  std::shared_ptr<NativeClient> db;
+  std::unique_ptr<BlockMerkleCategory> category;
+  std::uint64_t currentKeyValue{0};
+  std::uint64_t lastBlockId{0};
+  const std::uint64_t initialBlockCount{1024};
+  const std::size_t valueSize{256};
+  std::int64_t keyCount{0};
+};
+
+BENCHMARK_DEFINE_F(BlockMerkle, addBlocks)(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto updates = createBlockUpdates();
+    state.ResumeTiming();
+
+    addBlock(std::move(updates));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+#endif
+
 // Blockchain ranges for:
 //  - key count
 //  - key size
@@ -408,6 +489,14 @@ BENCHMARK_DEFINE_F(Blockchain, getRawBlock)(benchmark::State &state) {
 const auto blockchainRanges = std::vector<std::pair<std::int64_t, std::int64_t>>{{16, 256}, {4, 512}, {1024, 4 * 1024}};
 constexpr auto blockchainRangeMultiplier = 2;
 
+#ifdef USE_ROCKSDB
+// Block merkle ranges for:
+//  - key count
+//  - internal nodes cache size
+const auto blockMerkleRanges = std::vector<std::pair<std::int64_t, std::int64_t>>{{1, 64}, {0, 4 * 1024}};
+constexpr auto blockMerkleRangeMultiplier = 8;
+#endif
+
 constexpr auto shaRangeStart = 8;
 constexpr auto shaRangeEnd = 40 * 1024 * 1024;
 
@@ -443,5 +532,8 @@ BENCHMARK_REGISTER_F(Blockchain, getInternalFromDb)
     ->Ranges(blockchainRanges);
 BENCHMARK_REGISTER_F(Blockchain, updateCachePut)->RangeMultiplier(blockchainRangeMultiplier)->Ranges(blockchainRanges);
 BENCHMARK_REGISTER_F(Blockchain, getRawBlock)->RangeMultiplier(blockchainRangeMultiplier)->Ranges(blockchainRanges);
+#ifdef USE_ROCKSDB
+BENCHMARK_REGISTER_F(BlockMerkle, addBlocks)->RangeMultiplier(blockMerkleRangeMultiplier)->Ranges(blockMerkleRanges);
+#endif
 
 BENCHMARK_MAIN();
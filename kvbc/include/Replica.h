@@ -34,6 +34,10 @@
 
 namespace concord::kvbc {
 
+namespace pruning {
+class PruningHandler;
+}
+
 class Replica : public IReplica,
                 public IBlocksDeleter,
                 public IReader,
@@ -82,6 +86,11 @@ class Replica : public IReplica,
 
   std::optional<categorization::Updates> getBlockUpdates(BlockId block_id) const override;
 
+  std::optional<categorization::MultiKeyValueProof> getMultiProof(const std::string &category_id,
+                                                                  BlockId block_id,
+                                                                  const std::vector<std::string> &keys,
+                                                                  const std::string &tag) const override;
+
   // Get the current genesis block ID in the system.
   BlockId getGenesisBlockId() const override;
 
@@ -141,6 +150,9 @@ class Replica : public IReplica,
 
   void setReplicaStateSync(ReplicaStateSync *rss) { replicaStateSync_.reset(rss); }
 
+  // Pruned blocks are kept in the given archive and are still served to state transfer and to readers.
+  void setBlockArchive(const std::shared_ptr<categorization::IBlockArchive> &archive);
+
   bftEngine::IStateTransfer &getStateTransfer() { return *m_stateTransfer; }
 
   std::shared_ptr<cron::CronTableRegistry> cronTableRegistry() const { return cronTableRegistry_; }
@@ -216,6 +228,7 @@ class Replica : public IReplica,
   const std::shared_ptr<concord::secretsmanager::ISecretsManagerImpl> secretsManager_;
   std::unique_ptr<concord::kvbc::StReconfigurationHandler> stReconfigurationSM_;
   std::shared_ptr<cron::CronTableRegistry> cronTableRegistry_{std::make_shared<cron::CronTableRegistry>()};
+  std::shared_ptr<pruning::PruningHandler> pruningHandler_;
   concord::util::ThreadPool blocksIOWorkersPool_;
   std::unique_ptr<concord::client::reconfiguration::ClientReconfigurationEngine> creEngine_;
   std::shared_ptr<concord::client::reconfiguration::IStateClient> creClient_;
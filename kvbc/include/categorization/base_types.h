@@ -21,7 +21,9 @@
 #include <limits>
 #include <optional>
 #include <string>
+#include <utility>
 #include <variant>
+#include <vector>
 
 namespace concord::kvbc::categorization {
 
@@ -88,6 +90,60 @@ struct KeyValueProof {
   }
 };
 
+// A proof for multiple key-values against the same root hash. The hashes of the other key-values are shared by all of
+// them, i.e. proving M out of N key-values takes 2 * (N - M) complement hashes instead of M * 2 * (N - 1) with
+// KeyValueProofs.
+struct MultiKeyValueProof {
+  BlockId block_id{0};
+
+  // Ordered as in the root hash.
+  std::vector<std::pair<std::string, std::string>> key_values;
+
+  // For each key-value, the index at which its hashes are to be combined with the complement ones. Consecutive
+  // key-values have the same index.
+  std::vector<std::size_t> key_value_indexes;
+
+  // Ordered hashes of the other key-values in the category.
+  std::vector<Hash> ordered_complement_kv_hashes;
+
+  // Return std::nullopt if the proof is malformed.
+  std::optional<Hash> calculateRootHash() const {
+    if (key_values.empty() || key_values.size() != key_value_indexes.size()) {
+      return std::nullopt;
+    }
+    for (auto i = 0ul; i < key_value_indexes.size(); ++i) {
+      // Complement hashes come in pairs - one of the key and one of the value.
+      if (key_value_indexes[i] % 2 != 0 || (i > 0 && key_value_indexes[i] < key_value_indexes[i - 1])) {
+        return std::nullopt;
+      }
+    }
+
+    // root_hash = h(h(k1) || h(v1) || h(k2) || h(v2) || ... || h(kn) || h(vn))
+    auto hasher = Hasher{};
+    hasher.init();
+    const auto update = [&hasher](const auto &in) { hasher.update(in.data(), in.size()); };
+    auto next = 0ul;
+    const auto update_key_values = [&](std::size_t index) {
+      for (; next < key_values.size() && key_value_indexes[next] == index; ++next) {
+        const auto &[key, value] = key_values[next];
+        update(Hasher{}.digest(key.data(), key.size()));
+        update(Hasher{}.digest(value.data(), value.size()));
+      }
+    };
+
+    for (auto i = 0ul; i < ordered_complement_kv_hashes.size(); ++i) {
+      update_key_values(i);
+      update(ordered_complement_kv_hashes[i]);
+    }
+    update_key_values(ordered_complement_kv_hashes.size());
+    // All key-values must be part of the root hash.
+    if (next != key_values.size()) {
+      return std::nullopt;
+    }
+    return hasher.finish();
+  }
+};
+
 struct TaggedVersion {
   // The high bit contains a flag indicating whether the key was deleted or not.
   TaggedVersion(uint64_t masked_version) {
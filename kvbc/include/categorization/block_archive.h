@@ -0,0 +1,78 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include "blocks.h"
+#include "storage/db_interface.h"
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace concord::kvbc::categorization {
+
+// A cold store for blocks that are pruned from the blockchain. Blocks are archived before they are deleted from
+// RocksDB, so that they can still be read once they are gone from the blockchain.
+// Implementations must be thread-safe.
+class IBlockArchive {
+ public:
+  virtual ~IBlockArchive() = default;
+
+  // Blocks are archived in order, i.e. the archive holds the blocks in [firstBlockId(), lastBlockId()]. Archiving the
+  // same block more than once is allowed. If a block is archived with a gap after the last archived block, the archive
+  // only holds the blocks from that block on.
+  virtual void put(BlockId block_id, const RawBlock& block) = 0;
+  virtual std::optional<RawBlock> get(BlockId block_id) const = 0;
+
+  // Remove the archived blocks above `last_block_id`, e.g. after they have been deleted from the blockchain and might
+  // be replaced by different blocks.
+  virtual void truncate(BlockId last_block_id) = 0;
+
+  // The lowest archived block ID or 0 if the archive is empty.
+  virtual BlockId firstBlockId() const = 0;
+  // The highest archived block ID or 0 if the archive is empty.
+  virtual BlockId lastBlockId() const = 0;
+
+  bool has(BlockId block_id) const { return block_id > 0 && block_id >= firstBlockId() && block_id <= lastBlockId(); }
+};
+
+// Archives blocks through an IDBClient, e.g. the S3 object store client.
+class DBClientBlockArchive : public IBlockArchive {
+ public:
+  // Keys are prefixed with `path_prefix` (if not empty) followed by a '/'.
+  DBClientBlockArchive(const std::shared_ptr<storage::IDBClient>& db, const std::string& path_prefix = "");
+
+  void put(BlockId block_id, const RawBlock& block) override;
+  std::optional<RawBlock> get(BlockId block_id) const override;
+  void truncate(BlockId last_block_id) override;
+  BlockId firstBlockId() const override;
+  BlockId lastBlockId() const override;
+
+ private:
+  std::string blockKey(BlockId block_id) const;
+  // Persist the archived block range in a single key, so that it is updated atomically.
+  void putRange(BlockId first_block_id, BlockId last_block_id);
+
+ private:
+  std::shared_ptr<storage::IDBClient> db_;
+  const std::string prefix_;
+  const std::string range_key_;
+  // Serializes access to the DB client, which doesn't have to be thread-safe, and protects the block range
+  mutable std::mutex lock_;
+  BlockId first_block_id_{0};
+  BlockId last_block_id_{0};
+};
+
+}  // namespace concord::kvbc::categorization
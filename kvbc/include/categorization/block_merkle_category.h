@@ -16,6 +16,7 @@
 #ifdef USE_ROCKSDB
 
 #include "Logger.hpp"
+#include "lru_cache.hpp"
 #include "rocksdb/native_client.h"
 #include "sparse_merkle/tree.h"
 
@@ -34,7 +35,14 @@ namespace concord::kvbc::categorization::detail {
 class BlockMerkleCategory {
  public:
   BlockMerkleCategory() = default;  // Gtest usage only
-  BlockMerkleCategory(const std::shared_ptr<storage::rocksdb::NativeClient>&);
+  // Up to `internal_nodes_cache_size` recently written or read merkle tree internal nodes are cached in memory across
+  // blocks, so that updates don't reload the upper levels of the tree from the DB (0 - disabled).
+  BlockMerkleCategory(const std::shared_ptr<storage::rocksdb::NativeClient>&,
+                      std::size_t internal_nodes_cache_size = 0);
+
+  // Must be called after the batch filled by add() or deleteGenesisBlock() is written to the DB. The internal nodes of
+  // the tree update are cached only then, so that a batch that is never written doesn't leave them in the cache.
+  void onBatchWritten() { reader_->cacheStagedNodes(); }
 
   // Add the given block updates and return the information that needs to be persisted in the block.
   BlockMerkleOutput add(BlockId block_id, BlockMerkleInput&& update, storage::rocksdb::NativeWriteBatch&);
@@ -200,7 +208,11 @@ class BlockMerkleCategory {
  private:
   class Reader : public sparse_merkle::IDBReader {
    public:
-    Reader(const storage::rocksdb::NativeClient& db) : db_{db} {}
+    Reader(const storage::rocksdb::NativeClient& db, std::size_t internal_nodes_cache_size) : db_{db} {
+      if (internal_nodes_cache_size > 0) {
+        cache_.emplace(internal_nodes_cache_size);
+      }
+    }
 
     // Return the latest root node in the system.
     sparse_merkle::BatchedInternalNode get_latest_root() const override;
@@ -210,15 +222,59 @@ class BlockMerkleCategory {
     // Throws a std::out_of_range exception if the internal node does not exist.
     sparse_merkle::BatchedInternalNode get_internal(const sparse_merkle::InternalNodeKey&) const override;
 
+    // Keep the internal nodes of a tree update, including the new latest root, until cacheStagedNodes() is called
+    // after the update is written to the DB. Staging an update drops the nodes of a previous one that was never
+    // written (e.g. because the write failed).
+    void stageInternalNodes(const sparse_merkle::UpdateBatch&);
+
+    // Cache the staged nodes. Must be called only after the staged tree update is written to the DB.
+    void cacheStagedNodes();
+
+    // Drop all cached nodes. Must be called when a tree version is removed, as it can be rewritten with different
+    // nodes.
+    void invalidateCache();
+
    private:
+    struct InternalNodeKeyHash {
+      std::size_t operator()(const sparse_merkle::InternalNodeKey& key) const {
+        const auto& path = key.path().data();
+        const auto h = std::hash<std::uint64_t>{}(key.version().value());
+        const auto p = std::hash<std::string_view>{}(
+            std::string_view{reinterpret_cast<const char*>(path.data()), path.size()});
+        return h ^ (p + key.path().length() + 0x9e3779b9 + (h << 6) + (h >> 2));
+      }
+    };
+
+    struct StagedUpdate {
+      std::vector<std::pair<sparse_merkle::InternalNodeKey, sparse_merkle::BatchedInternalNode>> nodes;
+      std::optional<sparse_merkle::BatchedInternalNode> latest_root;
+    };
+
+    struct Cache {
+      Cache(std::size_t capacity) : nodes{capacity} {}
+      // Internal nodes never change for a given key (version and path), unless their version is removed by
+      // deleteLastReachableBlock(). Nodes that are deleted as stale by pruning are not reachable from the latest root
+      // and, therefore, are never requested again - they are just left to be evicted.
+      util::LruCache<sparse_merkle::InternalNodeKey, sparse_merkle::BatchedInternalNode, InternalNodeKeyHash> nodes;
+      std::optional<sparse_merkle::BatchedInternalNode> latest_root;
+      // The tree update that is not yet known to be written to the DB.
+      std::optional<StagedUpdate> staged;
+    };
+
     // The lifetime of this reference is shorter than the lifetime of the tree which is shorter than
     // the lifetime of the category.
     const storage::rocksdb::NativeClient& db_;
+
+    // Only accessed through tree updates, which are not thread-safe anyway.
+    // std::nullopt if the cache is disabled.
+    mutable std::optional<Cache> cache_;
   };
 
  private:
   std::shared_ptr<storage::rocksdb::NativeClient> db_;
 
+  // Shared with the tree.
+  std::shared_ptr<Reader> reader_;
   sparse_merkle::Tree tree_;
 };
 
@@ -0,0 +1,92 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include "base_types.h"
+#include "rocksdb/native_client.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace concord::kvbc::categorization::detail {
+
+// An append-only store of serialized raw blocks.
+//
+// Records are appended to segment files that are read through mmap. Only the location of each record is kept in
+// RocksDB (in BLOCK_SEGMENTS_CF) and it is written as part of the block's write batch, so a record becomes visible
+// together with its block. Each record carries a CRC32 of its data that is verified on every read.
+//
+// Appends and deletes must come from a single thread, while reads are thread-safe.
+class BlockSegmentStore {
+  struct Segment;
+
+ public:
+  // A record that is read in place from its mapped segment. The segment stays mapped (even if it is deleted in the
+  // meantime) for as long as the record is alive.
+  class Record {
+   public:
+    std::string_view data() const { return data_; }
+
+   private:
+    Record(const std::shared_ptr<const Segment>& segment, std::string_view data) : segment_{segment}, data_{data} {}
+
+   private:
+    std::shared_ptr<const Segment> segment_;
+    std::string_view data_;
+
+    friend class BlockSegmentStore;
+  };
+
+ public:
+  // Segments are created in `path` with a size of at least `segment_size` bytes.
+  BlockSegmentStore(const std::shared_ptr<storage::rocksdb::NativeClient>& native_client,
+                    const std::string& path,
+                    std::uint64_t segment_size);
+
+  // Appends a record to the active segment and puts its location in the batch.
+  void append(BlockId block_id, std::string_view data, storage::rocksdb::NativeWriteBatch& batch);
+
+  // Deletes the location of a record. Its space is reclaimed when its segment is removed by removeSegmentsBefore().
+  void erase(BlockId block_id, storage::rocksdb::NativeWriteBatch& batch);
+
+  // Removes the segments that only contain records of blocks lower than `block_id`. Must be called after the locations
+  // of these records have been deleted.
+  void removeSegmentsBefore(BlockId block_id);
+
+  // Throws if the record fails the checksum.
+  std::optional<Record> get(BlockId block_id) const;
+
+ private:
+  std::shared_ptr<Segment> createSegment(std::uint64_t id, std::uint64_t size);
+  std::shared_ptr<Segment> openSegment(std::uint64_t id, bool is_last);
+  std::string segmentPath(std::uint64_t id) const;
+
+ private:
+  std::shared_ptr<storage::rocksdb::NativeClient> native_client_;
+  const std::string path_;
+  const std::uint64_t segment_size_;
+
+  // Protects segments_. The contents of the segments are not protected, as records are only read after their
+  // location is written, i.e. after they are appended.
+  mutable std::mutex segments_lock_;
+  std::map<std::uint64_t, std::shared_ptr<Segment>> segments_;
+  std::shared_ptr<Segment> active_segment_;
+};
+
+}  // namespace concord::kvbc::categorization::detail
@@ -22,6 +22,9 @@ inline const auto BLOCKS_CF = std::string{"blocks"};
 inline const auto ST_CHAIN_CF = std::string{"st_chain"};
 inline const auto CAT_ID_TYPE_CF = std::string{"cat_id_type"};
 
+// BlockSegmentStore
+inline const auto BLOCK_SEGMENTS_CF = std::string{"block_segments"};
+
 // ImmutableKeyValueCategory
 inline const auto IMMUTABLE_KV_CF_SUFFIX = std::string{"_immutable"};
 
@@ -0,0 +1,94 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include "column_families.h"
+#include "rocksdb/column_family_profiles.h"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace concord::kvbc::categorization::detail {
+
+// RocksDB option profiles of the categorized blockchain column families, selected by access pattern.
+//
+// Raw blocks are written once and read back sequentially by state transfer and pruning.
+inline const auto BLOCKS_CF_PROFILE = std::string{"blocks"};
+// Point lookups of the latest version of a key - the hottest read path.
+inline const auto LATEST_VERSIONS_CF_PROFILE = std::string{"latest_versions"};
+// Key values, read after their version is known.
+inline const auto VALUES_CF_PROFILE = std::string{"values"};
+// Sparse merkle tree nodes, read and written on every block.
+inline const auto MERKLE_INTERNAL_NODES_CF_PROFILE = std::string{"merkle_internal_nodes"};
+// Everything else, e.g. pruning bookkeeping.
+inline const auto DEFAULT_CF_PROFILE = std::string{"default"};
+
+inline bool endsWith(const std::string &str, const std::string &suffix) {
+  return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Return the profile of a column family, by its name or by the suffix of its category type.
+inline const std::string &columnFamilyProfile(const std::string &cf) {
+  if (cf == BLOCKS_CF || cf == ST_CHAIN_CF || cf == BLOCK_SEGMENTS_CF) {
+    return BLOCKS_CF_PROFILE;
+  } else if (cf == BLOCK_MERKLE_LATEST_KEY_VERSION_CF || endsWith(cf, VERSIONED_KV_LATEST_VER_CF_SUFFIX)) {
+    return LATEST_VERSIONS_CF_PROFILE;
+  } else if (cf == BLOCK_MERKLE_LEAF_NODES_CF || cf == BLOCK_MERKLE_KEYS_CF ||
+             endsWith(cf, VERSIONED_KV_VALUES_CF_SUFFIX) || endsWith(cf, IMMUTABLE_KV_CF_SUFFIX)) {
+    return VALUES_CF_PROFILE;
+  } else if (cf == BLOCK_MERKLE_INTERNAL_NODES_CF) {
+    return MERKLE_INTERNAL_NODES_CF_PROFILE;
+  }
+  return DEFAULT_CF_PROFILE;
+}
+
+// Split `block_cache_size` bytes of block cache between the profiles above. Column families are mapped to profiles via
+// columnFamilyProfile().
+//
+// Note: None of the profiles use a prefix extractor, because the versioned values and the merkle keys column families
+// are iterated across key prefixes when looking up a key at a given version.
+inline std::shared_ptr<const storage::rocksdb::ColumnFamilyProfiles> defaultColumnFamilyProfiles(
+    std::size_t block_cache_size) {
+  using storage::rocksdb::ColumnFamilyProfile;
+  auto blocks = ColumnFamilyProfile{};
+  blocks.block_cache_share = 0.1;
+  blocks.compaction_style = ::rocksdb::kCompactionStyleUniversal;
+  blocks.optimize_filters_for_hits = true;
+
+  auto latest_versions = ColumnFamilyProfile{};
+  latest_versions.block_cache_share = 0.3;
+
+  auto values = ColumnFamilyProfile{};
+  values.block_cache_share = 0.2;
+
+  auto merkle_internal_nodes = ColumnFamilyProfile{};
+  merkle_internal_nodes.block_cache_share = 0.3;
+  merkle_internal_nodes.optimize_filters_for_hits = true;
+
+  auto other = ColumnFamilyProfile{};
+  other.block_cache_share = 0.1;
+
+  return std::make_shared<storage::rocksdb::ColumnFamilyProfiles>(
+      block_cache_size,
+      std::map<std::string, ColumnFamilyProfile>{{BLOCKS_CF_PROFILE, blocks},
+                                                 {LATEST_VERSIONS_CF_PROFILE, latest_versions},
+                                                 {VALUES_CF_PROFILE, values},
+                                                 {MERKLE_INTERNAL_NODES_CF_PROFILE, merkle_internal_nodes},
+                                                 {DEFAULT_CF_PROFILE, other}},
+      [](const std::string &cf) { return columnFamilyProfile(cf); });
+}
+
+}  // namespace concord::kvbc::categorization::detail
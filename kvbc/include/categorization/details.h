@@ -15,6 +15,7 @@
 
 #include "base_types.h"
 #include "categorized_kvbc_msgs.cmf.hpp"
+#include "column_family_profiles.h"
 #include "rocksdb/native_client.h"
 
 #include <algorithm>
@@ -84,9 +85,10 @@ void deserialize(const Span &in, T &out) {
   deserialize(begin, begin + in.size(), out);
 }
 
+// Newly created column families get the options of their profile, if the client has profiles set.
 inline bool createColumnFamilyIfNotExisting(const std::string &cf, storage::rocksdb::NativeClient &db) {
   if (!db.hasColumnFamily(cf)) {
-    db.createColumnFamily(cf);
+    db.createColumnFamilyWithProfile(cf, columnFamilyProfile(cf));
     return true;
   }
   return false;
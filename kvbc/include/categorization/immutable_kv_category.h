@@ -93,6 +93,13 @@ class ImmutableKeyValueCategory {
                                         const std::string &key,
                                         const ImmutableOutput &updates_info) const;
 
+  // Get the values of `keys` and a single proof for all of them in `tag`.
+  // Return std::nullopt if any of the keys isn't tagged with `tag` in the block or if no root hash was calculated for
+  // the tag.
+  std::optional<MultiKeyValueProof> getMultiProof(const std::string &tag,
+                                                  const std::vector<std::string> &keys,
+                                                  const ImmutableOutput &updates_info) const;
+
  private:
   std::string cf_;
   std::shared_ptr<storage::rocksdb::NativeClient> db_;
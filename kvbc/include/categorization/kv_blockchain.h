@@ -28,6 +28,15 @@
 #include "diagnostics.h"
 #include "performance_handler.h"
 #include "bftengine/ReplicaConfig.hpp"
+#include "lru_cache.hpp"
+#include "block_archive.h"
+#include "block_segment_store.h"
+#include "updates_recorder.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace concord::kvbc::categorization {
 
@@ -44,6 +53,7 @@ class KeyValueBlockchain {
   KeyValueBlockchain(const std::shared_ptr<concord::storage::rocksdb::NativeClient>& native_client,
                      bool link_st_chain,
                      const std::optional<std::map<std::string, CATEGORY_TYPE>>& category_types = std::nullopt);
+  ~KeyValueBlockchain();
   /////////////////////// Add Block ///////////////////////
 
   BlockId addBlock(Updates&& updates);
@@ -60,6 +70,23 @@ class KeyValueBlockchain {
   void addRawBlock(const RawBlock& block, const BlockId& block_id, bool lastBlock = true);
   std::optional<RawBlock> getRawBlock(const BlockId& block_id) const;
 
+  // Returns the serialized raw block of a block in the blockchain as it is read in place from the block segment store.
+  // Returns std::nullopt if the store is not used or doesn't have the block, in which case getRawBlock() should be used.
+  std::optional<detail::BlockSegmentStore::Record> getSerializedRawBlock(BlockId block_id) const;
+
+  /////////////////////// Block archive ///////////////////////
+
+  // Archive blocks in `archive` before they are pruned. Blocks below the genesis block are read from the archive by
+  // getRawBlock(), hasBlock() and parentDigest() afterwards.
+  // Blocks that are `horizon` or more blocks older than the last reachable block are archived in the background, ahead
+  // of pruning. A block that is pruned before it is archived is archived synchronously by the pruning path, which then
+  // waits for the archive, so `horizon` should be smaller than the number of blocks that pruning keeps.
+  // Archived blocks that are deleted by deleteLastReachableBlock() on replica state sync are removed from the archive,
+  // so the horizon should be larger than the number of such blocks in order to avoid archiving blocks twice.
+  // Throws std::invalid_argument if `horizon` is 0.
+  // Should be called once, before the blockchain is used.
+  void setBlockArchive(const std::shared_ptr<IBlockArchive>& archive, std::uint64_t horizon);
+
   /////////////////////// Info ///////////////////////
   BlockId getGenesisBlockId() const { return block_chain_.getGenesisBlockId(); }
   BlockId getLastReachableBlockId() const { return block_chain_.getLastReachableBlockId(); }
@@ -109,6 +136,15 @@ class KeyValueBlockchain {
   // Get the updates that were used to create `block_id`.
   std::optional<Updates> getBlockUpdates(BlockId block_id) const;
 
+  // Get the values of `keys` in `block_id` and a single proof for all of them against the root hash of the category in
+  // the block. For immutable categories, the proof is against the root hash of `tag`.
+  // Return std::nullopt if the block or the category doesn't exist, if the category is a block merkle one, or if the
+  // category's getMultiProof() does.
+  std::optional<MultiKeyValueProof> getMultiProof(const std::string& category_id,
+                                                  BlockId block_id,
+                                                  const std::vector<std::string>& keys,
+                                                  const std::string& tag) const;
+
   // Get a map of category_id and stale keys for `block_id`
   std::map<std::string, std::vector<std::string>> getBlockStaleKeys(BlockId block_id) const;
 
@@ -146,6 +182,28 @@ class KeyValueBlockchain {
   const Category& getCategoryRef(const std::string& cat_id) const;
   Category& getCategoryRef(const std::string& cat_id);
 
+  // Called after a batch with block merkle tree updates of `category_id` is written. Updates of a batch that is not
+  // written are never cached.
+  void cacheMerkleInternalNodes(const std::string& category_id);
+
+  /////////////////////// Latest values cache ///////////////////////
+
+  // Only the latest values of versioned and block merkle keys are cached, as reading them from storage takes a lookup
+  // of the latest version followed by a lookup of the value.
+  bool isLatestValueCached(const std::string& category_id) const;
+  // Write-through of the updates of a block that has just been written to storage.
+  void updateLatestValuesCache(BlockId block_id, const CategoryInput& updates);
+  // Drop the keys of a block whose deletion may change their latest values.
+  void invalidateLatestValuesCache(const BlockData& block_data);
+  // Records the updates of a block that has just been written to storage, if recording is enabled.
+  void recordUpdates(BlockId block_id, const CategoryInput& updates);
+
+  /////////////////////// Block archive ///////////////////////
+
+  // Archive the blocks in [genesis, until) that are not archived yet.
+  void archiveBlocksUntil(BlockId until);
+  void runBlockArchiver(std::uint64_t horizon);
+
   /////////////////////// deletes ///////////////////////
 
   void deleteStateTransferBlock(const BlockId block_id);
@@ -212,9 +270,48 @@ class KeyValueBlockchain {
   // E.L - compare this with getRawBlock to see they are equal
   VersionedRawBlock last_raw_block_;
 
+  // Keeps the serialized raw blocks of the blockchain, if enabled via ReplicaConfig::kvbcBlockSegmentsPath.
+  std::optional<detail::BlockSegmentStore> block_segments_;
+
+  // Records the updates of added blocks, if enabled via ReplicaConfig::kvbcUpdatesRecordingPath.
+  std::optional<UpdatesRecorder> updates_recorder_;
+
   // currently we are operating with single thread
   util::ThreadPool thread_pool_{1};
 
+  // The number of state transfer blocks that are read ahead per prefetch thread when linking the chains.
+  static constexpr auto kSTLinkPrefetchedBlocksPerThread = std::size_t{4};
+
+  // Category ID and key
+  using LatestValueKey = std::pair<std::string, std::string>;
+  struct LatestValueKeyHash {
+    std::size_t operator()(const LatestValueKey& key) const {
+      const auto h = std::hash<std::string>{}(key.first);
+      return h ^ (std::hash<std::string>{}(key.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+    }
+  };
+  struct LatestValuesCache {
+    LatestValuesCache(std::size_t capacity) : values{capacity} {}
+    std::mutex lock;
+    // A nullopt value means that the key doesn't exist or has been deleted.
+    util::LruCache<LatestValueKey, std::optional<Value>, LatestValueKeyHash> values;
+    // Incremented on every change of the cached keys, so that values that were read from storage concurrently with a
+    // change are not cached.
+    std::uint64_t generation{0};
+  };
+  // nullptr if the cache is disabled (see ReplicaConfig::kvbcLatestValuesCacheSize)
+  std::unique_ptr<LatestValuesCache> latest_values_cache_;
+
+  std::shared_ptr<IBlockArchive> block_archive_;
+  // Taken while a block is archived and while the genesis or the last reachable block is deleted, so that a block is
+  // never archived while it is being deleted.
+  std::mutex block_archive_lock_;
+  std::thread block_archiver_;
+  std::atomic_bool stop_block_archiver_{false};
+  std::mutex block_archiver_stop_lock_;
+  std::condition_variable block_archiver_stop_cv_;
+  static constexpr auto kBlockArchiverPeriod = std::chrono::seconds{1};
+
   // metrics
   std::shared_ptr<concordMetrics::Aggregator> aggregator_;
   concordMetrics::Component delete_metrics_comp_;
@@ -227,6 +324,11 @@ class KeyValueBlockchain {
   concordMetrics::CounterHandle immutable_num_of_keys_;
   concordMetrics::CounterHandle merkle_num_of_keys_;
 
+  concordMetrics::Component latest_values_cache_metrics_comp_;
+  // Updated by the readers under the cache lock
+  mutable concordMetrics::CounterHandle latest_values_cache_hits_;
+  mutable concordMetrics::CounterHandle latest_values_cache_misses_;
+
   std::chrono::seconds dump_delete_metrics_interval_{bftEngine::ReplicaConfig::instance().deleteMetricsDumpInterval};
   std::chrono::seconds last_dump_time_{0};
   uint64_t latest_deleted_merkle_dump{0};
@@ -251,10 +353,15 @@ class KeyValueBlockchain {
 
   std::string getPruningStatus();
 
+  // Return live RocksDB stats as JSON - block cache hit rate and write stalls for the whole DB and, per column family,
+  // compaction debt, write stalls, memtable and block cache usage.
+  std::string getColumnFamilyStats() const;
+
   void setAggregator(std::shared_ptr<concordMetrics::Aggregator> aggregator) {
     aggregator_ = aggregator;
     delete_metrics_comp_.SetAggregator(aggregator_);
     add_metrics_comp_.SetAggregator(aggregator);
+    latest_values_cache_metrics_comp_.SetAggregator(aggregator);
   }
   friend struct KeyValueBlockchain_tester;
 
@@ -270,6 +377,9 @@ class KeyValueBlockchain {
       auto& registrar = concord::diagnostics::RegistrarSingleton::getInstance();
       registrar.perf.registerComponent("kvbc",
                                        {addBlock,
+                                        addBlockMerkleUpdates,
+                                        addVersionedUpdates,
+                                        addImmutableUpdates,
                                         addRawBlock,
                                         getRawBlock,
                                         deleteBlock,
@@ -288,6 +398,10 @@ class KeyValueBlockchain {
     // DEFINE_SHARED_RECORDER(may_have_conflict_between, 1, MAX_VALUE_NANOSECONDS, 3,
     // concord::diagnostics::Unit::NANOSECONDS);
     DEFINE_SHARED_RECORDER(addBlock, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
+    DEFINE_SHARED_RECORDER(
+        addBlockMerkleUpdates, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
+    DEFINE_SHARED_RECORDER(addVersionedUpdates, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
+    DEFINE_SHARED_RECORDER(addImmutableUpdates, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
     DEFINE_SHARED_RECORDER(addRawBlock, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
     DEFINE_SHARED_RECORDER(getRawBlock, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
     DEFINE_SHARED_RECORDER(deleteBlock, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
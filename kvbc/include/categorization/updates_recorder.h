@@ -0,0 +1,78 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include "base_types.h"
+#include "categorized_kvbc_msgs.cmf.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace concord::kvbc::categorization {
+
+// Records the categorized updates that are added to a blockchain, including the blocks linked by state transfer, so
+// that they can be replayed later (e.g. by kvbcbench) with the key sizes and update patterns of a real workload.
+//
+// A recording starts with the category types of the blockchain, followed by one record per added block. A record holds
+// the time the block was added at (relative to the start of the recording) and the CMF-serialized CategoryInput.
+// Integers are written in native byte order. A partially written last record (e.g. after a crash) is ignored when
+// replaying.
+class UpdatesRecorder {
+ public:
+  // Records to a new file named `path_prefix` followed by the current time (".YYYYmmdd-HHMMSS.micros"), so that the
+  // recording of a previous run is kept. Throws if it cannot be opened.
+  UpdatesRecorder(const std::string &path_prefix, const std::map<std::string, CATEGORY_TYPE> &category_types);
+
+  const std::string &path() const { return path_; }
+
+  // Not thread-safe. Throws on write errors, after which the recording should not be used.
+  void record(const CategoryInput &updates);
+
+ private:
+  const std::string path_;
+  std::ofstream file_;
+  const std::chrono::steady_clock::time_point start_;
+  std::vector<std::uint8_t> buffer_;
+};
+
+// Reads a recording written by UpdatesRecorder.
+class UpdatesRecording {
+ public:
+  struct Record {
+    // The time since the start of the recording.
+    std::chrono::microseconds time;
+    CategoryInput updates;
+  };
+
+  // Throws if the file cannot be opened or is not a recording.
+  explicit UpdatesRecording(const std::string &path);
+
+  const std::map<std::string, CATEGORY_TYPE> &categoryTypes() const { return category_types_; }
+
+  // Returns std::nullopt at the end of the recording, including when the last record is partially written.
+  std::optional<Record> next();
+
+ private:
+  std::ifstream file_;
+  std::uint64_t file_size_{0};
+  std::map<std::string, CATEGORY_TYPE> category_types_;
+  std::vector<std::uint8_t> buffer_;
+};
+
+}  // namespace concord::kvbc::categorization
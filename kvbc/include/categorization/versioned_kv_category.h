@@ -88,6 +88,12 @@ class VersionedKeyValueCategory {
   // Return std::nullopt if the key doesn't exist.
   std::optional<KeyValueProof> getProof(BlockId block_id, const std::string &key, const VersionedOutput &) const;
 
+  // Get the values of `keys` and a single proof for all of them at `block_id`.
+  // Return std::nullopt if any of the keys isn't updated in the block or if no root hash was calculated for it.
+  std::optional<MultiKeyValueProof> getMultiProof(BlockId block_id,
+                                                  const std::vector<std::string> &keys,
+                                                  const VersionedOutput &) const;
+
   // Get all stale keys as of `block_id`.
   std::vector<std::string> getBlockStaleKeys(BlockId block_id, const VersionedOutput &) const;
 
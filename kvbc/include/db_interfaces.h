@@ -77,6 +77,14 @@ class IReader {
   // Return std::nullopt if this block doesn't exist.
   virtual std::optional<categorization::Updates> getBlockUpdates(BlockId block_id) const = 0;
 
+  // Get the values of `keys` in `block_id` in `category_id` and a single proof for all of them against the root hash of
+  // the category in the block. For immutable categories, the proof is against the root hash of `tag`.
+  // Return std::nullopt if any of the keys isn't part of the root hash or if there is no such root hash.
+  virtual std::optional<categorization::MultiKeyValueProof> getMultiProof(const std::string &category_id,
+                                                                          BlockId block_id,
+                                                                          const std::vector<std::string> &keys,
+                                                                          const std::string &tag) const = 0;
+
   // Get the current genesis block ID in the system.
   virtual BlockId getGenesisBlockId() const = 0;
 
@@ -20,8 +20,11 @@
 #include "Crypto.hpp"
 #include "block_metadata.hpp"
 #include "kvbc_key_types.hpp"
+#include <chrono>
 #include <future>
 #include "reconfiguration/reconfiguration_handler.hpp"
+#include <ccron/cron_table_registry.hpp>
+#include <ccron/ticks_generator.hpp>
 
 namespace concord::kvbc::pruning {
 
@@ -138,13 +141,27 @@ class PruningHandler : public concord::reconfiguration::BftReconfigurationHandle
   // If all above conditions are met, the state machine will prune blocks from the
   // genesis block up to the the minimum of all the block IDs in
   // LatestPrunableBlock messages in the PruneRequest message.
+  //
+  // By default, consensus is stopped until all these blocks are pruned. If
+  // pruningOnline_ is set, consensus goes on instead, and every pruning tick
+  // (once in tick_period_seconds, ordered by consensus) prunes the next
+  // batch_blocks_num blocks, so that all the replicas prune the same blocks in
+  // the same place in the order of execution. The PruneStatus reports the last
+  // block pruned so far while online pruning is in progress.
  public:
+  // The component ID of the ticks that drive online pruning.
+  static constexpr std::uint32_t kPruningTicksComponentId = 1;
+
   // Construct by providing an interface to the storage engine, state transfer,
   // configuration and tracing facilities. Note this constructor may throw an
   // exception if there is an issue with the configuration (for example, if the
   // configuration enables pruning but does not provide a purning operator
   // public key).
-  PruningHandler(kvbc::IReader &, kvbc::IBlockAdder &, kvbc::IBlocksDeleter &, bool run_async = false);
+  PruningHandler(kvbc::IReader &,
+                 kvbc::IBlockAdder &,
+                 kvbc::IBlocksDeleter &,
+                 bool run_async = false,
+                 const std::shared_ptr<cron::CronTableRegistry> &cron_table_registry = nullptr);
   bool handle(const concord::messages::LatestPrunableBlockRequest &,
               uint64_t,
               concord::messages::ReconfigurationResponse &) override;
@@ -153,6 +170,10 @@ class PruningHandler : public concord::reconfiguration::BftReconfigurationHandle
               uint64_t,
               concord::messages::ReconfigurationResponse &) override;
 
+  // Online pruning needs a ticks generator, which is only available once the replica is created. Ticks are started
+  // here for online pruning that was scheduled before that (e.g. on startup).
+  void setTicksGenerator(const std::shared_ptr<cron::TicksGenerator> &);
+
  protected:
   kvbc::BlockId latestBasedOnNumBlocksConfig() const;
   kvbc::BlockId agreedPrunableBlockId(const concord::messages::PruneRequest &) const;
@@ -160,6 +181,14 @@ class PruningHandler : public concord::reconfiguration::BftReconfigurationHandle
   // Prune blocks in the [genesis, block_id] range (both inclusive).
   // Throws on errors.
   void pruneThroughBlockId(kvbc::BlockId block_id) const;
+
+  // Schedule the pruning of the [genesis, block_id] range (both inclusive) in
+  // batches of batch_blocks_num blocks, one batch per tick.
+  void pruneOnlineThroughBlockId(kvbc::BlockId block_id,
+                                 const std::chrono::seconds &tick_period,
+                                 std::uint64_t batch_blocks_num);
+  // Called on every pruning tick.
+  void pruneNextBatch();
   uint64_t getBlockBftSequenceNumber(kvbc::BlockId) const;
   logging::Logger logger_;
   RSAPruningSigner signer_;
@@ -176,6 +205,16 @@ class PruningHandler : public concord::reconfiguration::BftReconfigurationHandle
   mutable std::optional<kvbc::BlockId> last_scheduled_block_for_pruning_;
   mutable std::mutex pruning_status_lock_;
   mutable std::future<void> async_pruning_res_;
+
+  struct OnlinePruning {
+    kvbc::BlockId until{0};
+    std::chrono::seconds tick_period{1};
+    std::uint64_t batch_blocks_num{1};
+  };
+  bool pruning_online_{false};
+  // Set while online pruning is in progress, protected by pruning_status_lock_
+  std::optional<OnlinePruning> online_pruning_;
+  std::shared_ptr<cron::TicksGenerator> ticks_generator_;
 };
 
 /*
@@ -157,11 +157,11 @@ void Replica::registerReconfigurationHandlers(std::shared_ptr<bftEngine::IReques
   requestHandler->setReconfigurationHandler(
       std::make_shared<kvbc::reconfiguration::InternalPostKvReconfigurationHandler>(*this, *this),
       concord::reconfiguration::ReconfigurationHandlerType::POST);
-  auto pruning_handler = std::shared_ptr<kvbc::pruning::PruningHandler>(
-      new concord::kvbc::pruning::PruningHandler(*this, *this, *this, true));
-  requestHandler->setReconfigurationHandler(pruning_handler);
+  pruningHandler_ = std::shared_ptr<kvbc::pruning::PruningHandler>(
+      new concord::kvbc::pruning::PruningHandler(*this, *this, *this, true, cronTableRegistry_));
+  requestHandler->setReconfigurationHandler(pruningHandler_);
   stReconfigurationSM_->registerHandler(m_cmdHandler->getReconfigurationHandler());
-  stReconfigurationSM_->registerHandler(pruning_handler);
+  stReconfigurationSM_->registerHandler(pruningHandler_);
   stReconfigurationSM_->pruneOnStartup();
 }
 uint64_t Replica::getStoredReconfigData(const std::string &kCategory,
@@ -270,6 +270,7 @@ void Replica::createReplicaAndSyncState() {
   m_replicaPtr = bftEngine::IReplica::createNewReplica(
       replicaConfig_, requestHandler, m_stateTransfer, m_ptrComm, m_metadataStorage, pm_, secretsManager_);
   requestHandler->setPersistentStorage(m_replicaPtr->persistentStorage());
+  pruningHandler_->setTicksGenerator(m_replicaPtr->ticksGenerator());
 
   // Make sure that when state transfer completes, we persist the last kvbc block ID in metadata.
   m_stateTransfer->addOnTransferringCompleteCallback([this](std::uint64_t) {
@@ -385,6 +386,13 @@ std::optional<categorization::Updates> Replica::getBlockUpdates(BlockId block_id
   return m_kvBlockchain->getBlockUpdates(block_id);
 }
 
+std::optional<categorization::MultiKeyValueProof> Replica::getMultiProof(const std::string &category_id,
+                                                                         BlockId block_id,
+                                                                         const std::vector<std::string> &keys,
+                                                                         const std::string &tag) const {
+  return m_kvBlockchain->getMultiProof(category_id, block_id, keys, tag);
+}
+
 BlockId Replica::getGenesisBlockId() const {
   if (replicaConfig_.isReadOnly) return m_bcDbAdapter->getGenesisBlockId();
   return m_kvBlockchain->getGenesisBlockId();
@@ -399,6 +407,11 @@ BlockId Replica::getLastBlockId() const {
 
 void Replica::set_command_handler(std::shared_ptr<ICommandsHandler> handler) { m_cmdHandler = handler; }
 
+void Replica::setBlockArchive(const std::shared_ptr<categorization::IBlockArchive> &archive) {
+  if (!m_kvBlockchain) return;
+  m_kvBlockchain->setBlockArchive(archive, replicaConfig_.blockArchiveHorizon);
+}
+
 Replica::Replica(ICommunication *comm,
                  const bftEngine::ReplicaConfig &replicaConfig,
                  std::unique_ptr<IStorageFactory> storageFactory,
@@ -475,6 +488,7 @@ Replica::Replica(ICommunication *comm,
       LOG_ERROR(logger, msg);
       throw std::invalid_argument{msg};
     }
+    // Column family profiles are set by the storage factory when opening the DB.
     m_kvBlockchain.emplace(
         storage::rocksdb::NativeClient::fromIDBClient(m_dbSet.dataDBClient), linkStChain, kvbc_categories);
     m_kvBlockchain->setAggregator(aggregator);
@@ -483,6 +497,11 @@ Replica::Replica(ICommunication *comm,
     concord::diagnostics::StatusHandler handler(
         "pruning", "Pruning Status", [this]() { return m_kvBlockchain->getPruningStatus(); });
     registrar.status.registerHandler(handler);
+    concord::diagnostics::StatusHandler cf_stats_handler(
+        "rocksdb-column-families", "RocksDB Column Family Stats", [this]() {
+          return m_kvBlockchain->getColumnFamilyStats();
+        });
+    registrar.status.registerHandler(cf_stats_handler);
   }
   m_dbSet.dataDBClient->setAggregator(aggregator);
   m_dbSet.metadataDBClient->setAggregator(aggregator);
@@ -626,19 +645,25 @@ bool Replica::getBlock(uint64_t blockId, char *outBlock, uint32_t outBlockMaxSiz
   if (replicaConfig_.isReadOnly) {
     return getBlockFromObjectStore(blockId, outBlock, outBlockMaxSize, outBlockActualSize);
   }
+  const auto copyBlock = [&](const auto &ser) {
+    if (ser.size() > outBlockMaxSize) {
+      LOG_ERROR(logger, KVLOG(ser.size(), outBlockMaxSize));
+      throw std::runtime_error("not enough space to copy block!");
+    }
+    *outBlockActualSize = ser.size();
+    LOG_DEBUG(logger, KVLOG(blockId, *outBlockActualSize));
+    std::memcpy(outBlock, ser.data(), *outBlockActualSize);
+    return true;
+  };
+  // Copy the block straight from the block segment store, if it is there, rather than re-creating it.
+  if (const auto record = m_kvBlockchain->getSerializedRawBlock(blockId)) {
+    return copyBlock(record->data());
+  }
   const auto rawBlock = m_kvBlockchain->getRawBlock(blockId);
   if (!rawBlock) {
     throw NotFoundException{"Raw block not found: " + std::to_string(blockId)};
   }
-  const auto &ser = categorization::RawBlock::serialize(*rawBlock);
-  if (ser.size() > outBlockMaxSize) {
-    LOG_ERROR(logger, KVLOG(ser.size(), outBlockMaxSize));
-    throw std::runtime_error("not enough space to copy block!");
-  }
-  *outBlockActualSize = ser.size();
-  LOG_DEBUG(logger, KVLOG(blockId, *outBlockActualSize));
-  std::memcpy(outBlock, ser.data(), *outBlockActualSize);
-  return true;
+  return copyBlock(categorization::RawBlock::serialize(*rawBlock));
 }
 
 std::future<bool> Replica::getBlockAsync(uint64_t blockId,
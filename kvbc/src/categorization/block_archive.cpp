@@ -0,0 +1,107 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "categorization/block_archive.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include <stdexcept>
+
+namespace concord::kvbc::categorization {
+
+using concordUtils::Sliver;
+
+DBClientBlockArchive::DBClientBlockArchive(const std::shared_ptr<storage::IDBClient>& db,
+                                           const std::string& path_prefix)
+    : db_{db},
+      prefix_{path_prefix.empty() ? std::string{"archived_blocks/"} : path_prefix + "/archived_blocks/"},
+      range_key_{prefix_ + "range"} {
+  auto value = Sliver{};
+  const auto status = db_->get(Sliver{std::string{range_key_}}, value);
+  if (status.isOK()) {
+    auto range = std::istringstream{value.toString()};
+    if (!(range >> first_block_id_ >> last_block_id_) || first_block_id_ > last_block_id_) {
+      throw std::runtime_error{"Invalid archived block range: " + value.toString()};
+    }
+  } else if (!status.isNotFound()) {
+    throw std::runtime_error{"Failed to load the archived block range: " + status.toString()};
+  }
+}
+
+std::string DBClientBlockArchive::blockKey(BlockId block_id) const { return prefix_ + std::to_string(block_id); }
+
+void DBClientBlockArchive::putRange(BlockId first_block_id, BlockId last_block_id) {
+  const auto range = std::to_string(first_block_id) + ' ' + std::to_string(last_block_id);
+  if (const auto status = db_->put(Sliver{std::string{range_key_}}, Sliver{std::string{range}}); !status.isOK()) {
+    throw std::runtime_error{"Failed to update the archived block range: " + status.toString()};
+  }
+  first_block_id_ = first_block_id;
+  last_block_id_ = last_block_id;
+}
+
+void DBClientBlockArchive::put(BlockId block_id, const RawBlock& block) {
+  const auto& ser = RawBlock::serialize(block);
+  auto value = Sliver::copy(reinterpret_cast<const char*>(ser.data()), ser.size());
+  std::lock_guard lock(lock_);
+  if (const auto status = db_->put(Sliver{blockKey(block_id)}, value); !status.isOK()) {
+    throw std::runtime_error{"Failed to archive block " + std::to_string(block_id) + ": " + status.toString()};
+  }
+  // The block is written before the range, so the latter never points to a block that is not archived
+  if (last_block_id_ == 0 || block_id > last_block_id_ + 1) {
+    putRange(block_id, block_id);
+  } else if (block_id == last_block_id_ + 1) {
+    putRange(first_block_id_, block_id);
+  }
+}
+
+std::optional<RawBlock> DBClientBlockArchive::get(BlockId block_id) const {
+  auto value = Sliver{};
+  std::lock_guard lock(lock_);
+  const auto status = db_->get(Sliver{blockKey(block_id)}, value);
+  if (status.isNotFound()) return std::nullopt;
+  if (!status.isOK()) {
+    throw std::runtime_error{"Failed to get archived block " + std::to_string(block_id) + ": " + status.toString()};
+  }
+  return RawBlock::deserialize(value.string_view());
+}
+
+void DBClientBlockArchive::truncate(BlockId last_block_id) {
+  std::lock_guard lock(lock_);
+  if (last_block_id >= last_block_id_) return;
+  const auto [old_first_block_id, old_last_block_id] = std::make_pair(first_block_id_, last_block_id_);
+  // The range is updated before the blocks are deleted, so it never points to a block that is not archived
+  if (last_block_id < first_block_id_) {
+    putRange(0, 0);
+  } else {
+    putRange(first_block_id_, last_block_id);
+  }
+  for (auto block_id = std::max(last_block_id + 1, old_first_block_id); block_id <= old_last_block_id; ++block_id) {
+    if (const auto status = db_->del(Sliver{blockKey(block_id)}); !status.isOK()) {
+      throw std::runtime_error{"Failed to delete archived block " + std::to_string(block_id) + ": " +
+                               status.toString()};
+    }
+  }
+}
+
+BlockId DBClientBlockArchive::firstBlockId() const {
+  std::lock_guard lock(lock_);
+  return first_block_id_;
+}
+
+BlockId DBClientBlockArchive::lastBlockId() const {
+  std::lock_guard lock(lock_);
+  return last_block_id_;
+}
+
+}  // namespace concord::kvbc::categorization
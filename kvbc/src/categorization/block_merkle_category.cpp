@@ -311,7 +311,9 @@ void addStaleKeysToDeleteBatch(const ::rocksdb::PinnableSlice& slice, uint64_t t
   batch.del(BLOCK_MERKLE_STALE_CF, serialize(TreeVersion{tree_version}));
 }
 
-BlockMerkleCategory::BlockMerkleCategory(const std::shared_ptr<storage::rocksdb::NativeClient>& db) : db_{db} {
+BlockMerkleCategory::BlockMerkleCategory(const std::shared_ptr<storage::rocksdb::NativeClient>& db,
+                                         std::size_t internal_nodes_cache_size)
+    : db_{db} {
   createColumnFamilyIfNotExisting(BLOCK_MERKLE_INTERNAL_NODES_CF, *db);
   createColumnFamilyIfNotExisting(BLOCK_MERKLE_LEAF_NODES_CF, *db);
   createColumnFamilyIfNotExisting(BLOCK_MERKLE_LATEST_KEY_VERSION_CF, *db);
@@ -319,7 +321,8 @@ BlockMerkleCategory::BlockMerkleCategory(const std::shared_ptr<storage::rocksdb:
   createColumnFamilyIfNotExisting(BLOCK_MERKLE_STALE_CF, *db);
   createColumnFamilyIfNotExisting(BLOCK_MERKLE_ACTIVE_KEYS_FROM_PRUNED_BLOCKS_CF, *db);
   createColumnFamilyIfNotExisting(BLOCK_MERKLE_PRUNED_BLOCKS_CF, *db);
-  tree_ = sparse_merkle::Tree{std::make_shared<Reader>(*db_)};
+  reader_ = std::make_shared<Reader>(*db_, internal_nodes_cache_size);
+  tree_ = sparse_merkle::Tree{reader_};
 }
 
 BlockMerkleOutput BlockMerkleCategory::add(BlockId block_id, BlockMerkleInput&& updates, NativeWriteBatch& batch) {
@@ -327,6 +330,7 @@ BlockMerkleOutput BlockMerkleCategory::add(BlockId block_id, BlockMerkleInput&&
   putKeys(batch, block_id, std::move(hashed_added_keys), std::move(hashed_deleted_keys), updates);
 
   auto tree_update_batch = tree_.update({{merkleKey(block_id), merkleValue(merkle_value)}});
+  reader_->stageInternalNodes(tree_update_batch);
   putMerkleNodes(batch, std::move(tree_update_batch));
 
   auto output = inputToOutput(updates);
@@ -591,6 +595,7 @@ size_t BlockMerkleCategory::deleteGenesisBlock(BlockId block_id,
     block_adds.emplace(merkleKey(block_id), merkle_value);
   }
   auto update_batch = tree_.update(block_adds, block_removes);
+  reader_->stageInternalNodes(update_batch);
   putMerkleNodes(batch, std::move(update_batch));
   deleteStaleData(out.state_root_version, batch);
   return num_of_deletes;
@@ -629,6 +634,8 @@ void BlockMerkleCategory::deleteLastReachableBlock(BlockId block_id,
     batch.del(BLOCK_MERKLE_KEYS_CF, versioned_key);
   }
   removeMerkleNodes(batch, block_id, out.state_root_version);
+  // The removed tree version will be rewritten by the next block.
+  reader_->invalidateCache();
 }
 
 std::pair<std::vector<Hash>, std::vector<std::optional<TaggedVersion>>> BlockMerkleCategory::getLatestVersions(
@@ -756,9 +763,16 @@ uint64_t BlockMerkleCategory::getLatestTreeVersion() const {
 }
 
 sparse_merkle::BatchedInternalNode BlockMerkleCategory::Reader::get_latest_root() const {
+  if (cache_ && cache_->latest_root) {
+    return *cache_->latest_root;
+  }
   if (auto latest_root_key = db_.get(BLOCK_MERKLE_INTERNAL_NODES_CF, rootKey(0))) {
     if (auto serialized = db_.get(BLOCK_MERKLE_INTERNAL_NODES_CF, *latest_root_key)) {
-      return deserializeBatchedInternalNode(*serialized);
+      auto root = deserializeBatchedInternalNode(*serialized);
+      if (cache_) {
+        cache_->latest_root = root;
+      }
+      return root;
     }
     // TODO: LOG THIS
     // The merkle tree should never ask for a version that doesn't exist.
@@ -769,13 +783,56 @@ sparse_merkle::BatchedInternalNode BlockMerkleCategory::Reader::get_latest_root(
 
 sparse_merkle::BatchedInternalNode BlockMerkleCategory::Reader::get_internal(
     const sparse_merkle::InternalNodeKey& key) const {
+  if (cache_) {
+    if (auto node = cache_->nodes.get(key)) {
+      return std::move(*node);
+    }
+  }
   auto ser_key = serialize(toBatchedInternalNodeKey(key));
   if (auto serialized = db_.get(BLOCK_MERKLE_INTERNAL_NODES_CF, ser_key)) {
-    return deserializeBatchedInternalNode(*serialized);
+    auto node = deserializeBatchedInternalNode(*serialized);
+    if (cache_) {
+      cache_->nodes.put(key, node);
+    }
+    return node;
   }
   // TODO: LOG THIS
   // The merkle tree should never ask for a version that doesn't exist.
   std::terminate();
 }
 
+void BlockMerkleCategory::Reader::stageInternalNodes(const sparse_merkle::UpdateBatch& update_batch) {
+  if (!cache_) {
+    return;
+  }
+  // The latest root is always part of the update. If it is not, it is read from the DB once the update is cached.
+  const auto tree_version = update_batch.stale.stale_since_version;
+  auto& staged = cache_->staged.emplace();
+  staged.nodes = update_batch.internal_nodes;
+  for (const auto& [internal_key, internal_node] : update_batch.internal_nodes) {
+    if (internal_key.version() == tree_version && internal_key.path().empty()) {
+      staged.latest_root = internal_node;
+    }
+  }
+}
+
+void BlockMerkleCategory::Reader::cacheStagedNodes() {
+  if (!cache_ || !cache_->staged) {
+    return;
+  }
+  for (const auto& [internal_key, internal_node] : cache_->staged->nodes) {
+    cache_->nodes.put(internal_key, internal_node);
+  }
+  cache_->latest_root = std::move(cache_->staged->latest_root);
+  cache_->staged.reset();
+}
+
+void BlockMerkleCategory::Reader::invalidateCache() {
+  if (cache_) {
+    cache_->nodes.clear();
+    cache_->latest_root.reset();
+    cache_->staged.reset();
+  }
+}
+
 }  // namespace concord::kvbc::categorization::detail
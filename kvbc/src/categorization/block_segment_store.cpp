@@ -0,0 +1,258 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "categorization/block_segment_store.h"
+
+#include "assertUtils.hpp"
+#include "categorization/column_families.h"
+#include "categorization/details.h"
+#include "Logger.hpp"
+
+#include <boost/crc.hpp>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace concord::kvbc::categorization::detail {
+
+namespace {
+
+// A record is a header followed by the data, padded to kRecordAlignment. The end of the records in a segment is
+// marked by an all-zero header, which is also what the unwritten (sparse) part of a segment reads as.
+struct RecordHeader {
+  std::uint64_t block_id;
+  std::uint32_t size;
+  std::uint32_t crc;
+};
+
+constexpr auto kRecordAlignment = std::uint64_t{8};
+constexpr auto kEndMarker = RecordHeader{0, 0, 0};
+const auto kSegmentFilePrefix = std::string{"segment_"};
+
+std::uint64_t recordSize(std::uint64_t data_size) {
+  const auto size = sizeof(RecordHeader) + data_size;
+  return (size + kRecordAlignment - 1) / kRecordAlignment * kRecordAlignment;
+}
+
+std::uint32_t crc32(std::string_view data) {
+  auto crc = boost::crc_32_type{};
+  crc.process_bytes(data.data(), data.size());
+  return crc.checksum();
+}
+
+[[noreturn]] void throwSystemError(const std::string& msg, const std::string& path) {
+  throw std::runtime_error{msg + " " + path + ": " + std::strerror(errno)};
+}
+
+}  // namespace
+
+struct BlockSegmentStore::Segment {
+  Segment(std::uint64_t id, const std::string& path, int fd, std::uint64_t size)
+      : id{id}, path{path}, fd{fd}, size{size} {
+    auto addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+      ::close(fd);
+      throwSystemError("Failed to map segment", path);
+    }
+    data = static_cast<const char*>(addr);
+  }
+
+  ~Segment() {
+    ::munmap(const_cast<char*>(data), size);
+    ::close(fd);
+  }
+
+  const RecordHeader& headerAt(std::uint64_t offset) const {
+    return *reinterpret_cast<const RecordHeader*>(data + offset);
+  }
+
+  const std::uint64_t id;
+  const std::string path;
+  const int fd;
+  const std::uint64_t size;
+  const char* data{nullptr};
+
+  // Only accessed by the writer.
+  std::uint64_t end{0};
+  BlockId max_block_id{0};
+};
+
+BlockSegmentStore::BlockSegmentStore(const std::shared_ptr<storage::rocksdb::NativeClient>& native_client,
+                                     const std::string& path,
+                                     std::uint64_t segment_size)
+    : native_client_{native_client}, path_{path}, segment_size_{segment_size} {
+  ConcordAssertGT(segment_size_, 0);
+  if (createColumnFamilyIfNotExisting(BLOCK_SEGMENTS_CF, *native_client_)) {
+    LOG_INFO(CAT_BLOCK_LOG, "Created [" << BLOCK_SEGMENTS_CF << "] column family for the block segment store");
+  }
+  if (::mkdir(path_.c_str(), 0755) != 0 && errno != EEXIST) {
+    throwSystemError("Failed to create the block segments directory", path_);
+  }
+
+  auto dir = ::opendir(path_.c_str());
+  if (!dir) throwSystemError("Failed to open the block segments directory", path_);
+  auto ids = std::vector<std::uint64_t>{};
+  while (auto entry = ::readdir(dir)) {
+    const auto name = std::string{entry->d_name};
+    if (name.rfind(kSegmentFilePrefix, 0) == 0) {
+      ids.push_back(std::stoull(name.substr(kSegmentFilePrefix.size())));
+    }
+  }
+  ::closedir(dir);
+  std::sort(ids.begin(), ids.end());
+
+  for (auto i = 0u; i < ids.size(); ++i) {
+    segments_[ids[i]] = openSegment(ids[i], i == ids.size() - 1);
+  }
+  if (!segments_.empty()) active_segment_ = segments_.rbegin()->second;
+  LOG_INFO(CAT_BLOCK_LOG, "Opened block segment store" << KVLOG(path_, segment_size_, segments_.size()));
+}
+
+std::string BlockSegmentStore::segmentPath(std::uint64_t id) const {
+  return path_ + "/" + kSegmentFilePrefix + std::to_string(id);
+}
+
+std::shared_ptr<BlockSegmentStore::Segment> BlockSegmentStore::createSegment(std::uint64_t id, std::uint64_t size) {
+  const auto path = segmentPath(id);
+  const auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+  if (fd < 0) throwSystemError("Failed to create segment", path);
+  if (::ftruncate(fd, size) != 0) {
+    ::close(fd);
+    throwSystemError("Failed to size segment", path);
+  }
+  return std::make_shared<Segment>(id, path, fd, size);
+}
+
+std::shared_ptr<BlockSegmentStore::Segment> BlockSegmentStore::openSegment(std::uint64_t id, bool is_last) {
+  const auto path = segmentPath(id);
+  const auto fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+  if (fd < 0) throwSystemError("Failed to open segment", path);
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throwSystemError("Failed to stat segment", path);
+  }
+  // A crash right after the segment has been created leaves an empty file.
+  if (st.st_size == 0) {
+    if (::ftruncate(fd, segment_size_) != 0) {
+      ::close(fd);
+      throwSystemError("Failed to size segment", path);
+    }
+    st.st_size = segment_size_;
+  }
+  auto segment = std::make_shared<Segment>(id, path, fd, static_cast<std::uint64_t>(st.st_size));
+
+  // Find the end of the records. Only the last segment can end with a partially written record (e.g. after a crash),
+  // so checksums are verified there only and the next append overwrites the partial record.
+  auto offset = std::uint64_t{0};
+  while (offset + sizeof(RecordHeader) <= segment->size) {
+    const auto& header = segment->headerAt(offset);
+    if (header.block_id == 0) break;
+    const auto size = recordSize(header.size);
+    if (offset + size > segment->size) break;
+    if (is_last && crc32({segment->data + offset + sizeof(RecordHeader), header.size}) != header.crc) {
+      LOG_WARN(CAT_BLOCK_LOG, "Partially written record at the end of segment" << KVLOG(path, offset));
+      break;
+    }
+    segment->max_block_id = std::max(segment->max_block_id, header.block_id);
+    offset += size;
+  }
+  segment->end = offset;
+  return segment;
+}
+
+void BlockSegmentStore::append(BlockId block_id, std::string_view data, storage::rocksdb::NativeWriteBatch& batch) {
+  ConcordAssertGT(block_id, 0);
+  const auto size = recordSize(data.size());
+  // Leave room for the end marker after the record.
+  if (!active_segment_ || active_segment_->end + size + sizeof(RecordHeader) > active_segment_->size) {
+    const auto id = active_segment_ ? active_segment_->id + 1 : 1;
+    if (active_segment_ && ::fdatasync(active_segment_->fd) != 0) {
+      throwSystemError("Failed to sync segment", active_segment_->path);
+    }
+    auto segment = createSegment(id, std::max(segment_size_, size + sizeof(RecordHeader)));
+    std::lock_guard lock(segments_lock_);
+    segments_[id] = segment;
+    active_segment_ = segment;
+  }
+
+  auto& segment = *active_segment_;
+  const auto header = RecordHeader{block_id, static_cast<std::uint32_t>(data.size()), crc32(data)};
+  static const char padding[kRecordAlignment] = {};
+  iovec iov[] = {{const_cast<RecordHeader*>(&header), sizeof(header)},
+                 {const_cast<char*>(data.data()), data.size()},
+                 {const_cast<char*>(padding), size - sizeof(header) - data.size()},
+                 {const_cast<RecordHeader*>(&kEndMarker), sizeof(kEndMarker)}};
+  const auto to_write = static_cast<ssize_t>(size + sizeof(kEndMarker));
+  if (::pwritev(segment.fd, iov, sizeof(iov) / sizeof(iov[0]), segment.end) != to_write) {
+    throwSystemError("Failed to append to segment", segment.path);
+  }
+
+  batch.put(BLOCK_SEGMENTS_CF,
+            serialize(BlockKey{block_id}),
+            serialize(BlockSegmentLocation{segment.id, segment.end, static_cast<std::uint32_t>(data.size())}));
+  segment.end += size;
+  segment.max_block_id = std::max(segment.max_block_id, block_id);
+}
+
+void BlockSegmentStore::erase(BlockId block_id, storage::rocksdb::NativeWriteBatch& batch) {
+  batch.del(BLOCK_SEGMENTS_CF, serialize(BlockKey{block_id}));
+}
+
+void BlockSegmentStore::removeSegmentsBefore(BlockId block_id) {
+  std::lock_guard lock(segments_lock_);
+  for (auto it = segments_.begin(); it != segments_.end();) {
+    const auto& segment = *it->second;
+    if (it->second == active_segment_ || segment.max_block_id >= block_id) break;
+    // Records that are being read keep the segment mapped.
+    if (::unlink(segment.path.c_str()) != 0) throwSystemError("Failed to remove segment", segment.path);
+    LOG_INFO(CAT_BLOCK_LOG, "Removed segment" << KVLOG(segment.path, segment.max_block_id));
+    it = segments_.erase(it);
+  }
+}
+
+std::optional<BlockSegmentStore::Record> BlockSegmentStore::get(BlockId block_id) const {
+  const auto location_ser = native_client_->get(BLOCK_SEGMENTS_CF, serialize(BlockKey{block_id}));
+  if (!location_ser) return std::nullopt;
+  auto location = BlockSegmentLocation{};
+  deserialize(*location_ser, location);
+
+  auto segment = std::shared_ptr<const Segment>{};
+  {
+    std::lock_guard lock(segments_lock_);
+    if (auto it = segments_.find(location.segment); it != segments_.cend()) segment = it->second;
+  }
+  const auto msg = "Invalid record of block " + std::to_string(block_id) + " in segment " +
+                   std::to_string(location.segment) + " at offset " + std::to_string(location.offset);
+  if (!segment || location.offset + recordSize(location.size) > segment->size) {
+    throw std::runtime_error{msg};
+  }
+  const auto& header = segment->headerAt(location.offset);
+  const auto data = std::string_view{segment->data + location.offset + sizeof(RecordHeader), location.size};
+  if (header.block_id != block_id || header.size != location.size || header.crc != crc32(data)) {
+    throw std::runtime_error{msg};
+  }
+  return Record{segment, data};
+}
+
+}  // namespace concord::kvbc::categorization::detail
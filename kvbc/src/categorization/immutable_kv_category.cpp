@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <map>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -291,4 +292,44 @@ std::optional<KeyValueProof> ImmutableKeyValueCategory::getProof(const std::stri
 
   return proof;
 }
+
+std::optional<MultiKeyValueProof> ImmutableKeyValueCategory::getMultiProof(const std::string &tag,
+                                                                           const std::vector<std::string> &keys,
+                                                                           const ImmutableOutput &updates_info) const {
+  if (keys.empty() || !updates_info.tag_root_hashes ||
+      updates_info.tag_root_hashes->find(tag) == updates_info.tag_root_hashes->cend()) {
+    return std::nullopt;
+  }
+
+  // Only keys tagged with `tag` are part of its root hash, in key order.
+  auto tag_keys = std::vector<std::string>{};
+  for (const auto &[key, key_tags] : updates_info.tagged_keys) {
+    if (std::find(key_tags.cbegin(), key_tags.cend(), tag) != key_tags.cend()) {
+      tag_keys.push_back(key);
+    }
+  }
+  const auto proven_keys = std::set<std::string>{keys.cbegin(), keys.cend()};
+  if (!std::includes(tag_keys.cbegin(), tag_keys.cend(), proven_keys.cbegin(), proven_keys.cend())) {
+    return std::nullopt;
+  }
+
+  // Read all values in the tag at once instead of once per proven key.
+  auto values = std::vector<std::optional<Value>>{};
+  multiGetLatest(tag_keys, values);
+
+  auto proof = MultiKeyValueProof{};
+  for (auto i = 0ul; i < tag_keys.size(); ++i) {
+    ConcordAssert(values[i].has_value());
+    auto &value = asImmutable(values[i]);
+    proof.block_id = value.block_id;
+    if (proven_keys.find(tag_keys[i]) != proven_keys.cend()) {
+      proof.key_value_indexes.push_back(proof.ordered_complement_kv_hashes.size());
+      proof.key_values.emplace_back(std::move(tag_keys[i]), std::move(value.data));
+    } else {
+      proof.ordered_complement_kv_hashes.push_back(hash(tag_keys[i]));
+      proof.ordered_complement_kv_hashes.push_back(hash(value.data));
+    }
+  }
+  return proof;
+}
 }  // namespace concord::kvbc::categorization::detail
@@ -18,7 +18,13 @@
 #include "diagnostics.h"
 #include "performance_handler.h"
 
+#include <rocksdb/statistics.h>
+
+#include <array>
+#include <chrono>
+#include <deque>
 #include <stdexcept>
+#include <type_traits>
 
 namespace concord::kvbc::categorization {
 
@@ -47,7 +53,14 @@ KeyValueBlockchain::KeyValueBlockchain(const std::shared_ptr<concord::storage::r
           concordMetrics::Component("kv_blockchain_adds", std::make_shared<concordMetrics::Aggregator>())},
       versioned_num_of_keys_{add_metrics_comp_.RegisterCounter("numOfVersionedKeys")},
       immutable_num_of_keys_{add_metrics_comp_.RegisterCounter("numOfImmutableKeys")},
-      merkle_num_of_keys_{add_metrics_comp_.RegisterCounter("numOfMerkleKeys")} {
+      merkle_num_of_keys_{add_metrics_comp_.RegisterCounter("numOfMerkleKeys")},
+      latest_values_cache_metrics_comp_{concordMetrics::Component("kv_blockchain_latest_values_cache",
+                                                                  std::make_shared<concordMetrics::Aggregator>())},
+      latest_values_cache_hits_{latest_values_cache_metrics_comp_.RegisterCounter("hits")},
+      latest_values_cache_misses_{latest_values_cache_metrics_comp_.RegisterCounter("misses")} {
+  if (const auto cache_size = bftEngine::ReplicaConfig::instance().kvbcLatestValuesCacheSize; cache_size > 0) {
+    latest_values_cache_ = std::make_unique<LatestValuesCache>(cache_size);
+  }
   if (detail::createColumnFamilyIfNotExisting(detail::CAT_ID_TYPE_CF, *native_client_.get())) {
     LOG_INFO(CAT_BLOCK_LOG, "Created [" << detail::CAT_ID_TYPE_CF << "] column family for the category types");
   }
@@ -59,6 +72,16 @@ KeyValueBlockchain::KeyValueBlockchain(const std::shared_ptr<concord::storage::r
     initExistingBlockchainCategories(category_types);
   }
 
+  const auto& config = bftEngine::ReplicaConfig::instance();
+  if (!config.kvbcBlockSegmentsPath.empty()) {
+    block_segments_.emplace(native_client_, config.kvbcBlockSegmentsPath, config.kvbcBlockSegmentSize);
+    // Segments of pruned blocks might not have been removed before a restart.
+    block_segments_->removeSegmentsBefore(getGenesisBlockId());
+  }
+  if (!config.kvbcUpdatesRecordingPath.empty()) {
+    updates_recorder_.emplace(config.kvbcUpdatesRecordingPath, category_types_);
+  }
+
   if (!link_st_chain) return;
   // Make sure that if linkSTChainFrom() has been interrupted (e.g. a crash or an abnormal shutdown), all DBAdapter
   // methods will return the correct values. For example, if state transfer had completed and linkSTChainFrom() was
@@ -68,6 +91,18 @@ KeyValueBlockchain::KeyValueBlockchain(const std::shared_ptr<concord::storage::r
   linkSTChainFrom(getLastReachableBlockId() + 1);
   delete_metrics_comp_.Register();
   add_metrics_comp_.Register();
+  latest_values_cache_metrics_comp_.Register();
+}
+
+KeyValueBlockchain::~KeyValueBlockchain() {
+  if (block_archiver_.joinable()) {
+    {
+      std::lock_guard lock(block_archiver_stop_lock_);
+      stop_block_archiver_ = true;
+    }
+    block_archiver_stop_cv_.notify_one();
+    block_archiver_.join();
+  }
 }
 
 void KeyValueBlockchain::initNewBlockchainCategories(
@@ -114,6 +149,7 @@ void KeyValueBlockchain::initExistingBlockchainCategories(
 }
 
 void KeyValueBlockchain::loadCategories() {
+  const auto merkle_cache_size = bftEngine::ReplicaConfig::instance().kvbcBlockMerkleInternalNodesCacheSize;
   auto itr = native_client_->getIterator(detail::CAT_ID_TYPE_CF);
   itr.first();
   while (itr) {
@@ -124,7 +160,7 @@ void KeyValueBlockchain::loadCategories() {
     auto cat_type = static_cast<CATEGORY_TYPE>(itr.valueView()[0]);
     switch (cat_type) {
       case CATEGORY_TYPE::block_merkle:
-        categories_.emplace(itr.key(), detail::BlockMerkleCategory{native_client_});
+        categories_.emplace(itr.key(), detail::BlockMerkleCategory{native_client_, merkle_cache_size});
         category_types_[itr.key()] = CATEGORY_TYPE::block_merkle;
         LOG_INFO(CAT_BLOCK_LOG, "Created category [" << itr.key() << "] as type BlockMerkleCategory");
         break;
@@ -157,9 +193,26 @@ BlockId KeyValueBlockchain::addBlock(Updates&& updates) {
   auto block_id = addBlock(std::move(updates.category_updates_), write_batch);
   native_client_->write(std::move(write_batch));
   block_chain_.setAddedBlockId(block_id);
+  for (const auto& [category_id, _] : last_raw_block_.second->updates.kv) {
+    (void)_;
+    cacheMerkleInternalNodes(category_id);
+  }
+  updateLatestValuesCache(block_id, last_raw_block_.second->updates);
+  recordUpdates(block_id, last_raw_block_.second->updates);
   return block_id;
 }
 
+void KeyValueBlockchain::recordUpdates(BlockId block_id, const CategoryInput& updates) {
+  if (!updates_recorder_) return;
+  // The block is already committed, so a failure to record it must not fail adding it.
+  try {
+    updates_recorder_->record(updates);
+  } catch (const std::exception& e) {
+    LOG_ERROR(CAT_BLOCK_LOG, "Stopped recording the blockchain updates, reason: " << e.what() << KVLOG(block_id));
+    updates_recorder_.reset();
+  }
+}
+
 BlockId KeyValueBlockchain::addBlock(CategoryInput&& category_updates,
                                      concord::storage::rocksdb::NativeWriteBatch& write_batch) {
   // Use new client batch and column families
@@ -185,7 +238,14 @@ BlockId KeyValueBlockchain::addBlock(CategoryInput&& category_updates,
   block_chain_.addBlock(new_block, write_batch);
   LOG_DEBUG(CAT_BLOCK_LOG, "Writing block [" << new_block.id() << "] to the blocks cf");
   write_batch.put(detail::BLOCKS_CF, Block::generateKey(new_block.id()), Block::serialize(new_block));
+  if (block_segments_) {
+    const auto& raw_block_ser = detail::serializeThreadLocal(last_raw_block);
+    block_segments_->append(new_block.id(),
+                            {reinterpret_cast<const char*>(raw_block_ser.data()), raw_block_ser.size()},
+                            write_batch);
+  }
   add_metrics_comp_.UpdateAggregator();
+  latest_values_cache_metrics_comp_.UpdateAggregator();
   return new_block.id();
 }
 
@@ -278,8 +338,25 @@ std::optional<Value> KeyValueBlockchain::getLatest(const std::string& category_i
   if (!category) {
     return std::nullopt;
   }
+  const auto cached = isLatestValueCached(category_id);
+  auto generation = std::uint64_t{0};
+  if (cached) {
+    std::lock_guard lock(latest_values_cache_->lock);
+    if (auto value = latest_values_cache_->values.get(LatestValueKey{category_id, key})) {
+      latest_values_cache_hits_++;
+      return std::move(*value);
+    }
+    latest_values_cache_misses_++;
+    generation = latest_values_cache_->generation;
+  }
   std::optional<Value> ret;
   std::visit([&key, &ret](const auto& category) { ret = category.getLatest(key); }, *category);
+  if (cached) {
+    std::lock_guard lock(latest_values_cache_->lock);
+    if (generation == latest_values_cache_->generation) {
+      latest_values_cache_->values.put(LatestValueKey{category_id, key}, ret);
+    }
+  }
   return ret;
 }
 
@@ -306,7 +383,114 @@ void KeyValueBlockchain::multiGetLatest(const std::string& category_id,
     nullopts(values, keys.size());
     return;
   }
-  std::visit([&keys, &values](const auto& category) { category.multiGetLatest(keys, values); }, *category);
+  if (!isLatestValueCached(category_id)) {
+    std::visit([&keys, &values](const auto& category) { category.multiGetLatest(keys, values); }, *category);
+    return;
+  }
+
+  // Serve what we can from the cache and read the rest from storage
+  auto missed_keys = std::vector<std::string>{};
+  auto missed_indexes = std::vector<std::size_t>{};
+  auto generation = std::uint64_t{0};
+  values.clear();
+  values.reserve(keys.size());
+  {
+    std::lock_guard lock(latest_values_cache_->lock);
+    for (auto i = 0ull; i < keys.size(); ++i) {
+      if (auto value = latest_values_cache_->values.get(LatestValueKey{category_id, keys[i]})) {
+        latest_values_cache_hits_++;
+        values.push_back(std::move(*value));
+      } else {
+        latest_values_cache_misses_++;
+        values.emplace_back();
+        missed_keys.push_back(keys[i]);
+        missed_indexes.push_back(i);
+      }
+    }
+    generation = latest_values_cache_->generation;
+  }
+  if (missed_keys.empty()) return;
+
+  auto missed_values = std::vector<std::optional<Value>>{};
+  std::visit([&missed_keys, &missed_values](
+                 const auto& category) { category.multiGetLatest(missed_keys, missed_values); },
+             *category);
+  std::lock_guard lock(latest_values_cache_->lock);
+  const auto put = (generation == latest_values_cache_->generation);
+  for (auto i = 0ull; i < missed_values.size(); ++i) {
+    if (put) latest_values_cache_->values.put(LatestValueKey{category_id, missed_keys[i]}, missed_values[i]);
+    values[missed_indexes[i]] = std::move(missed_values[i]);
+  }
+}
+
+/////////////////////// Latest values cache ///////////////////////
+
+bool KeyValueBlockchain::isLatestValueCached(const std::string& category_id) const {
+  if (!latest_values_cache_) return false;
+  auto it = category_types_.find(category_id);
+  return it != category_types_.cend() &&
+         (it->second == CATEGORY_TYPE::versioned_kv || it->second == CATEGORY_TYPE::block_merkle);
+}
+
+void KeyValueBlockchain::cacheMerkleInternalNodes(const std::string& category_id) {
+  if (auto merkle = std::get_if<detail::BlockMerkleCategory>(getCategoryPtr(category_id))) {
+    merkle->onBatchWritten();
+  }
+}
+
+void KeyValueBlockchain::updateLatestValuesCache(BlockId block_id, const CategoryInput& updates) {
+  if (!latest_values_cache_) return;
+  std::lock_guard lock(latest_values_cache_->lock);
+  auto& values = latest_values_cache_->values;
+  latest_values_cache_->generation++;
+  for (const auto& [category_id, category_updates] : updates.kv) {
+    if (!isLatestValueCached(category_id)) continue;
+    std::visit(
+        [&, category_id = category_id](const auto& category_updates) {
+          using T = std::decay_t<decltype(category_updates)>;
+          if constexpr (std::is_same_v<T, VersionedInput>) {
+            // Same order as VersionedKeyValueCategory::add(), i.e. updates win over deletes of the same key
+            for (const auto& key : category_updates.deletes) {
+              values.put(LatestValueKey{category_id, key}, std::nullopt);
+            }
+            for (const auto& [key, value] : category_updates.kv) {
+              values.put(LatestValueKey{category_id, key}, VersionedValue{{block_id, value.data}});
+            }
+          } else if constexpr (std::is_same_v<T, BlockMerkleInput>) {
+            for (const auto& [key, value] : category_updates.kv) {
+              values.put(LatestValueKey{category_id, key}, MerkleValue{{block_id, value}});
+            }
+            for (const auto& key : category_updates.deletes) {
+              // Don't guess the outcome of updating and deleting the same key in a block
+              if (category_updates.kv.count(key)) {
+                values.erase(LatestValueKey{category_id, key});
+              } else {
+                values.put(LatestValueKey{category_id, key}, std::nullopt);
+              }
+            }
+          }
+        },
+        category_updates);
+  }
+}
+
+void KeyValueBlockchain::invalidateLatestValuesCache(const BlockData& block_data) {
+  if (!latest_values_cache_) return;
+  std::lock_guard lock(latest_values_cache_->lock);
+  latest_values_cache_->generation++;
+  for (const auto& [category_id, update_info] : block_data.categories_updates_info) {
+    if (!isLatestValueCached(category_id)) continue;
+    std::visit(
+        [this, category_id = category_id](const auto& update_info) {
+          using T = std::decay_t<decltype(update_info)>;
+          if constexpr (std::is_same_v<T, VersionedOutput> || std::is_same_v<T, BlockMerkleOutput>) {
+            for (const auto& key_flags : update_info.keys) {
+              latest_values_cache_->values.erase(LatestValueKey{category_id, key_flags.first});
+            }
+          }
+        },
+        update_info);
+  }
 }
 
 std::optional<categorization::TaggedVersion> KeyValueBlockchain::getLatestVersion(const std::string& category_id,
@@ -340,6 +524,31 @@ std::optional<Updates> KeyValueBlockchain::getBlockUpdates(BlockId block_id) con
   return Updates{std::move(raw->data.updates)};
 }
 
+std::optional<MultiKeyValueProof> KeyValueBlockchain::getMultiProof(const std::string& category_id,
+                                                                    BlockId block_id,
+                                                                    const std::vector<std::string>& keys,
+                                                                    const std::string& tag) const {
+  const auto category = getCategoryPtr(category_id);
+  if (!category) {
+    return std::nullopt;
+  }
+  const auto block = block_chain_.getBlock(block_id);
+  if (!block) {
+    return std::nullopt;
+  }
+  const auto updates_info = block->data.categories_updates_info.find(category_id);
+  if (updates_info == block->data.categories_updates_info.cend()) {
+    return std::nullopt;
+  }
+
+  if (const auto versioned = std::get_if<detail::VersionedKeyValueCategory>(category)) {
+    return versioned->getMultiProof(block_id, keys, std::get<VersionedOutput>(updates_info->second));
+  } else if (const auto immutable = std::get_if<detail::ImmutableKeyValueCategory>(category)) {
+    return immutable->getMultiProof(tag, keys, std::get<ImmutableOutput>(updates_info->second));
+  }
+  return std::nullopt;
+}
+
 std::map<std::string, std::vector<std::string>> KeyValueBlockchain::getBlockStaleKeys(BlockId block_id) const {
   // Get block node from storage
   auto block = block_chain_.getBlock(block_id);
@@ -434,12 +643,21 @@ void KeyValueBlockchain::deleteStateTransferBlock(const BlockId block_id) {
 // 3 - perform the delete
 // 4 - increment the genesis block id.
 void KeyValueBlockchain::deleteGenesisBlock() {
+  std::lock_guard archive_lock(block_archive_lock_);
   // We assume there are blocks in the system.
   auto genesis_id = block_chain_.getGenesisBlockId();
   ConcordAssertGE(genesis_id, INITIAL_GENESIS_BLOCK_ID);
   // And we assume this is not the only block in the blockchain. That excludes ST temporary blocks as they are not yet
   // part of the blockchain.
   ConcordAssertNE(genesis_id, block_chain_.getLastReachableBlockId());
+
+  // Make sure the block is archived before it is gone. The background archiver has normally done that already, so
+  // this only uploads when pruning gets closer than the horizon to the last block or the archiver falls behind.
+  if (block_archive_ && block_archive_->lastBlockId() < genesis_id) {
+    auto raw_block = block_chain_.getRawBlock(genesis_id, categories_);
+    ConcordAssert(raw_block.has_value());
+    block_archive_->put(genesis_id, *raw_block);
+  }
   auto write_batch = native_client_->getBatch();
 
   // Get block node from storage
@@ -450,6 +668,7 @@ void KeyValueBlockchain::deleteGenesisBlock() {
   }
 
   block_chain_.deleteBlock(genesis_id, write_batch);
+  if (block_segments_) block_segments_->erase(genesis_id, write_batch);
 
   // Iterate over groups and call corresponding deleteGenesisBlock,
   // Each group is responsible to fill its deltetes to the batch
@@ -460,8 +679,14 @@ void KeyValueBlockchain::deleteGenesisBlock() {
   }
 
   native_client_->write(std::move(write_batch));
+  for (const auto& [category_id, _] : block->data.categories_updates_info) {
+    (void)_;
+    cacheMerkleInternalNodes(category_id);
+  }
+  invalidateLatestValuesCache(block->data);
   // Increment the genesis block ID cache.
   block_chain_.setGenesisBlockId(genesis_id + 1);
+  if (block_segments_) block_segments_->removeSegmentsBefore(genesis_id + 1);
 }
 
 // 1 - Get last id block from DB.
@@ -477,6 +702,11 @@ void KeyValueBlockchain::deleteLastReachableBlock() {
     throw std::logic_error{"Cannot delete only block as a last reachable one"};
   }
 
+  std::lock_guard archive_lock(block_archive_lock_);
+  // The block might be replaced by a different one, so it must not be served from the archive once it is pruned.
+  if (block_archive_ && block_archive_->lastBlockId() >= last_id) {
+    block_archive_->truncate(last_id - 1);
+  }
   auto write_batch = native_client_->getBatch();
   // Get block node from storage
   auto block = block_chain_.getBlock(last_id);
@@ -486,6 +716,7 @@ void KeyValueBlockchain::deleteLastReachableBlock() {
   }
 
   block_chain_.deleteBlock(last_id, write_batch);
+  if (block_segments_) block_segments_->erase(last_id, write_batch);
 
   // Iterate over groups and call corresponding deleteLastReachableBlock,
   // Each group is responsible to put its deletes into the batch
@@ -498,6 +729,7 @@ void KeyValueBlockchain::deleteLastReachableBlock() {
   }
 
   native_client_->write(std::move(write_batch));
+  invalidateLatestValuesCache(block->data);
 
   // Since we allow deletion of the only block left as last reachable (due to replica state sync), set both genesis and
   // last reachable cache variables to 0. Otherise, only decrement the last reachable block ID cache.
@@ -603,10 +835,11 @@ void KeyValueBlockchain::insertCategoryMapping(const std::string& cat_id, const
 
 void KeyValueBlockchain::addNewCategory(const std::string& cat_id, CATEGORY_TYPE type) {
   insertCategoryMapping(cat_id, type);
+  const auto merkle_cache_size = bftEngine::ReplicaConfig::instance().kvbcBlockMerkleInternalNodesCacheSize;
   auto inserted = false;
   switch (type) {
     case CATEGORY_TYPE::block_merkle:
-      inserted = categories_.try_emplace(cat_id, detail::BlockMerkleCategory{native_client_}).second;
+      inserted = categories_.try_emplace(cat_id, detail::BlockMerkleCategory{native_client_, merkle_cache_size}).second;
       break;
     case CATEGORY_TYPE::immutable:
       inserted = categories_.try_emplace(cat_id, detail::ImmutableKeyValueCategory{cat_id, native_client_}).second;
@@ -627,6 +860,7 @@ BlockMerkleOutput KeyValueBlockchain::handleCategoryUpdates(BlockId block_id,
                                                             const std::string& category_id,
                                                             BlockMerkleInput&& updates,
                                                             concord::storage::rocksdb::NativeWriteBatch& write_batch) {
+  diagnostics::TimeRecorder scoped_timer(*histograms_.addBlockMerkleUpdates);
   auto itr = categories_.find(category_id);
   if (itr == categories_.end()) {
     throw std::runtime_error{"Category does not exist = " + category_id};
@@ -640,6 +874,7 @@ VersionedOutput KeyValueBlockchain::handleCategoryUpdates(BlockId block_id,
                                                           const std::string& category_id,
                                                           VersionedInput&& updates,
                                                           concord::storage::rocksdb::NativeWriteBatch& write_batch) {
+  diagnostics::TimeRecorder scoped_timer(*histograms_.addVersionedUpdates);
   auto itr = categories_.find(category_id);
   if (itr == categories_.end()) {
     throw std::runtime_error{"Category does not exist = " + category_id};
@@ -653,6 +888,7 @@ ImmutableOutput KeyValueBlockchain::handleCategoryUpdates(BlockId block_id,
                                                           const std::string& category_id,
                                                           ImmutableInput&& updates,
                                                           concord::storage::rocksdb::NativeWriteBatch& write_batch) {
+  diagnostics::TimeRecorder scoped_timer(*histograms_.addImmutableUpdates);
   auto itr = categories_.find(category_id);
   if (itr == categories_.end()) {
     throw std::runtime_error{"Category does not exist = " + category_id};
@@ -662,6 +898,49 @@ ImmutableOutput KeyValueBlockchain::handleCategoryUpdates(BlockId block_id,
   return std::get<detail::ImmutableKeyValueCategory>(itr->second).add(block_id, std::move(updates), write_batch);
 }
 
+/////////////////////// Block archive ///////////////////////
+
+void KeyValueBlockchain::setBlockArchive(const std::shared_ptr<IBlockArchive>& archive, std::uint64_t horizon) {
+  ConcordAssert(!block_archive_);
+  if (horizon == 0) {
+    throw std::invalid_argument{"The block archive horizon must be larger than 0"};
+  }
+  block_archive_ = archive;
+  LOG_INFO(CAT_BLOCK_LOG, "Archiving blocks" << KVLOG(block_archive_->lastBlockId(), horizon));
+  block_archiver_ = std::thread([this, horizon]() { runBlockArchiver(horizon); });
+}
+
+void KeyValueBlockchain::archiveBlocksUntil(BlockId until) {
+  for (auto block_id = std::max(block_archive_->lastBlockId() + 1, getGenesisBlockId());
+       block_id < until && !stop_block_archiver_;
+       ++block_id) {
+    // The lock is held while archiving, so that the block can't be deleted and replaced before it is in the archive.
+    std::lock_guard lock(block_archive_lock_);
+    // Pruned in the meantime, in which case it has been archived by deleteGenesisBlock()
+    if (block_id < getGenesisBlockId()) continue;
+    const auto raw_block = block_chain_.getRawBlock(block_id, categories_);
+    if (!raw_block) return;
+    block_archive_->put(block_id, *raw_block);
+  }
+}
+
+void KeyValueBlockchain::runBlockArchiver(std::uint64_t horizon) {
+  while (true) {
+    try {
+      const auto last_reachable_block_id = getLastReachableBlockId();
+      if (last_reachable_block_id > horizon) {
+        archiveBlocksUntil(last_reachable_block_id - horizon + 1);
+      }
+    } catch (const std::exception& e) {
+      // Blocks are archived by deleteGenesisBlock() at the latest, so just try again later
+      LOG_WARN(CAT_BLOCK_LOG, "Failed to archive blocks, reason: " << e.what());
+    }
+    std::unique_lock lock(block_archiver_stop_lock_);
+    if (block_archiver_stop_cv_.wait_for(lock, kBlockArchiverPeriod, [this]() { return stop_block_archiver_.load(); }))
+      return;
+  }
+}
+
 /////////////////////// state transfer blockchain ///////////////////////
 void KeyValueBlockchain::addRawBlock(const RawBlock& block, const BlockId& block_id, bool lastBlock) {
   diagnostics::TimeRecorder scoped_timer(*histograms_.addRawBlock);
@@ -699,15 +978,40 @@ std::optional<RawBlock> KeyValueBlockchain::getRawBlock(const BlockId& block_id)
   if (block_id > last_reachable_block) {
     return state_transfer_block_chain_.getRawBlock(block_id);
   }
+  // Pruned blocks are taken from the archive
+  if (block_archive_ && block_id < getGenesisBlockId()) {
+    return block_archive_->get(block_id);
+  }
+  if (const auto record = getSerializedRawBlock(block_id)) {
+    return RawBlock::deserialize(record->data());
+  }
   // Try from the blockchain itself
   return block_chain_.getRawBlock(block_id, categories_);
 }
 
+std::optional<detail::BlockSegmentStore::Record> KeyValueBlockchain::getSerializedRawBlock(BlockId block_id) const {
+  if (!block_segments_ || block_id < getGenesisBlockId() || block_id > getLastReachableBlockId()) {
+    return std::nullopt;
+  }
+  try {
+    return block_segments_->get(block_id);
+  } catch (const std::exception& e) {
+    // The block can still be re-created from the blockchain.
+    LOG_ERROR(CAT_BLOCK_LOG, "Failed to read block from the block segment store, reason: " << e.what());
+    return std::nullopt;
+  }
+}
+
 std::optional<Hash> KeyValueBlockchain::parentDigest(BlockId block_id) const {
   const auto last_reachable_block = getLastReachableBlockId();
   if (block_id > last_reachable_block) {
     return state_transfer_block_chain_.parentDigest(block_id);
   }
+  if (block_archive_ && block_id < getGenesisBlockId()) {
+    auto raw_block = block_archive_->get(block_id);
+    if (!raw_block) return std::nullopt;
+    return raw_block->data.parent_digest;
+  }
   return block_chain_.parentDigest(block_id);
 }
 
@@ -716,6 +1020,10 @@ bool KeyValueBlockchain::hasBlock(BlockId block_id) const {
   if (block_id > last_reachable_block) {
     return state_transfer_block_chain_.hasBlock(block_id);
   }
+  if (block_archive_ && block_id < getGenesisBlockId()) {
+    // Blocks that were pruned before the archive was set are not in it.
+    return block_archive_->has(block_id);
+  }
   return block_chain_.hasBlock(block_id);
 }
 
@@ -724,13 +1032,37 @@ void KeyValueBlockchain::linkSTChainFrom(BlockId block_id) {
   const auto last_block_id = state_transfer_block_chain_.getLastBlockId();
   if (last_block_id == 0) return;
 
+  // Blocks have to be added one after the other, as the updates of a block depend on the state left by its parent.
+  // Therefore, the next blocks are read and deserialized by a pool of prefetch threads while the current one is added.
+  const auto prefetch_threads = bftEngine::ReplicaConfig::instance().kvbcSTLinkPrefetchThreads;
+  auto prefetch_pool = std::optional<util::ThreadPool>{};
+  if (prefetch_threads > 0 && last_block_id > block_id) prefetch_pool.emplace(prefetch_threads);
+  const auto max_prefetched_blocks = std::size_t{prefetch_threads} * kSTLinkPrefetchedBlocksPerThread;
+  auto prefetched_blocks = std::deque<std::future<std::optional<RawBlock>>>{};
+  auto next_to_prefetch = block_id;
+  const auto start = std::chrono::steady_clock::now();
+
   for (auto i = block_id; i <= last_block_id; ++i) {
-    auto raw_block = state_transfer_block_chain_.getRawBlock(i);
+    auto raw_block = std::optional<RawBlock>{};
+    if (prefetch_pool) {
+      while (next_to_prefetch <= last_block_id && prefetched_blocks.size() < max_prefetched_blocks) {
+        prefetched_blocks.push_back(prefetch_pool->async(
+            [this](BlockId id) { return state_transfer_block_chain_.getRawBlock(id); }, next_to_prefetch++));
+      }
+      raw_block = prefetched_blocks.front().get();
+      prefetched_blocks.pop_front();
+    } else {
+      raw_block = state_transfer_block_chain_.getRawBlock(i);
+    }
     if (!raw_block) {
       return;
     }
     writeSTLinkTransaction(i, *raw_block);
   }
+  const auto duration_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  LOG_INFO(CAT_BLOCK_LOG,
+           "Linked state transfer blocks" << KVLOG(block_id, last_block_id, prefetch_threads, duration_ms));
   // Linking has fully completed and we should not have any more ST temporary blocks left. Therefore, make sure we don't
   // have any value for the latest ST temporary block ID cache.
   state_transfer_block_chain_.resetChain();
@@ -744,6 +1076,12 @@ void KeyValueBlockchain::writeSTLinkTransaction(const BlockId block_id, RawBlock
   native_client_->write(std::move(write_batch));
 
   block_chain_.setAddedBlockId(new_block_id);
+  for (const auto& [category_id, _] : last_raw_block_.second->updates.kv) {
+    (void)_;
+    cacheMerkleInternalNodes(category_id);
+  }
+  updateLatestValuesCache(new_block_id, last_raw_block_.second->updates);
+  recordUpdates(new_block_id, last_raw_block_.second->updates);
 }
 
 std::string KeyValueBlockchain::getPruningStatus() {
@@ -764,4 +1102,55 @@ std::string KeyValueBlockchain::getPruningStatus() {
   return oss.str();
 }
 
+std::string KeyValueBlockchain::getColumnFamilyStats() const {
+  using ::rocksdb::DB;
+  auto& db = native_client_->rawDB();
+  std::unordered_map<std::string, std::string> result;
+
+  const auto stats = db.GetDBOptions().statistics;
+  if (stats) {
+    const auto hits = stats->getTickerCount(::rocksdb::BLOCK_CACHE_HIT);
+    const auto misses = stats->getTickerCount(::rocksdb::BLOCK_CACHE_MISS);
+    result.insert(toPair("blockCacheHitRate", hits + misses > 0 ? static_cast<double>(hits) / (hits + misses) : 0.0));
+    result.insert(toPair("stallMicros", stats->getTickerCount(::rocksdb::STALL_MICROS)));
+  }
+
+  const auto int_properties = std::array<std::pair<const char*, const std::string*>, 9>{{
+      {"pendingCompactionBytes", &DB::Properties::kEstimatePendingCompactionBytes},
+      {"compactionPending", &DB::Properties::kCompactionPending},
+      {"runningCompactions", &DB::Properties::kNumRunningCompactions},
+      {"isWriteStopped", &DB::Properties::kIsWriteStopped},
+      {"delayedWriteRate", &DB::Properties::kActualDelayedWriteRate},
+      {"memTablesSize", &DB::Properties::kCurSizeAllMemTables},
+      {"estimatedNumKeys", &DB::Properties::kEstimateNumKeys},
+      {"blockCacheCapacity", &DB::Properties::kBlockCacheCapacity},
+      {"blockCacheUsage", &DB::Properties::kBlockCacheUsage}}};
+  const auto profiles = native_client_->columnFamilyProfiles();
+  for (const auto& cf : native_client_->columnFamilies()) {
+    auto* handle = native_client_->columnFamilyHandle(cf);
+    std::unordered_map<std::string, std::string> cf_result;
+    if (profiles) {
+      cf_result.insert(toPair("profile", "\"" + detail::columnFamilyProfile(cf) + "\""));
+    }
+    for (const auto& [name, property] : int_properties) {
+      auto value = std::uint64_t{0};
+      if (db.GetIntProperty(handle, *property, &value)) {
+        cf_result.insert(toPair(name, value));
+      }
+    }
+    // Write stalls per cause, e.g. too many L0 files or too much pending compaction.
+    auto cf_stats = std::map<std::string, std::string>{};
+    if (db.GetMapProperty(handle, DB::Properties::kCFStats, &cf_stats)) {
+      const auto io_stalls_prefix = std::string{"io_stalls."};
+      for (const auto& [name, value] : cf_stats) {
+        if (name.compare(0, io_stalls_prefix.size(), io_stalls_prefix) == 0) {
+          cf_result.insert(toPair(name, value));
+        }
+      }
+    }
+    result.insert(toPair(cf, concordUtils::kContainerToJson(cf_result)));
+  }
+  return concordUtils::kContainerToJson(result);
+}
+
 }  // namespace concord::kvbc::categorization
@@ -0,0 +1,143 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "categorization/updates_recorder.h"
+
+#include "categorization/details.h"
+#include "Logger.hpp"
+
+#include <ctime>
+#include <iomanip>
+#include <ratio>
+#include <sstream>
+#include <stdexcept>
+
+namespace concord::kvbc::categorization {
+
+namespace {
+
+const auto kMagic = std::string{"KVBCUPDATES1"};
+
+// Precedes the serialized CategoryInput of every record.
+struct RecordHeader {
+  std::uint64_t time_us;
+  std::uint64_t size;
+};
+
+std::string timestampedPath(const std::string &path_prefix) {
+  const auto now = std::chrono::system_clock::now();
+  const auto time = std::chrono::system_clock::to_time_t(now);
+  const auto micros =
+      std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count() % std::micro::den;
+  auto tm = std::tm{};
+  gmtime_r(&time, &tm);
+  auto path = std::ostringstream{};
+  path << path_prefix << std::put_time(&tm, ".%Y%m%d-%H%M%S.") << std::setw(6) << std::setfill('0') << micros;
+  return path.str();
+}
+
+template <typename T>
+void write(std::ofstream &file, const T &value) {
+  file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T>
+bool read(std::ifstream &file, T &value) {
+  return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+}  // namespace
+
+UpdatesRecorder::UpdatesRecorder(const std::string &path_prefix,
+                                 const std::map<std::string, CATEGORY_TYPE> &category_types)
+    : path_{timestampedPath(path_prefix)},
+      file_{path_, std::ios::out | std::ios::binary | std::ios::trunc},
+      start_{std::chrono::steady_clock::now()} {
+  if (!file_) {
+    throw std::runtime_error{"Failed to open updates recording " + path_};
+  }
+  file_.write(kMagic.data(), kMagic.size());
+  write(file_, static_cast<std::uint32_t>(category_types.size()));
+  for (const auto &[category_id, type] : category_types) {
+    write(file_, type);
+    write(file_, static_cast<std::uint32_t>(category_id.size()));
+    file_.write(category_id.data(), category_id.size());
+  }
+  file_.flush();
+  if (!file_) {
+    throw std::runtime_error{"Failed to write to updates recording " + path_};
+  }
+  LOG_INFO(CAT_BLOCK_LOG, "Recording the blockchain updates" << KVLOG(path_, category_types.size()));
+}
+
+void UpdatesRecorder::record(const CategoryInput &updates) {
+  const auto time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_);
+  buffer_.clear();
+  serialize(buffer_, updates);
+  write(file_, RecordHeader{static_cast<std::uint64_t>(time.count()), buffer_.size()});
+  file_.write(reinterpret_cast<const char *>(buffer_.data()), buffer_.size());
+  if (!file_) {
+    throw std::runtime_error{"Failed to write to updates recording " + path_};
+  }
+}
+
+UpdatesRecording::UpdatesRecording(const std::string &path)
+    : file_{path, std::ios::in | std::ios::binary | std::ios::ate} {
+  if (!file_) {
+    throw std::runtime_error{"Failed to open updates recording " + path};
+  }
+  file_size_ = static_cast<std::uint64_t>(file_.tellg());
+  file_.seekg(0);
+  auto magic = std::string(kMagic.size(), '\0');
+  auto num_categories = std::uint32_t{0};
+  if (!file_.read(magic.data(), magic.size()) || magic != kMagic || !read(file_, num_categories)) {
+    throw std::runtime_error{"Invalid updates recording " + path};
+  }
+  for (auto i = 0u; i < num_categories; ++i) {
+    auto type = CATEGORY_TYPE::end_of_types;
+    auto size = std::uint32_t{0};
+    if (!read(file_, type) || type >= CATEGORY_TYPE::end_of_types || !read(file_, size)) {
+      throw std::runtime_error{"Invalid updates recording " + path};
+    }
+    auto category_id = std::string(size, '\0');
+    if (!file_.read(category_id.data(), category_id.size())) {
+      throw std::runtime_error{"Invalid updates recording " + path};
+    }
+    category_types_[std::move(category_id)] = type;
+  }
+}
+
+std::optional<UpdatesRecording::Record> UpdatesRecording::next() {
+  auto header = RecordHeader{};
+  if (!read(file_, header)) {
+    return std::nullopt;
+  }
+  // Don't trust the size of a record that might be partially written or corrupted before allocating memory for it.
+  const auto remaining = file_size_ - static_cast<std::uint64_t>(file_.tellg());
+  if (header.size > remaining) {
+    LOG_WARN(CAT_BLOCK_LOG,
+             "Ignoring a partially written record at the end of the updates recording"
+                 << KVLOG(header.size, remaining));
+    return std::nullopt;
+  }
+  buffer_.resize(header.size);
+  if (!file_.read(reinterpret_cast<char *>(buffer_.data()), buffer_.size())) {
+    LOG_WARN(CAT_BLOCK_LOG, "Ignoring a partially written record at the end of the updates recording");
+    return std::nullopt;
+  }
+  auto record = Record{std::chrono::microseconds{header.time_us}, CategoryInput{}};
+  detail::deserialize(buffer_, record.updates);
+  return record;
+}
+
+}  // namespace concord::kvbc::categorization
@@ -22,7 +22,9 @@
 #include <rocksdb/slice.h>
 #include <rocksdb/status.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <set>
 #include <utility>
 
 namespace concord::kvbc::categorization::detail {
@@ -432,4 +434,46 @@ std::optional<KeyValueProof> VersionedKeyValueCategory::getProof(BlockId block_i
   return proof;
 }
 
+std::optional<MultiKeyValueProof> VersionedKeyValueCategory::getMultiProof(BlockId block_id,
+                                                                           const std::vector<std::string> &keys,
+                                                                           const VersionedOutput &out) const {
+  if (keys.empty() || !out.root_hash) {
+    return std::nullopt;
+  }
+
+  // Only updated keys are part of the root hash, in key order.
+  auto updated_keys = std::vector<std::string>{};
+  for (const auto &[key, flags] : out.keys) {
+    if (!flags.deleted) {
+      updated_keys.push_back(key);
+    }
+  }
+  const auto proven_keys = std::set<std::string>{keys.cbegin(), keys.cend()};
+  if (!std::includes(updated_keys.cbegin(), updated_keys.cend(), proven_keys.cbegin(), proven_keys.cend())) {
+    return std::nullopt;
+  }
+
+  // Read all values in the block at once instead of once per proven key.
+  auto values = std::vector<std::optional<Value>>{};
+  multiGet(updated_keys, std::vector<BlockId>(updated_keys.size(), block_id), values);
+
+  auto proof = MultiKeyValueProof{};
+  proof.block_id = block_id;
+  for (auto i = 0ul; i < updated_keys.size(); ++i) {
+    // The keys have not been updated in `block_id`.
+    if (!values[i]) {
+      return std::nullopt;
+    }
+    auto &value = asVersioned(values[i]).data;
+    if (proven_keys.find(updated_keys[i]) != proven_keys.cend()) {
+      proof.key_value_indexes.push_back(proof.ordered_complement_kv_hashes.size());
+      proof.key_values.emplace_back(std::move(updated_keys[i]), std::move(value));
+    } else {
+      proof.ordered_complement_kv_hashes.push_back(hash(updated_keys[i]));
+      proof.ordered_complement_kv_hashes.push_back(hash(value));
+    }
+  }
+  return proof;
+}
+
 }  // namespace concord::kvbc::categorization::detail
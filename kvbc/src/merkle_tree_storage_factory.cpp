@@ -13,6 +13,8 @@
 #include "merkle_tree_storage_factory.h"
 
 #include "merkle_tree_db_adapter.h"
+#include "bftengine/ReplicaConfig.hpp"
+#include "categorization/column_family_profiles.h"
 #include "memorydb/client.h"
 #include "storage/merkle_tree_key_manipulator.h"
 #include "rocksdb/client.h"
@@ -59,18 +61,29 @@ RocksDBStorageFactory::RocksDBStorageFactory(const std::string& dbPath,
 
 IStorageFactory::DatabaseSet RocksDBStorageFactory::newDatabaseSet() const {
   auto ret = IStorageFactory::DatabaseSet{};
+  // The profiles have to be in place when the DB is opened, as RocksDB doesn't persist block caches.
+  auto cfProfiles = std::shared_ptr<const storage::rocksdb::ColumnFamilyProfiles>{};
+  if (const auto size = bftEngine::ReplicaConfig::instance().kvbcColumnFamilyProfilesBlockCacheSize; size > 0) {
+    cfProfiles = categorization::detail::defaultColumnFamilyProfiles(size);
+  }
   if (!dbConfPath_) {
-    ret.dataDBClient = std::make_shared<storage::rocksdb::Client>(dbPath_);
-    ret.dataDBClient->init();
+    auto client = std::make_shared<storage::rocksdb::Client>(dbPath_);
+    client->setColumnFamilyProfiles(cfProfiles);
+    client->init();
+    ret.dataDBClient = client;
   } else {
     const auto rocksdbLruCacheBytes = rocksdbLruCacheBytes_;
     auto opts = storage::rocksdb::NativeClient::UserOptions{
         *dbConfPath_,
-        [rocksdbLruCacheBytes](::rocksdb::Options& db_options,
-                               std::vector<::rocksdb::ColumnFamilyDescriptor>& cf_descs) {
+        [rocksdbLruCacheBytes, cfProfiles](::rocksdb::Options& db_options,
+                                           std::vector<::rocksdb::ColumnFamilyDescriptor>& cf_descs) {
           completeRocksDBConfiguration(db_options, cf_descs, rocksdbLruCacheBytes);
+          if (cfProfiles) {
+            cfProfiles->apply(cf_descs);
+          }
         }};
     auto db = storage::rocksdb::NativeClient::newClient(dbPath_, false, opts);
+    db->setColumnFamilyProfiles(cfProfiles);
     ret.dataDBClient = db->asIDBClient();
   }
   ret.metadataDBClient = ret.dataDBClient;
@@ -123,7 +123,8 @@ const RSAPruningVerifier::Replica& RSAPruningVerifier::getReplica(ReplicaVector:
 PruningHandler::PruningHandler(kvbc::IReader& ro_storage,
                                kvbc::IBlockAdder& blocks_adder,
                                kvbc::IBlocksDeleter& blocks_deleter,
-                               bool run_async)
+                               bool run_async,
+                               const std::shared_ptr<cron::CronTableRegistry>& cron_table_registry)
     : logger_{logging::getLogger("concord.pruning")},
       signer_{bftEngine::ReplicaConfig::instance().replicaPrivateKey},
       verifier_{bftEngine::ReplicaConfig::instance().publicKeysOfReplicas},
@@ -135,6 +136,23 @@ PruningHandler::PruningHandler(kvbc::IReader& ro_storage,
       run_async_{run_async} {
   pruning_enabled_ = bftEngine::ReplicaConfig::instance().pruningEnabled_;
   num_blocks_to_keep_ = bftEngine::ReplicaConfig::instance().numBlocksToKeep_;
+  pruning_online_ = bftEngine::ReplicaConfig::instance().pruningOnline_ && cron_table_registry;
+  if (pruning_online_) {
+    const auto rule = [this](const cron::Tick&) {
+      std::lock_guard lock(pruning_status_lock_);
+      return online_pruning_.has_value();
+    };
+    const auto action = [this](const cron::Tick&) { pruneNextBatch(); };
+    (*cron_table_registry)[kPruningTicksComponentId].addEntry({0, rule, action});
+  }
+}
+
+void PruningHandler::setTicksGenerator(const std::shared_ptr<cron::TicksGenerator>& ticks_generator) {
+  std::lock_guard lock(pruning_status_lock_);
+  ticks_generator_ = ticks_generator;
+  if (ticks_generator_ && online_pruning_) {
+    ticks_generator_->start(kPruningTicksComponentId, online_pruning_->tick_period);
+  }
 }
 
 bool PruningHandler::handle(const concord::messages::LatestPrunableBlockRequest& latest_prunable_block_request,
@@ -187,7 +205,12 @@ bool PruningHandler::handle(const concord::messages::PruneRequest& request,
   const auto latest_prunable_block_id = agreedPrunableBlockId(request);
 
   // Execute actual pruning.
-  pruneThroughBlockId(latest_prunable_block_id);
+  if (pruning_online_) {
+    pruneOnlineThroughBlockId(
+        latest_prunable_block_id, std::chrono::seconds{request.tick_period_seconds}, request.batch_blocks_num);
+  } else {
+    pruneThroughBlockId(latest_prunable_block_id);
+  }
   std::ostringstream oss;
   oss << std::to_string(latest_prunable_block_id);
   std::string str = oss.str();
@@ -245,6 +268,54 @@ void PruningHandler::pruneThroughBlockId(kvbc::BlockId block_id) const {
   }
 }
 
+void PruningHandler::pruneOnlineThroughBlockId(kvbc::BlockId block_id,
+                                               const std::chrono::seconds& tick_period,
+                                               std::uint64_t batch_blocks_num) {
+  if (block_id < ro_storage_.getGenesisBlockId()) return;
+  std::lock_guard lock(pruning_status_lock_);
+  // A later request can only extend the range that is being pruned
+  const auto until = online_pruning_ ? std::max(online_pruning_->until, block_id) : block_id;
+  online_pruning_ = OnlinePruning{until, tick_period, batch_blocks_num};
+  last_scheduled_block_for_pruning_ = until;
+  LOG_INFO(logger_, "Scheduled online pruning" << KVLOG(until, tick_period.count(), batch_blocks_num));
+  if (ticks_generator_) ticks_generator_->start(kPruningTicksComponentId, tick_period);
+}
+
+void PruningHandler::pruneNextBatch() {
+  std::optional<OnlinePruning> online_pruning;
+  {
+    std::lock_guard lock(pruning_status_lock_);
+    online_pruning = online_pruning_;
+  }
+  if (!online_pruning) return;
+
+  // Ticks are executed in the same order on all replicas, so all of them prune the same batch here
+  const auto genesis_block_id = ro_storage_.getGenesisBlockId();
+  const auto until = std::min(genesis_block_id + online_pruning->batch_blocks_num, online_pruning->until + 1);
+  if (until > genesis_block_id) {
+    try {
+      blocks_deleter_.deleteBlocksUntil(until);
+    } catch (std::exception& e) {
+      LOG_FATAL(logger_, e.what());
+      std::terminate();
+    } catch (...) {
+      LOG_FATAL(logger_, "Error while running pruning");
+      std::terminate();
+    }
+    LOG_DEBUG(logger_, "Pruned a batch of blocks" << KVLOG(genesis_block_id, until));
+  }
+
+  if (ro_storage_.getGenesisBlockId() > online_pruning->until) {
+    std::lock_guard lock(pruning_status_lock_);
+    // Unless a later request extended the range in the meantime
+    if (online_pruning_ && online_pruning_->until == online_pruning->until) {
+      online_pruning_.reset();
+      if (ticks_generator_) ticks_generator_->stop(kPruningTicksComponentId);
+      LOG_INFO(logger_, "Online pruning is done" << KVLOG(online_pruning->until));
+    }
+  }
+}
+
 bool PruningHandler::handle(const concord::messages::PruneStatusRequest&,
                             uint64_t,
                             concord::messages::ReconfigurationResponse& rres) {
@@ -254,6 +325,11 @@ bool PruningHandler::handle(const concord::messages::PruneStatusRequest&,
   prune_status.last_pruned_block =
       last_scheduled_block_for_pruning_.has_value() ? last_scheduled_block_for_pruning_.value() : 0;
   prune_status.in_progress = bftEngine::ControlStateManager::instance().getPruningProcessStatus();
+  if (online_pruning_) {
+    // Report the progress so far
+    prune_status.last_pruned_block = ro_storage_.getGenesisBlockId() - 1;
+    prune_status.in_progress = true;
+  }
   rres.response = prune_status;
   LOG_INFO(logger_, "Pruning status is " << KVLOG(prune_status.in_progress));
   return true;
@@ -732,6 +732,69 @@ TEST_F(block_merkle_category, delete_last_reachable) {
   }
 }
 
+TEST_F(block_merkle_category, internal_nodes_cache) {
+  // Apply the same blocks to a category with a small internal nodes cache (so that nodes are evicted too) and to the
+  // fixture category that doesn't cache them. Both must generate the same tree.
+  cleanup(1);
+  auto cached_db = TestRocksDb::createNative(1);
+  auto cached_cat = BlockMerkleCategory{cached_db, 16};
+  auto add_to_both = [&](BlockId block_id, const BlockMerkleInput &update) {
+    auto batch = cached_db->getBatch();
+    const auto cached_out = cached_cat.add(block_id, BlockMerkleInput{update}, batch);
+    cached_db->write(std::move(batch));
+    cached_cat.onBatchWritten();
+    const auto out = add(block_id, BlockMerkleInput{update});
+    EXPECT_EQ(out.root_hash, cached_out.root_hash);
+    EXPECT_EQ(out.state_root_version, cached_out.state_root_version);
+    return out;
+  };
+  auto update = [](BlockId block_id, const std::string &val) {
+    return BlockMerkleInput{{{"key" + std::to_string(block_id % 10), val + std::to_string(block_id)}}};
+  };
+
+  std::vector<BlockMerkleOutput> out;
+  for (auto i = 1u; i <= 100; i++) {
+    out.push_back(add_to_both(i, update(i, val1)));
+  }
+
+  // Rewrite the last tree version with different nodes.
+  {
+    auto batch = db->getBatch();
+    cat.deleteLastReachableBlock(100, out.back(), batch);
+    db->write(std::move(batch));
+    auto cached_batch = cached_db->getBatch();
+    cached_cat.deleteLastReachableBlock(100, out.back(), cached_batch);
+    cached_db->write(std::move(cached_batch));
+  }
+  out.back() = add_to_both(100, update(100, val2));
+
+  // A tree update whose batch is never written is not cached.
+  {
+    auto dropped_batch = cached_db->getBatch();
+    cached_cat.add(101, update(101, val1), dropped_batch);
+  }
+
+  // Pruning creates new tree versions and deletes stale nodes.
+  for (auto i = 1u; i <= 50; i++) {
+    deleteGenesisBlock(i, out[i - 1]);
+    auto batch = cached_db->getBatch();
+    cached_cat.deleteGenesisBlock(i, out[i - 1], batch);
+    cached_db->write(std::move(batch));
+    cached_cat.onBatchWritten();
+  }
+  for (auto i = 101u; i <= 120; i++) {
+    add_to_both(i, update(i, val3));
+  }
+
+  ASSERT_EQ(cat.getLatestTreeVersion(), cached_cat.getLatestTreeVersion());
+  ASSERT_EQ(getAllInternalNodes(db), getAllInternalNodes(cached_db));
+  ASSERT_EQ(getAllLeaves(db), getAllLeaves(cached_db));
+
+  cached_cat = BlockMerkleCategory{};
+  cached_db.reset();
+  cleanup(1);
+}
+
 }  // namespace
 
 int main(int argc, char *argv[]) {
@@ -0,0 +1,145 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "gtest/gtest.h"
+#include "categorization/block_segment_store.h"
+#include "categorization/column_families.h"
+#include "categorization/details.h"
+#include "storage/test/storage_test_common.h"
+
+#include <fstream>
+#include <string>
+
+using concord::storage::rocksdb::NativeClient;
+using namespace concord::kvbc::categorization;
+using namespace concord::kvbc::categorization::detail;
+using namespace concord::kvbc;
+
+namespace {
+
+class block_segment_store : public ::testing::Test {
+  void SetUp() override {
+    destroyDb();
+    db = TestRocksDb::createNative();
+  }
+
+  void TearDown() override { destroyDb(); }
+
+  void destroyDb() {
+    db.reset();
+    ASSERT_EQ(0, db.use_count());
+    cleanup();
+    fs::remove_all(path);
+  }
+
+ protected:
+  void append(BlockSegmentStore& store, BlockId block_id) {
+    auto batch = db->getBatch();
+    store.append(block_id, data(block_id), batch);
+    db->write(std::move(batch));
+  }
+
+  void erase(BlockSegmentStore& store, BlockId block_id) {
+    auto batch = db->getBatch();
+    store.erase(block_id, batch);
+    db->write(std::move(batch));
+  }
+
+  static std::string data(BlockId block_id) { return std::string(block_id * 7, static_cast<char>('a' + block_id)); }
+
+  std::size_t numSegments() const {
+    return std::distance(fs::directory_iterator{path}, fs::directory_iterator{});
+  }
+
+ protected:
+  std::shared_ptr<NativeClient> db;
+  const std::string path{rocksDbPath(defaultDbId) + "_segments"};
+  const std::uint64_t segment_size{128};
+};
+
+TEST_F(block_segment_store, append_and_get) {
+  auto store = BlockSegmentStore{db, path, segment_size};
+  for (auto i = BlockId{1}; i <= 10; ++i) {
+    append(store, i);
+  }
+  // Records are spread across segments.
+  ASSERT_GT(numSegments(), 1);
+  for (auto i = BlockId{1}; i <= 10; ++i) {
+    ASSERT_EQ(store.get(i)->data(), data(i));
+  }
+  ASSERT_FALSE(store.get(11).has_value());
+
+  // An appended record is only visible once its batch is written.
+  auto batch = db->getBatch();
+  store.append(11, data(11), batch);
+  ASSERT_FALSE(store.get(11).has_value());
+  db->write(std::move(batch));
+  ASSERT_EQ(store.get(11)->data(), data(11));
+}
+
+TEST_F(block_segment_store, reopen) {
+  {
+    auto store = BlockSegmentStore{db, path, segment_size};
+    for (auto i = BlockId{1}; i <= 5; ++i) {
+      append(store, i);
+    }
+  }
+  auto store = BlockSegmentStore{db, path, segment_size};
+  append(store, 6);
+  for (auto i = BlockId{1}; i <= 6; ++i) {
+    ASSERT_EQ(store.get(i)->data(), data(i));
+  }
+}
+
+TEST_F(block_segment_store, remove_segments) {
+  auto store = BlockSegmentStore{db, path, segment_size};
+  for (auto i = BlockId{1}; i <= 10; ++i) {
+    append(store, i);
+  }
+  const auto segments = numSegments();
+  auto record = store.get(3);
+  for (auto i = BlockId{1}; i <= 5; ++i) {
+    erase(store, i);
+  }
+  store.removeSegmentsBefore(6);
+  ASSERT_LT(numSegments(), segments);
+  ASSERT_FALSE(store.get(3).has_value());
+  ASSERT_EQ(store.get(6)->data(), data(6));
+
+  // Records that are being read are still valid.
+  ASSERT_EQ(record->data(), data(3));
+}
+
+TEST_F(block_segment_store, corrupted_record) {
+  auto store = BlockSegmentStore{db, path, segment_size};
+  append(store, 1);
+  const auto location_ser = db->get(BLOCK_SEGMENTS_CF, serialize(BlockKey{1}));
+  ASSERT_TRUE(location_ser.has_value());
+  auto location = BlockSegmentLocation{};
+  deserialize(*location_ser, location);
+  {
+    auto file = std::fstream{path + "/segment_" + std::to_string(location.segment),
+                             std::ios::in | std::ios::out | std::ios::binary};
+    // Skip the 16 bytes of the record header.
+    file.seekp(location.offset + 16);
+    file.put('X');
+  }
+  ASSERT_THROW(store.get(1), std::runtime_error);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
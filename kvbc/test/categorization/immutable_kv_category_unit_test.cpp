@@ -571,6 +571,43 @@ TEST_F(immutable_kv_category, get_proof_non_existent_key) {
   ASSERT_FALSE(cat.getProof("t", "non-existent", update_info));
 }
 
+TEST_F(immutable_kv_category, get_multi_proof) {
+  auto update = ImmutableInput{};
+  update.calculate_root_hash = true;
+  update.kv["k1"] = ImmutableValueUpdate{"v1", {"t1", "t2"}};
+  update.kv["k2"] = ImmutableValueUpdate{"v2", {"t1"}};
+  update.kv["k3"] = ImmutableValueUpdate{"v3", {"t1", "t2"}};
+  update.kv["k4"] = ImmutableValueUpdate{"v4", {"t1"}};
+
+  const auto block_id = 42;
+  const auto update_info = add(block_id, std::move(update));
+  ASSERT_TRUE(update_info.tag_root_hashes);
+  const auto &tag_root_hashes = *update_info.tag_root_hashes;
+
+  {
+    const auto proof = cat.getMultiProof("t1", {"k4", "k2"}, update_info);
+    ASSERT_TRUE(proof);
+    ASSERT_EQ(proof->block_id, block_id);
+    const auto expected_key_values = std::vector<std::pair<std::string, std::string>>{{"k2", "v2"}, {"k4", "v4"}};
+    ASSERT_EQ(proof->key_values, expected_key_values);
+    ASSERT_THAT(proof->key_value_indexes, ContainerEq(std::vector<std::size_t>{2, 4}));
+    ASSERT_EQ(proof->ordered_complement_kv_hashes.size(), 4);
+    ASSERT_THAT(*proof->calculateRootHash(), ContainerEq(tag_root_hashes.at("t1")));
+  }
+
+  // Only keys tagged with t2 are part of its root hash.
+  {
+    const auto proof = cat.getMultiProof("t2", {"k1", "k3"}, update_info);
+    ASSERT_TRUE(proof);
+    ASSERT_TRUE(proof->ordered_complement_kv_hashes.empty());
+    ASSERT_THAT(*proof->calculateRootHash(), ContainerEq(tag_root_hashes.at("t2")));
+  }
+
+  ASSERT_FALSE(cat.getMultiProof("t2", {"k1", "k2"}, update_info));
+  ASSERT_FALSE(cat.getMultiProof("t3", {"k1"}, update_info));
+  ASSERT_FALSE(cat.getMultiProof("t1", {"non-existent"}, update_info));
+}
+
 TEST_F(immutable_kv_category, delete_block) {
   auto update = ImmutableInput{};
   update.calculate_root_hash = true;
@@ -15,11 +15,13 @@
 #include "categorization/column_families.h"
 #include "categorization/updates.h"
 #include "categorization/kv_blockchain.h"
+#include "memorydb/client.h"
 #include <iostream>
 #include <string>
 #include <utility>
 #include <vector>
 #include <random>
+#include <thread>
 #include "storage/test/storage_test_common.h"
 
 using concord::storage::rocksdb::NativeClient;
@@ -655,6 +657,55 @@ TEST_F(categorized_kvbc, link_state_transfer_chain) {
   }
 }
 
+TEST_F(categorized_kvbc, link_state_transfer_chain_with_prefetch) {
+  const auto categories = std::map<std::string, CATEGORY_TYPE>{{"merkle", CATEGORY_TYPE::block_merkle},
+                                                               {"versioned", CATEGORY_TYPE::versioned_kv},
+                                                               {"immutable", CATEGORY_TYPE::immutable}};
+  const auto num_blocks = BlockId{100};
+  auto raw_blocks = std::vector<RawBlock>{};
+  {
+    KeyValueBlockchain source{db, true, categories};
+    for (auto i = BlockId{1}; i <= num_blocks; ++i) {
+      BlockMerkleUpdates merkle_updates;
+      merkle_updates.addUpdate("merkle_key" + std::to_string(i % 7), "merkle_val" + std::to_string(i));
+      VersionedUpdates ver_updates;
+      ver_updates.addUpdate("ver_key" + std::to_string(i % 5), "ver_val" + std::to_string(i));
+      ImmutableUpdates immutable_updates;
+      immutable_updates.addUpdate("immutable_key" + std::to_string(i), {"immutable_val", {"tag"}});
+      Updates updates;
+      updates.add("merkle", std::move(merkle_updates));
+      updates.add("versioned", std::move(ver_updates));
+      updates.add("immutable", std::move(immutable_updates));
+      ASSERT_EQ(source.addBlock(std::move(updates)), i);
+    }
+    for (auto i = BlockId{1}; i <= num_blocks; ++i) {
+      raw_blocks.push_back(*source.getRawBlock(i));
+    }
+  }
+
+  auto target_db = TestRocksDb::createNative(1);
+  {
+    const auto prefetch_threads = bftEngine::ReplicaConfig::instance().kvbcSTLinkPrefetchThreads;
+    bftEngine::ReplicaConfig::instance().kvbcSTLinkPrefetchThreads = 3;
+    KeyValueBlockchain target{target_db, true, categories};
+    // State transfer fetches blocks from the last one backwards.
+    for (auto i = num_blocks; i > 1; --i) {
+      target.addRawBlock(raw_blocks[i - 1], i, false);
+    }
+    ASSERT_EQ(target.getLastReachableBlockId(), 0);
+    target.addRawBlock(raw_blocks[0], 1, true);
+    bftEngine::ReplicaConfig::instance().kvbcSTLinkPrefetchThreads = prefetch_threads;
+
+    ASSERT_FALSE(target.getLastStatetransferBlockId().has_value());
+    ASSERT_EQ(target.getLastReachableBlockId(), num_blocks);
+    for (auto i = BlockId{1}; i <= num_blocks; ++i) {
+      ASSERT_EQ(target.getRawBlock(i), raw_blocks[i - 1]);
+    }
+  }
+  target_db.reset();
+  cleanup(1);
+}
+
 TEST_F(categorized_kvbc, creation_of_category_type_cf) {
   KeyValueBlockchain block_chain{
       db, true, std::map<std::string, CATEGORY_TYPE>{{"merkle", CATEGORY_TYPE::block_merkle}}};
@@ -2038,6 +2089,266 @@ TEST_F(categorized_kvbc, root_hash) {
   }
 }
 
+TEST_F(categorized_kvbc, latest_values_cache) {
+  bftEngine::ReplicaConfig::instance().kvbcLatestValuesCacheSize = 100;
+  KeyValueBlockchain block_chain{db,
+                                 true,
+                                 std::map<std::string, CATEGORY_TYPE>{{"merkle", CATEGORY_TYPE::block_merkle},
+                                                                      {"versioned", CATEGORY_TYPE::versioned_kv},
+                                                                      {"immutable", CATEGORY_TYPE::immutable}}};
+  bftEngine::ReplicaConfig::instance().kvbcLatestValuesCacheSize = 0;
+  auto aggregator = std::make_shared<concordMetrics::Aggregator>();
+  block_chain.setAggregator(aggregator);
+
+  const auto add_block = [&](BlockMerkleUpdates merkle_updates, VersionedUpdates ver_updates) {
+    merkle_updates.addUpdate("filler", "filler");
+    ver_updates.addUpdate("filler", "filler");
+    Updates updates;
+    updates.add("merkle", std::move(merkle_updates));
+    updates.add("versioned", std::move(ver_updates));
+    return block_chain.addBlock(std::move(updates));
+  };
+  const auto merkle = [](BlockId block_id, const std::string& data) {
+    return std::optional<Value>{MerkleValue{{block_id, data}}};
+  };
+  const auto versioned = [](BlockId block_id, const std::string& data) {
+    return std::optional<Value>{VersionedValue{{block_id, data}}};
+  };
+
+  // Block 1
+  {
+    BlockMerkleUpdates merkle_updates;
+    merkle_updates.addUpdate("merkle_key1", "merkle_val1");
+    VersionedUpdates ver_updates;
+    ver_updates.addUpdate("ver_key1", "ver_val1");
+    ver_updates.addUpdate("ver_stale", VersionedUpdates::Value{"ver_stale_val", true});
+    ASSERT_EQ(add_block(std::move(merkle_updates), std::move(ver_updates)), 1);
+  }
+  // Missing keys are cached as well.
+  for (auto i = 0; i < 2; ++i) {
+    ASSERT_EQ(block_chain.getLatest("merkle", "merkle_key1"), merkle(1, "merkle_val1"));
+    ASSERT_EQ(block_chain.getLatest("versioned", "ver_key1"), versioned(1, "ver_val1"));
+    ASSERT_FALSE(block_chain.getLatest("versioned", "non_exist").has_value());
+  }
+
+  // Block 2 - updates and deletes are written through to the cache
+  {
+    BlockMerkleUpdates merkle_updates;
+    merkle_updates.addUpdate("merkle_key1", "merkle_val2");
+    VersionedUpdates ver_updates;
+    ver_updates.addDelete("ver_key1");
+    ver_updates.addUpdate("non_exist", "ver_val2");
+    ASSERT_EQ(add_block(std::move(merkle_updates), std::move(ver_updates)), 2);
+  }
+  ASSERT_EQ(block_chain.getLatest("merkle", "merkle_key1"), merkle(2, "merkle_val2"));
+  ASSERT_FALSE(block_chain.getLatest("versioned", "ver_key1").has_value());
+  {
+    auto values = std::vector<std::optional<Value>>{};
+    block_chain.multiGetLatest("versioned", {"ver_key1", "ver_stale", "non_exist", "other"}, values);
+    ASSERT_EQ(values.size(), 4u);
+    ASSERT_FALSE(values[0].has_value());
+    ASSERT_EQ(values[1], versioned(1, "ver_stale_val"));
+    ASSERT_EQ(values[2], versioned(2, "ver_val2"));
+    ASSERT_FALSE(values[3].has_value());
+  }
+
+  // Deleting the last reachable block reverts to the previous values
+  block_chain.deleteLastReachableBlock();
+  ASSERT_EQ(block_chain.getLatest("merkle", "merkle_key1"), merkle(1, "merkle_val1"));
+  ASSERT_EQ(block_chain.getLatest("versioned", "ver_key1"), versioned(1, "ver_val1"));
+  ASSERT_FALSE(block_chain.getLatest("versioned", "non_exist").has_value());
+
+  // Deleting the genesis block deletes the latest version of a stale-on-update key
+  ASSERT_EQ(add_block(BlockMerkleUpdates{}, VersionedUpdates{}), 2);
+  ASSERT_EQ(block_chain.getLatest("versioned", "ver_stale"), versioned(1, "ver_stale_val"));
+  ASSERT_TRUE(block_chain.deleteBlock(1));
+  ASSERT_FALSE(block_chain.getLatest("versioned", "ver_stale").has_value());
+  ASSERT_EQ(block_chain.getLatest("merkle", "merkle_key1"), merkle(1, "merkle_val1"));
+
+  // Metrics are updated on addBlock()
+  ASSERT_EQ(add_block(BlockMerkleUpdates{}, VersionedUpdates{}), 3);
+  ASSERT_GT(aggregator->GetCounter("kv_blockchain_latest_values_cache", "hits").Get(), 0u);
+  ASSERT_GT(aggregator->GetCounter("kv_blockchain_latest_values_cache", "misses").Get(), 0u);
+}
+
+TEST_F(categorized_kvbc, block_archive) {
+  auto archive_db = std::make_shared<concord::storage::memorydb::Client>();
+  archive_db->init();
+  auto archive = std::make_shared<DBClientBlockArchive>(archive_db);
+  KeyValueBlockchain block_chain{
+      db, true, std::map<std::string, CATEGORY_TYPE>{{"merkle", CATEGORY_TYPE::block_merkle}}};
+
+  const auto num_blocks = BlockId{10};
+  for (auto i = BlockId{1}; i <= num_blocks; ++i) {
+    BlockMerkleUpdates merkle_updates;
+    merkle_updates.addUpdate("merkle_key", "merkle_val" + std::to_string(i));
+    Updates updates;
+    updates.add("merkle", std::move(merkle_updates));
+    ASSERT_EQ(block_chain.addBlock(std::move(updates)), i);
+  }
+  auto raw_blocks = std::vector<RawBlock>{};
+  for (auto i = BlockId{1}; i <= num_blocks; ++i) {
+    raw_blocks.push_back(*block_chain.getRawBlock(i));
+  }
+
+  // Blocks that are pruned are archived on the way out, if the background archiver hasn't reached them yet.
+  ASSERT_THROW(block_chain.setBlockArchive(archive, 0), std::invalid_argument);
+  block_chain.setBlockArchive(archive, num_blocks);
+  ASSERT_EQ(archive->lastBlockId(), 0);
+  for (auto i = BlockId{1}; i < 4; ++i) {
+    ASSERT_TRUE(block_chain.deleteBlock(i));
+  }
+  ASSERT_EQ(block_chain.getGenesisBlockId(), 4);
+  ASSERT_EQ(archive->lastBlockId(), 3);
+  for (auto i = BlockId{1}; i < 4; ++i) {
+    ASSERT_TRUE(block_chain.hasBlock(i));
+    ASSERT_EQ(block_chain.getRawBlock(i), raw_blocks[i - 1]);
+    ASSERT_EQ(block_chain.parentDigest(i), raw_blocks[i - 1].data.parent_digest);
+  }
+  ASSERT_FALSE(block_chain.hasBlock(0));
+  ASSERT_FALSE(block_chain.getRawBlock(0).has_value());
+
+  // The archive survives a restart.
+  ASSERT_EQ(DBClientBlockArchive{archive_db}.lastBlockId(), 3);
+}
+
+TEST_F(categorized_kvbc, block_archive_range) {
+  auto archive_db = std::make_shared<concord::storage::memorydb::Client>();
+  archive_db->init();
+  auto archive = std::make_shared<DBClientBlockArchive>(archive_db);
+  KeyValueBlockchain block_chain{
+      db, true, std::map<std::string, CATEGORY_TYPE>{{"merkle", CATEGORY_TYPE::block_merkle}}};
+
+  const auto num_blocks = BlockId{10};
+  for (auto i = BlockId{1}; i <= num_blocks; ++i) {
+    BlockMerkleUpdates merkle_updates;
+    merkle_updates.addUpdate("merkle_key", "merkle_val" + std::to_string(i));
+    Updates updates;
+    updates.add("merkle", std::move(merkle_updates));
+    ASSERT_EQ(block_chain.addBlock(std::move(updates)), i);
+  }
+
+  // Blocks that were pruned before the archive was set are not in it.
+  ASSERT_TRUE(block_chain.deleteBlock(1));
+  block_chain.setBlockArchive(archive, num_blocks);
+  ASSERT_TRUE(block_chain.deleteBlock(2));
+  ASSERT_EQ(archive->firstBlockId(), 2);
+  ASSERT_EQ(archive->lastBlockId(), 2);
+  ASSERT_FALSE(block_chain.hasBlock(1));
+  ASSERT_FALSE(block_chain.getRawBlock(1).has_value());
+  ASSERT_TRUE(block_chain.hasBlock(2));
+
+  // Archived blocks that are deleted as the last reachable block are removed from the archive.
+  for (auto i = BlockId{3}; i <= num_blocks; ++i) {
+    archive->put(i, *block_chain.getRawBlock(i));
+  }
+  ASSERT_EQ(archive->lastBlockId(), num_blocks);
+  ASSERT_TRUE(block_chain.deleteBlock(num_blocks));
+  ASSERT_TRUE(block_chain.deleteBlock(num_blocks - 1));
+  ASSERT_EQ(archive->lastBlockId(), num_blocks - 2);
+  ASSERT_FALSE(archive->get(num_blocks).has_value());
+  ASSERT_FALSE(archive->get(num_blocks - 1).has_value());
+  ASSERT_TRUE(archive->get(num_blocks - 2).has_value());
+
+  // The range survives a restart.
+  const auto reopened = DBClientBlockArchive{archive_db};
+  ASSERT_EQ(reopened.firstBlockId(), 2);
+  ASSERT_EQ(reopened.lastBlockId(), num_blocks - 2);
+}
+
+TEST_F(categorized_kvbc, block_archive_in_background) {
+  auto archive_db = std::make_shared<concord::storage::memorydb::Client>();
+  archive_db->init();
+  auto archive = std::make_shared<DBClientBlockArchive>(archive_db, "replica0");
+  KeyValueBlockchain block_chain{
+      db, true, std::map<std::string, CATEGORY_TYPE>{{"merkle", CATEGORY_TYPE::block_merkle}}};
+
+  const auto num_blocks = BlockId{10};
+  const auto horizon = std::uint64_t{3};
+  for (auto i = BlockId{1}; i <= num_blocks; ++i) {
+    BlockMerkleUpdates merkle_updates;
+    merkle_updates.addUpdate("merkle_key", "merkle_val" + std::to_string(i));
+    Updates updates;
+    updates.add("merkle", std::move(merkle_updates));
+    ASSERT_EQ(block_chain.addBlock(std::move(updates)), i);
+  }
+
+  // Blocks older than the horizon are archived, while they are still in the blockchain.
+  block_chain.setBlockArchive(archive, horizon);
+  const auto expected_last_archived = num_blocks - horizon;
+  for (auto i = 0; i < 100 && archive->lastBlockId() < expected_last_archived; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+  }
+  ASSERT_EQ(archive->lastBlockId(), expected_last_archived);
+  for (auto i = BlockId{1}; i <= expected_last_archived; ++i) {
+    ASSERT_EQ(archive->get(i), block_chain.getRawBlock(i));
+  }
+  ASSERT_FALSE(archive->get(expected_last_archived + 1).has_value());
+  ASSERT_EQ(block_chain.getGenesisBlockId(), 1);
+}
+
+TEST_F(categorized_kvbc, block_segments) {
+  const auto segments_path = rocksDbPath(defaultDbId) + "_segments";
+  fs::remove_all(segments_path);
+  const auto categories = std::map<std::string, CATEGORY_TYPE>{{"merkle", CATEGORY_TYPE::block_merkle},
+                                                               {"versioned", CATEGORY_TYPE::versioned_kv},
+                                                               {"immutable", CATEGORY_TYPE::immutable}};
+  const auto add_block = [](KeyValueBlockchain& block_chain, BlockId block_id) {
+    BlockMerkleUpdates merkle_updates;
+    merkle_updates.addUpdate("merkle_key", "merkle_val" + std::to_string(block_id));
+    VersionedUpdates ver_updates;
+    ver_updates.calculateRootHash(true);
+    ver_updates.addUpdate("ver_key", "ver_val" + std::to_string(block_id));
+    ImmutableUpdates immutable_updates;
+    immutable_updates.addUpdate("immutable_key" + std::to_string(block_id), {"immutable_val", {"tag"}});
+    Updates updates;
+    updates.add("merkle", std::move(merkle_updates));
+    updates.add("versioned", std::move(ver_updates));
+    updates.add("immutable", std::move(immutable_updates));
+    ASSERT_EQ(block_chain.addBlock(std::move(updates)), block_id);
+  };
+
+  bftEngine::ReplicaConfig::instance().kvbcBlockSegmentsPath = segments_path;
+  {
+    KeyValueBlockchain block_chain{db, true, categories};
+    for (auto i = BlockId{1}; i <= 5; ++i) {
+      add_block(block_chain, i);
+    }
+    // Rolled back blocks are gone from the store and added again.
+    block_chain.deleteLastReachableBlock();
+    ASSERT_FALSE(block_chain.getSerializedRawBlock(5).has_value());
+    add_block(block_chain, 5);
+    ASSERT_TRUE(block_chain.deleteBlock(1));
+    ASSERT_FALSE(block_chain.getSerializedRawBlock(1).has_value());
+    ASSERT_FALSE(block_chain.getSerializedRawBlock(6).has_value());
+  }
+  bftEngine::ReplicaConfig::instance().kvbcBlockSegmentsPath = "";
+
+  // The stored raw blocks are the same as the ones that are re-created from the blockchain.
+  auto raw_blocks = std::vector<RawBlock>{};
+  {
+    KeyValueBlockchain block_chain{db, true};
+    ASSERT_FALSE(block_chain.getSerializedRawBlock(2).has_value());
+    for (auto i = BlockId{2}; i <= 5; ++i) {
+      raw_blocks.push_back(*block_chain.getRawBlock(i));
+    }
+  }
+  bftEngine::ReplicaConfig::instance().kvbcBlockSegmentsPath = segments_path;
+  {
+    KeyValueBlockchain block_chain{db, true};
+    for (auto i = BlockId{2}; i <= 5; ++i) {
+      const auto record = block_chain.getSerializedRawBlock(i);
+      ASSERT_TRUE(record.has_value());
+      const auto& raw_block_ser = RawBlock::serialize(raw_blocks[i - 2]);
+      ASSERT_EQ(record->data(),
+                std::string_view(reinterpret_cast<const char*>(raw_block_ser.data()), raw_block_ser.size()));
+      ASSERT_EQ(block_chain.getRawBlock(i), raw_blocks[i - 2]);
+    }
+  }
+  bftEngine::ReplicaConfig::instance().kvbcBlockSegmentsPath = "";
+  fs::remove_all(segments_path);
+}
+
 }  // end namespace
 
 int main(int argc, char** argv) {
@@ -0,0 +1,147 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "gtest/gtest.h"
+#include "categorization/updates_recorder.h"
+#include "storage/test/storage_test_common.h"
+
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <string>
+
+using namespace concord::kvbc::categorization;
+
+namespace {
+
+class updates_recorder : public ::testing::Test {
+  void SetUp() override { removeRecordings(); }
+  void TearDown() override { removeRecordings(); }
+
+  void removeRecordings() {
+    const auto prefix = fs::path{path_prefix}.filename().string();
+    for (const auto& entry : fs::directory_iterator{fs::path{path_prefix}.parent_path()}) {
+      if (entry.path().filename().string().rfind(prefix, 0) == 0) fs::remove(entry.path());
+    }
+  }
+
+ protected:
+  static CategoryInput updates(const std::string& suffix) {
+    auto input = CategoryInput{};
+    input.kv["merkle"] = BlockMerkleInput{{{"mk" + suffix, "mv" + suffix}}, {"md" + suffix}};
+    input.kv["versioned"] = VersionedInput{{{"vk" + suffix, ValueWithFlags{"vv" + suffix, true}}}, {}, true};
+    input.kv["immutable"] = ImmutableInput{{{"ik" + suffix, ImmutableValueUpdate{"iv" + suffix, {"t"}}}}, false};
+    return input;
+  }
+
+ protected:
+  const std::string path_prefix{rocksDbPath(defaultDbId) + "_updates"};
+  const std::map<std::string, CATEGORY_TYPE> category_types{{"merkle", CATEGORY_TYPE::block_merkle},
+                                                            {"versioned", CATEGORY_TYPE::versioned_kv},
+                                                            {"immutable", CATEGORY_TYPE::immutable}};
+};
+
+TEST_F(updates_recorder, record_and_replay) {
+  auto path = std::string{};
+  {
+    auto recorder = UpdatesRecorder{path_prefix, category_types};
+    path = recorder.path();
+    recorder.record(updates("1"));
+    recorder.record(updates("2"));
+  }
+
+  auto recording = UpdatesRecording{path};
+  ASSERT_EQ(recording.categoryTypes(), category_types);
+  const auto record1 = recording.next();
+  ASSERT_TRUE(record1.has_value());
+  ASSERT_EQ(record1->updates, updates("1"));
+  const auto record2 = recording.next();
+  ASSERT_TRUE(record2.has_value());
+  ASSERT_EQ(record2->updates, updates("2"));
+  ASSERT_GE(record2->time, record1->time);
+  ASSERT_FALSE(recording.next().has_value());
+}
+
+TEST_F(updates_recorder, partial_last_record) {
+  auto path = std::string{};
+  {
+    auto recorder = UpdatesRecorder{path_prefix, category_types};
+    path = recorder.path();
+    recorder.record(updates("1"));
+    recorder.record(updates("2"));
+  }
+  fs::resize_file(path, fs::file_size(path) - 1);
+
+  auto recording = UpdatesRecording{path};
+  ASSERT_EQ(recording.next()->updates, updates("1"));
+  ASSERT_FALSE(recording.next().has_value());
+}
+
+TEST_F(updates_recorder, record_size_past_the_end_of_the_file) {
+  auto path = std::string{};
+  {
+    auto recorder = UpdatesRecorder{path_prefix, category_types};
+    path = recorder.path();
+    recorder.record(updates("1"));
+  }
+  {
+    // A corrupted header, claiming a record that is larger than the rest of the file.
+    auto file = std::ofstream{path, std::ios::out | std::ios::binary | std::ios::app};
+    const std::uint64_t header[] = {0, std::numeric_limits<std::uint64_t>::max()};
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file << "data";
+  }
+
+  auto recording = UpdatesRecording{path};
+  ASSERT_EQ(recording.next()->updates, updates("1"));
+  ASSERT_FALSE(recording.next().has_value());
+}
+
+TEST_F(updates_recorder, restart_keeps_the_previous_recording) {
+  auto first_path = std::string{};
+  {
+    auto recorder = UpdatesRecorder{path_prefix, category_types};
+    first_path = recorder.path();
+    recorder.record(updates("1"));
+  }
+  auto second_path = std::string{};
+  {
+    auto recorder = UpdatesRecorder{path_prefix, category_types};
+    second_path = recorder.path();
+    recorder.record(updates("2"));
+  }
+  ASSERT_NE(first_path, second_path);
+  ASSERT_EQ(first_path.rfind(path_prefix, 0), 0);
+
+  auto first = UpdatesRecording{first_path};
+  ASSERT_EQ(first.next()->updates, updates("1"));
+  ASSERT_FALSE(first.next().has_value());
+  auto second = UpdatesRecording{second_path};
+  ASSERT_EQ(second.next()->updates, updates("2"));
+  ASSERT_FALSE(second.next().has_value());
+}
+
+TEST_F(updates_recorder, not_a_recording) {
+  const auto path = path_prefix + ".not_a_recording";
+  { std::ofstream{path} << "not a recording"; }
+  ASSERT_THROW(UpdatesRecording{path}, std::runtime_error);
+  ASSERT_THROW(UpdatesRecording{path + "_non_existent"}, std::runtime_error);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -401,6 +401,69 @@ TEST_F(versioned_kv_category, get_proof) {
   { ASSERT_FALSE(cat.getProof(block1, "non-existing", out)); }
 }
 
+TEST_F(versioned_kv_category, get_multi_proof) {
+  const auto stale_on_update = false;
+  const auto block1 = 1;
+  const auto invalid_block = 2;
+
+  auto in = VersionedInput{};
+  in.calculate_root_hash = true;
+  in.kv["k1"] = ValueWithFlags{"v1", stale_on_update};
+  in.kv["k2"] = ValueWithFlags{"v2", stale_on_update};
+  in.kv["k3"] = ValueWithFlags{"v3", stale_on_update};
+  in.kv["k4"] = ValueWithFlags{"v4", stale_on_update};
+  const auto out = add(block1, std::move(in));
+  ASSERT_TRUE(out.root_hash);
+
+  // Non-consecutive keys.
+  {
+    const auto proof = cat.getMultiProof(block1, {"k3", "k1"}, out);
+    ASSERT_TRUE(proof);
+    ASSERT_EQ(proof->block_id, block1);
+    const auto expected_key_values = std::vector<std::pair<std::string, std::string>>{{"k1", "v1"}, {"k3", "v3"}};
+    ASSERT_EQ(proof->key_values, expected_key_values);
+    ASSERT_THAT(proof->key_value_indexes, ContainerEq(std::vector<std::size_t>{0, 2}));
+    ASSERT_EQ(proof->ordered_complement_kv_hashes.size(), 4);
+    ASSERT_THAT(*proof->calculateRootHash(), ContainerEq(*out.root_hash));
+  }
+
+  // Consecutive keys at the end.
+  {
+    const auto proof = cat.getMultiProof(block1, {"k3", "k4"}, out);
+    ASSERT_TRUE(proof);
+    ASSERT_THAT(proof->key_value_indexes, ContainerEq(std::vector<std::size_t>{4, 4}));
+    ASSERT_THAT(*proof->calculateRootHash(), ContainerEq(*out.root_hash));
+  }
+
+  // All keys.
+  {
+    const auto proof = cat.getMultiProof(block1, {"k1", "k2", "k3", "k4"}, out);
+    ASSERT_TRUE(proof);
+    ASSERT_TRUE(proof->ordered_complement_kv_hashes.empty());
+    ASSERT_THAT(*proof->calculateRootHash(), ContainerEq(*out.root_hash));
+  }
+
+  // The proof of a single key matches the single-key proof.
+  {
+    const auto proof = cat.getMultiProof(block1, {"k2"}, out);
+    ASSERT_TRUE(proof);
+    ASSERT_THAT(proof->ordered_complement_kv_hashes,
+                ContainerEq(cat.getProof(block1, "k2", out)->ordered_complement_kv_hashes));
+  }
+
+  // Tampering with a value changes the root hash.
+  {
+    auto proof = cat.getMultiProof(block1, {"k1", "k2"}, out);
+    ASSERT_TRUE(proof);
+    proof->key_values[1].second = "tampered";
+    ASSERT_FALSE(*proof->calculateRootHash() == *out.root_hash);
+  }
+
+  ASSERT_FALSE(cat.getMultiProof(invalid_block, {"k1", "k2"}, out));
+  ASSERT_FALSE(cat.getMultiProof(block1, {"k1", "non-existing"}, out));
+  ASSERT_FALSE(cat.getMultiProof(block1, {}, out));
+}
+
 TEST_F(versioned_kv_category, delete_key) {
   const auto stale_on_update = false;
 
@@ -176,6 +176,15 @@ class FakeStorage : public concord::kvbc::IReader {
     return {};
   }
 
+  std::optional<concord::kvbc::categorization::MultiKeyValueProof> getMultiProof(
+      const std::string &category_id,
+      BlockId block_id,
+      const std::vector<std::string> &keys,
+      const std::string &tag) const override {
+    ADD_FAILURE() << "getMultiProof() should not be called by this test";
+    return {};
+  }
+
   BlockId getGenesisBlockId() const override {
     ADD_FAILURE() << "get() should not be called by this test";
     return 0;
@@ -411,6 +411,13 @@ class TestStorage : public IReader, public IBlockAdder, public IBlocksDeleter {
     return bc_.getBlockUpdates(block_id);
   }
 
+  std::optional<categorization::MultiKeyValueProof> getMultiProof(const std::string &category_id,
+                                                                  BlockId block_id,
+                                                                  const std::vector<std::string> &keys,
+                                                                  const std::string &tag) const override {
+    return bc_.getMultiProof(category_id, block_id, keys, tag);
+  }
+
   BlockId getGenesisBlockId() const override {
     if (mockGenesisBlockId.has_value()) return mockGenesisBlockId.value();
     return bc_.getGenesisBlockId();
@@ -823,6 +830,58 @@ TEST_F(test_rocksdb, sm_handle_correct_prune_request) {
   ASSERT_TRUE(res);
 }
 
+TEST_F(test_rocksdb, sm_handle_prune_request_online) {
+  const auto replica_count = 4;
+  const auto num_blocks_to_keep = 30;
+  const auto replica_idx = 1;
+  const auto client_idx = 5;
+  const auto batch_blocks_num = 20;
+  replicaConfig.numBlocksToKeep_ = num_blocks_to_keep;
+  replicaConfig.replicaId = replica_idx;
+  replicaConfig.pruningEnabled_ = true;
+  replicaConfig.pruningOnline_ = true;
+  replicaConfig.replicaPrivateKey = privateKey_1;
+
+  TestStorage storage(db);
+  auto &blocks_deleter = storage;
+  InitBlockchainStorage(replica_count, storage);
+  auto registry = std::make_shared<concord::cron::CronTableRegistry>();
+  auto sm = PruningHandler{storage, storage, blocks_deleter, false, registry};
+
+  const auto latest_prunable_block_id = storage.getLastBlockId() - num_blocks_to_keep;
+  const auto req = ConstructPruneRequest(
+      client_idx, private_keys_of_replicas, latest_prunable_block_id, TICK_PERIOD_SECONDS, batch_blocks_num);
+  concord::messages::ReconfigurationResponse rres;
+  ASSERT_TRUE(sm.handle(req, 0, rres));
+
+  // Nothing is pruned before the first tick.
+  ASSERT_EQ(GENESIS_BLOCK_ID, storage.getGenesisBlockId());
+  const auto get_status = [&]() {
+    concord::messages::ReconfigurationResponse status_res;
+    sm.handle(concord::messages::PruneStatusRequest{}, 0, status_res);
+    return std::get<concord::messages::PruneStatus>(status_res.response);
+  };
+  ASSERT_TRUE(get_status().in_progress);
+
+  // Every tick prunes the next batch, until the latest prunable block is reached.
+  auto seq_num = std::uint64_t{1};
+  auto &table = (*registry)[PruningHandler::kPruningTicksComponentId];
+  while (storage.getGenesisBlockId() <= latest_prunable_block_id) {
+    const auto genesis_block_id = storage.getGenesisBlockId();
+    table.evaluate(concord::cron::Tick{PruningHandler::kPruningTicksComponentId, seq_num++});
+    ASSERT_EQ(std::min<BlockId>(genesis_block_id + batch_blocks_num, latest_prunable_block_id + 1),
+              storage.getGenesisBlockId());
+    ASSERT_EQ(storage.getGenesisBlockId() - 1, get_status().last_pruned_block);
+  }
+  ASSERT_FALSE(get_status().in_progress);
+  ASSERT_EQ(latest_prunable_block_id, get_status().last_pruned_block);
+
+  // Further ticks do nothing.
+  table.evaluate(concord::cron::Tick{PruningHandler::kPruningTicksComponentId, seq_num++});
+  ASSERT_EQ(latest_prunable_block_id + 1, storage.getGenesisBlockId());
+  replicaConfig.pruningOnline_ = false;
+}
+
 TEST_F(test_rocksdb, sm_handle_incorrect_prune_request) {
   const auto replica_count = 4;
   const auto num_blocks_to_keep = 30;
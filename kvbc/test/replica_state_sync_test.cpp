@@ -40,6 +40,7 @@ using concord::kvbc::kConcordInternalCategoryId;
 using concord::kvbc::ReplicaStateSyncImp;
 using concord::kvbc::categorization::CATEGORY_TYPE;
 using concord::kvbc::categorization::KeyValueBlockchain;
+using concord::kvbc::categorization::MultiKeyValueProof;
 using concord::kvbc::categorization::TaggedVersion;
 using concord::kvbc::categorization::Updates;
 using concord::kvbc::categorization::Value;
@@ -118,6 +119,13 @@ class replica_state_sync_test : public Test, public IReader {
     throw std::logic_error{"IReader::getBlockUpdates() should not be called"};
   }
 
+  std::optional<MultiKeyValueProof> getMultiProof(const std::string &category_id,
+                                                  BlockId block_id,
+                                                  const std::vector<std::string> &keys,
+                                                  const std::string &tag) const override {
+    throw std::logic_error{"IReader::getMultiProof() should not be called"};
+  }
+
   BlockId getGenesisBlockId() const override {
     throw std::logic_error{"IReader::getGenesisBlockId() should not be called"};
   }
@@ -53,16 +53,40 @@ void benchAllRootsOfUnity(size_t n, size_t r) {
     }
 }
 
+void benchScaling(const std::vector<G1>& bases, const std::vector<Fr>& exp, size_t r, size_t maxThreads) {
+    loginfo << "Scaling of the parallel multiexp of size " << bases.size() << " up to " << maxThreads << " threads" << endl;
+
+    double base = 0;
+    for(size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        std::string name = "Multiexp with " + std::to_string(numThreads) + " thread(s)";
+        AveragingTimer tn(name.c_str());
+        for(size_t i = 0; i < r; i++) {
+            tn.startLap();
+            libutt::multiExpParallel<G1>(bases.cbegin(), bases.cend(), exp.cbegin(), exp.cend(), numThreads);
+            tn.endLap();
+        }
+
+        double avg = static_cast<double>(tn.averageLapTime());
+        if(numThreads == 1) {
+            base = avg;
+        }
+
+        logperf << tn << endl;
+        logperf << "Speedup: " << base / avg << "x, efficiency: " << 100.0 * base / avg / static_cast<double>(numThreads) << "%" << endl;
+    }
+}
+
 int main(int argc, char *argv[]) {
     libutt::initialize(nullptr, 0);
     srand(static_cast<unsigned int>(time(nullptr)));
 
     if(argc < 3) {
-        cout << "Usage: " << argv[0] << " <n> <r>" << endl;
+        cout << "Usage: " << argv[0] << " <n> <r> [<max-threads>]" << endl;
         cout << endl;
         cout << "OPTIONS: " << endl;
         cout << "   <n>    the number of exponentiations to do in a single multiexp" << endl;  
         cout << "   <r>    the number of times to repeat the multiexps" << endl;  
+        cout << "   <max-threads>   if given, reports the scaling of the parallel multiexp for 1, 2, 4, ... up to this many threads" << endl;
         cout << endl;
 
         return 1;
@@ -96,5 +120,9 @@ int main(int argc, char *argv[]) {
     logperf << tn << endl;
     logperf << "Time per 1 exp: " << static_cast<double>(tn.averageLapTime()) / static_cast<double>(n) << " microseconds" << endl;
 
+    if(argc > 3) {
+        benchScaling(bases, exp, r, static_cast<size_t>(std::stoi(argv[3])));
+    }
+
     return 0;
 }
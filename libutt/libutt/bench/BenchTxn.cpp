@@ -8,6 +8,7 @@
 #include <utt/RandSigDKG.h>
 #include <utt/RegAuth.h>
 #include <utt/Tx.h>
+#include <utt/TxPrecompPool.h>
 #include <utt/Utils.h>
 #include <utt/Wallet.h>
 
@@ -43,6 +44,7 @@ public:
     RandSigPK bpk;
     std::vector<RandSigShareSK> bskShares;
     size_t numIters;
+    bool usePrecomp;    // if true, only measures the online part of TXN creation
     size_t budget;
     std::vector<Wallet> w;                // the two wallets for benchmarking TXNs
     AveragingTimer tc, tqv, tv, tp, tim, tcm;
@@ -51,7 +53,7 @@ public:
     /**
      * i.e., need exactlty 'thresh' signatures to aggregate
      */
-    BenchTxn(size_t thresh, size_t n, size_t numIters, bool isBudgeted)
+    BenchTxn(size_t thresh, size_t n, size_t numIters, bool isBudgeted, bool usePrecomp)
       : thresh(thresh),
         n(n),
         f(thresh, n),
@@ -60,6 +62,7 @@ public:
         bpk(f.getBankPK()),
         bskShares(f.getBankShareSKs()),
         numIters(numIters),
+        usePrecomp(usePrecomp),
         budget(2 * maxDenom * numIters),
         w(f.randomWallets(numWallets, 
             numCoins,
@@ -77,6 +80,12 @@ public:
 
         // TODO: test no budgets too
         testAssertTrue(isBudgeted);
+
+        if(usePrecomp) {
+            for(auto& wallet : w) {
+                wallet.precompPool = std::make_shared<TxPrecompPool>(p, wallet.ask, 1);
+            }
+        }
     }
 
 public:
@@ -103,6 +112,11 @@ public:
             //
             // Step 1: Measure TXN creation
             //
+            if(usePrecomp) {
+                // i.e., the offline part, which a wallet would do in the background
+                wallet_sender.precompPool->fill();
+            }
+
             tc.startLap();
             Tx tx = wallet_sender.spendTwoRandomCoins(pid_recip, true);
             tc.endLap();
@@ -200,9 +214,10 @@ int main(int argc, char *argv[]) {
     size_t t = 2, n = 4, numIters = 10;
     
     if(argc > 1 && (strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0)) {
-        cout << "Usage: " << argv[0] << " <t> <n> [<iters>]" << endl;
+        cout << "Usage: " << argv[0] << " <t> <n> [<iters>] [precomp]" << endl;
         cout << endl;
         cout << "Measures TXN performance on a (t, n) threshold setting by running <iters> TXNs" << endl;
+        cout << "If 'precomp' is given, TXN creation only measures the online part (see TxPrecompPool)" << endl;
         return 1;
     }
 
@@ -212,10 +227,11 @@ int main(int argc, char *argv[]) {
         n = static_cast<size_t>(std::stoi(argv[2]));
     if(argc > 3)
         numIters = static_cast<size_t>(std::stoi(argv[3]));
+    bool usePrecomp = (argc > 4 && strcmp(argv[4], "precomp") == 0);
 
     testAssertStrictlyLessThan(t, n);
 
-    BenchTxn b(t, n, numIters, true);
+    BenchTxn b(t, n, numIters, true, usePrecomp);
 
     // TODO: txn quick pay validation time
     b.bench();
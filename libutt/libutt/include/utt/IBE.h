@@ -152,6 +152,11 @@ namespace libutt {
              * Decrypts the coin value and the value commitment randomness and the identity commitment randomness.
              */
             std::tuple<bool, AutoBuf<unsigned char>> decrypt(const IBE::Ctxt& ctxt) const;
+
+            /**
+             * Same as above, but given the already-computed one-time key entropy T = e(ctxt.R, encsk).
+             */
+            std::tuple<bool, AutoBuf<unsigned char>> decrypt(const IBE::Ctxt& ctxt, const GT& T) const;
             
         public:
             bool operator==(const EncSK& o) const {
@@ -165,6 +170,31 @@ namespace libutt {
             }
         };
 
+        /**
+         * An EncSK whose side of the pairing (i.e., the Miller loop line coefficients for encsk) is precomputed once,
+         * so trial-decrypting many ciphertexts only pays for the G1 side and the final exponentiation of each pairing.
+         *
+         * Used by wallets scanning lots of TXN outputs for their coins. Safe to use from multiple threads.
+         */
+        class PrecompEncSK {
+        public:
+            EncSK sk;
+            libff::default_ec_pp::G2_precomp_type encskPrecomp;
+
+        public:
+            PrecompEncSK(const EncSK& sk)
+                : sk(sk), encskPrecomp(libff::default_ec_pp::precompute_G2(sk.encsk))
+            {}
+
+        public:
+            std::tuple<bool, AutoBuf<unsigned char>> decrypt(const IBE::Ctxt& ctxt) const {
+                GT T = libff::default_ec_pp::final_exponentiation(
+                    libff::default_ec_pp::miller_loop(libff::default_ec_pp::precompute_G1(ctxt.R), encskPrecomp));
+
+                return sk.decrypt(ctxt, T);
+            }
+        };
+
         /**
          * The IBE authority's master PK
          */
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <thread>
+
 #include <libff/algebra/curves/public_params.hpp>
 #include <libff/common/default_types/ec_pp.hpp>
 #include <libff/algebra/scalar_multiplication/multiexp.hpp>
@@ -173,6 +177,13 @@ namespace libutt {
 
     size_t getNumCores();
 
+    /**
+     * Sets the number of threads that multiExp uses for large multiexps (e.g., KZG commitments in range proofs).
+     * Defaults to getNumCores() when built with USE_MULTITHREADING and to 1 otherwise.
+     */
+    void setMultiExpThreads(size_t numThreads);
+    size_t getMultiExpThreads();
+
     /**
      * Returns the first n Nth roots of unity where N = 2^k is the smallest number such that n <= N.
      */
@@ -184,10 +195,75 @@ namespace libutt {
     //std::vector<Fr> random_poly(size_t degree);
 
     /**
-     * Performs a multi-exponentiation using libfqfft
+     * Multi-exponentiation of a compile-time number N of bases (see multiExp below), for the small multiexps of
+     * commitments and sigma-protocol verifiers. Uses Straus's (a.k.a. Shamir's) trick: all exponents are scanned
+     * together, one bit at a time, so all bases share the same doublings, and for each group of 4 bases the sums
+     * of all their subsets are precomputed, so each bit costs one addition per group of 4 bases. Everything is
+     * kept on the stack.
      */
-    template<class Group>
+    template<class Group, size_t N>
+    Group __multiExpStraus(const Group * bases, const Fr * exps) {
+        constexpr size_t W = 4;                   // bases per table of subset sums
+        constexpr size_t numTables = (N + W - 1) / W;
+
+        std::array<libff::bigint<Fr::num_limbs>, N> e;
+        size_t maxBits = 0;
+        for(size_t i = 0; i < N; i++) {
+            e[i] = exps[i].as_bigint();
+            maxBits = std::max(maxBits, e[i].num_bits());
+        }
+
+        // tables[t][mask] = \sum_{j : bit j of mask is set} bases[W*t + j]
+        std::array<std::array<Group, size_t(1) << W>, numTables> tables;
+        for(size_t t = 0; t < numTables; t++) {
+            size_t width = std::min(W, N - W*t);
+            tables[t][0] = Group::zero();
+            for(size_t j = 0; j < width; j++) {
+                size_t bit = size_t(1) << j;
+                for(size_t mask = bit; mask < 2*bit; mask++) {
+                    tables[t][mask] = tables[t][mask - bit] + bases[W*t + j];
+                }
+            }
+        }
+
+        Group r = Group::zero();
+        for(size_t b = maxBits; b-- > 0; ) {
+            r = r.dbl();
+
+            for(size_t t = 0; t < numTables; t++) {
+                size_t width = std::min(W, N - W*t);
+                size_t mask = 0;
+                for(size_t j = 0; j < width; j++) {
+                    mask |= static_cast<size_t>(e[W*t + j].test_bit(b)) << j;
+                }
+
+                if(mask != 0) {
+                    r = r + tables[t][mask];
+                }
+            }
+        }
+
+        return r;
+    }
+
+    /**
+     * Computes \sum_i exps[i] * bases[i] for a compile-time number 2 <= N <= 8 of bases, without heap allocations
+     * and without going through libff's generic multi_exp.
+     */
+    template<class Group, size_t N>
     Group multiExp(
+        const std::array<Group, N>& bases,
+        const std::array<Fr, N>& exps)
+    {
+        static_assert(N >= 2 && N <= 8, "fixed-size multiExp only supports 2 to 8 bases");
+        return __multiExpStraus<Group, N>(bases.data(), exps.data());
+    }
+
+    /**
+     * Performs a multi-exponentiation on the calling thread, using libff
+     */
+    template<class Group>
+    Group __multiExpSequential(
         typename std::vector<Group>::const_iterator base_begin,
         typename std::vector<Group>::const_iterator base_end,
         typename std::vector<Fr>::const_iterator exp_begin,
@@ -195,18 +271,13 @@ namespace libutt {
         )
     {
         long sz = base_end - base_begin;
-        long expsz = exp_end - exp_begin;
-        if(sz != expsz)
-            throw std::runtime_error("multiExp needs the same number of bases as exponents");
-        //size_t numCores = getNumCores();
-
         if(sz > 4) {
             if(sz > 16384) {
                 return libff::multi_exp<Group, Fr, libff::multi_exp_method_BDLO12>(base_begin, base_end,
-                    exp_begin, exp_end, 1);//numCores);
+                    exp_begin, exp_end, 1);
             } else {
                 return libff::multi_exp<Group, Fr, libff::multi_exp_method_bos_coster>(base_begin, base_end,
-                    exp_begin, exp_end, 1);//numCores);
+                    exp_begin, exp_end, 1);
             }
         } else {
             return libff::multi_exp<Group, Fr, libff::multi_exp_method_naive>(base_begin, base_end,
@@ -214,6 +285,99 @@ namespace libutt {
         }
     }
 
+    // With fewer bases per thread, starting the threads costs more than it saves
+    constexpr long _multiexp_min_bases_per_thread = 1024;
+
+    /**
+     * Splits the multiexp into numThreads chunks of (almost) the same size and computes each chunk on its own thread,
+     * with its own Pippenger buckets (i.e., libff's BDLO12 or Bos-Coster, depending on the size of the chunk). Then,
+     * adds up the partial results.
+     */
+    template<class Group>
+    Group multiExpParallel(
+        typename std::vector<Group>::const_iterator base_begin,
+        typename std::vector<Group>::const_iterator base_end,
+        typename std::vector<Fr>::const_iterator exp_begin,
+        typename std::vector<Fr>::const_iterator exp_end,
+        size_t numThreads
+        )
+    {
+        long sz = base_end - base_begin;
+        if(sz != exp_end - exp_begin)
+            throw std::runtime_error("multiExp needs the same number of bases as exponents");
+
+        long nt = std::max(1l, std::min(static_cast<long>(numThreads), sz));
+        long chunk = sz / nt, extra = sz % nt;
+
+        std::vector<Group> partial(static_cast<size_t>(nt), Group::zero());
+        std::vector<std::thread> threads;
+        long start = 0;
+        for(long t = 0; t < nt; t++) {
+            long end = start + chunk + (t < extra ? 1 : 0);
+            auto work = [&partial, base_begin, exp_begin, t, start, end]() {
+                partial[static_cast<size_t>(t)] = __multiExpSequential<Group>(
+                    base_begin + start, base_begin + end, exp_begin + start, exp_begin + end);
+            };
+
+            // the calling thread does the last chunk
+            if(t < nt - 1) {
+                threads.emplace_back(work);
+            } else {
+                work();
+            }
+            start = end;
+        }
+        assertEqual(start, sz);
+
+        for(auto& th : threads) {
+            th.join();
+        }
+
+        Group r = Group::zero();
+        for(auto& p : partial) {
+            r = r + p;
+        }
+        return r;
+    }
+
+    /**
+     * Performs a multi-exponentiation using libfqfft
+     */
+    template<class Group>
+    Group multiExp(
+        typename std::vector<Group>::const_iterator base_begin,
+        typename std::vector<Group>::const_iterator base_end,
+        typename std::vector<Fr>::const_iterator exp_begin,
+        typename std::vector<Fr>::const_iterator exp_end
+        )
+    {
+        long sz = base_end - base_begin;
+        long expsz = exp_end - exp_begin;
+        if(sz != expsz)
+            throw std::runtime_error("multiExp needs the same number of bases as exponents");
+
+        // small multiexps (e.g., of commitments) are faster without libff's dispatch
+        const Group * b = sz > 0 ? &*base_begin : nullptr;
+        const Fr * e = sz > 0 ? &*exp_begin : nullptr;
+        switch(sz) {
+            case 2: return __multiExpStraus<Group, 2>(b, e);
+            case 3: return __multiExpStraus<Group, 3>(b, e);
+            case 4: return __multiExpStraus<Group, 4>(b, e);
+            case 5: return __multiExpStraus<Group, 5>(b, e);
+            case 6: return __multiExpStraus<Group, 6>(b, e);
+            case 7: return __multiExpStraus<Group, 7>(b, e);
+            case 8: return __multiExpStraus<Group, 8>(b, e);
+            default: break;
+        }
+
+        size_t numThreads = std::min(getMultiExpThreads(), static_cast<size_t>(sz / _multiexp_min_bases_per_thread));
+        if(numThreads > 1) {
+            return multiExpParallel<Group>(base_begin, base_end, exp_begin, exp_end, numThreads);
+        }
+
+        return __multiExpSequential<Group>(base_begin, base_end, exp_begin, exp_end);
+    }
+
     /**
      * Performs a multi-exponentiation using libfqfft
      */
@@ -238,16 +402,12 @@ namespace libutt {
         const Fr& e3
         )
     {
-        std::vector<Group> b = { b1, b2 };
-        std::vector<Fr> exps = { e1, e2 };
-
         // b.c. we call this with b3 (or e3) set to the identity when we want to do a multiexp of size 2
         if(e3 != Fr::zero() && b3 != Group::zero()) {
-            b.push_back(b3);
-            exps.push_back(e3);
+            return multiExp<Group, 3>({ b1, b2, b3 }, { e1, e2, e3 });
         }
 
-        return multiExp(b, exps);
+        return multiExp<Group, 2>({ b1, b2 }, { e1, e2 });
     }
 
     template<class Group>
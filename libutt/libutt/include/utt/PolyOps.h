@@ -224,6 +224,15 @@ namespace libutt {
      */
     std::vector<Fr> lagrange_coefficients_naive(const std::vector<Fr>& allOmegas, const std::vector<size_t>& T);
 
+    /**
+     * Same as lagrange_coefficients_naive(n, T), but keeps the coefficients of the most recently used sets T in an
+     * LRU cache keyed by the bitmap of T. Combining signatures keeps on using the same few sets of signers, so the
+     * O(k^2) work (and the roots of unity) are computed once per set rather than once per signature.
+     *
+     * Thread-safe.
+     */
+    std::vector<Fr> lagrange_coefficients_cached(size_t n, const std::vector<size_t>& T);
+
     // WARNING: Slower than NTL::BuildFromRoots(), but not sure why
     ZZ_pX poly_from_roots_ntl(const vec_ZZ_p& roots, long startIncl, long endExcl);
 
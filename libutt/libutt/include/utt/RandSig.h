@@ -187,6 +187,36 @@ namespace libutt {
          */
         bool verify(const std::vector<Comm>& c, const RandSigSharePK& pk) const;
 
+        /**
+         * Checks many PS16 signature *shares* at once, using a single randomized multi-pairing.
+         *
+         * sigShares[j][k] is the share computed by the signer with PK pks[k] on the commitments in c[j]
+         * (e.g., c[j] are the commitments of output #j of a TXN).
+         *
+         * Each share's verification equation is raised to a random exponent and all equations are multiplied together,
+         * so pairings on the same G2 element are merged: this costs 1 + |pks| * (1 + ell) pairings, no matter how
+         * many commitment vectors are being verified, instead of |c| * |pks| * (2 + ell) pairings.
+         *
+         * Returns true if all shares verify (except with negligible probability).
+         *
+         * WARNING: We do NOT verify that each cc.hasCorrectG2(). We assume this is done in Tx::validate()
+         */
+        static bool batchVerify(
+            const std::vector<std::vector<Comm>>& c,
+            const std::vector<std::vector<RandSigShare>>& sigShares,
+            const std::vector<RandSigSharePK>& pks);
+
+        /**
+         * Same arguments as RandSigShare::batchVerify, but returns the indices (into 'pks') of the signers who
+         * produced at least one invalid share. Returns an empty vector if all shares verify.
+         *
+         * Only when the batch check fails does this fall back to verifying each signer's shares individually.
+         */
+        static std::vector<size_t> findInvalidSigners(
+            const std::vector<std::vector<Comm>>& c,
+            const std::vector<std::vector<RandSigShare>>& sigShares,
+            const std::vector<RandSigSharePK>& pks);
+
     public:
         /**
          * Aggregates a threshold signature from a subset of size 't' of the total 'n' replicas.
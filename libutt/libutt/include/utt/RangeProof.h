@@ -158,6 +158,23 @@ namespace libutt {
             static void initializeOmegas();
         };
 
+        /**
+         * The part of a range proof that only depends on the value (and fresh randomness), but not on its
+         * commitment: i.e., the \gamma(X) polynomial, the w_2(X) and w_3(X) polynomials and the KZG commitment
+         * to \gamma(X). This can be computed ahead of time for common denominations (see TxPrecomp).
+         *
+         * WARNING: Must be used for at most one range proof, since reusing \gamma(X) links the two proofs.
+         */
+        class Precomp {
+        public:
+            Fr val;
+            std::vector<Fr> gamma, w2, w3;
+            G1 kzgGamma;
+
+        public:
+            Precomp(const Params& p, const Fr& val);
+        };
+
     public:
         G1 kzgGamma, kzgQ;
         KzgPedEqProof kzgPed_pi;
@@ -190,6 +207,11 @@ namespace libutt {
          */
         RangeProof(const Params& p, const Comm& vcm, const Fr& val, const Fr& z);
 
+        /**
+         * Same as above, but finishes the proof from material computed ahead of time for 'val'.
+         */
+        RangeProof(const Params& p, const Comm& vcm, const Fr& val, const Fr& z, const Precomp& pre);
+
     public:
         /**
          * Verifies this range proof against the specified value commitment.
@@ -26,6 +26,37 @@ std::istream& operator>>(std::istream&, libutt::Tx&);
 
 namespace libutt {
 
+    /**
+     * Material for creating a Tx that does not depend on the recipients, so it can be computed ahead of time
+     * (e.g., by a TxPrecompPool in the background), leaving only the recipient-dependent work for Tx::Tx.
+     *
+     * WARNING: Must be used for at most one TXN, or the TXNs become linkable.
+     */
+    class TxPrecomp {
+    public:
+        Comm rcm;       // the sender's registration commitment, re-randomized with 'a'
+        RandSig regsig; // signature on 'rcm', re-randomized accordingly
+        Fr a;
+
+        std::vector<TxOut::Precomp> outs;   // randomness for the first outs.size() outputs
+
+        // range proof material for some of the output values; each one is used for at most one output
+        std::vector<RangeProof::Precomp> ranges;
+
+    public:
+        /**
+         * Precomputes the material for a TXN with up to 'numOuts' outputs (including the budget output), but
+         * without any range proof material.
+         */
+        static TxPrecomp random(const Params& p, const AddrSK& ask, size_t numOuts);
+
+        /**
+         * Returns the randomness for output #j, along with range proof material for 'val', if any (which is
+         * removed from 'ranges').
+         */
+        std::optional<TxOut::Precomp> takeOut(size_t j, const Fr& val);
+    };
+
     class Tx {
     public:
         bool isSplitOwnCoins;   // true when splitting your own coins; in this case, no budget coins are given as input, to save TXN creation & validation time
@@ -56,7 +87,8 @@ namespace libutt {
             std::optional<Coin> b,          // optional budget coin
             const std::vector<std::tuple<std::string, Fr>>& recip,
             const RandSigPK& bpk,   // only used for debugging
-            const RegAuthPK& rpk);  // only to encrypt for the recipients
+            const RegAuthPK& rpk,   // only to encrypt for the recipients
+            std::optional<TxPrecomp> pre = std::nullopt);   // material computed ahead of time, if any
 
     public:
         size_t getSize() const {
@@ -101,6 +133,11 @@ namespace libutt {
          */
         std::vector<Comm> getCommVector(size_t txoIdx, const G1& H) const;
 
+        /**
+         * Returns the commitment vectors of all outputs, as needed for batch-verifying their signature shares.
+         */
+        std::vector<std::vector<Comm>> getAllCommVectors() const;
+
         /**
          * If Tx::validate() passes, each BFT replica will compute a signature share on each output's coin.
          */
@@ -123,6 +160,19 @@ namespace libutt {
             return sigShare.verify(getCommVector(txoIdx, H), bpkShare);
         }
 
+        /**
+         * Used by BFT client to verify the signature shares on all outputs at once, with a single multi-pairing.
+         *
+         * sigShares[txoIdx][k] is the share on output #txoIdx computed by the replica whose PK is bpkShares[k].
+         */
+        bool verifySigShares(const std::vector<std::vector<RandSigShare>>& sigShares, const std::vector<RandSigSharePK>& bpkShares) const;
+
+        /**
+         * Same as Tx::verifySigShares, but returns the indices (into 'bpkShares') of the replicas that sent
+         * an invalid signature share on any output, so the client can ignore them. Empty if all shares verify.
+         */
+        std::vector<size_t> findInvalidSigShares(const std::vector<std::vector<RandSigShare>>& sigShares, const std::vector<RandSigSharePK>& bpkShares) const;
+
         /**
          * Attempts to claim the output specified by 'idx':
          * i.e., decrypt the denomination, identity commitment randomness and value commitment randomness from the coin's ciphertext.
@@ -141,6 +191,20 @@ namespace libutt {
             const std::vector<size_t>& signerIds,
             const RandSigPK& bpk) const;
 
+        /**
+         * Same as Tx::tryClaimCoin, but for an output already known to be for 'ask', whose ciphertext was
+         * decrypted into 'ptxt' (e.g., by Wallet::findMyOutputs).
+         */
+        Coin claimCoin(
+            const Params& p,
+            size_t txoIdx,
+            const AddrSK& ask,
+            const AutoBuf<unsigned char>& ptxt,
+            size_t n,
+            const std::vector<RandSigShare>& sigShares,
+            const std::vector<size_t>& signerIds,
+            const RandSigPK& bpk) const;
+
         std::string getHashHex() const {
             std::stringstream ss;
             ss << *this;
@@ -25,6 +25,34 @@ std::istream& operator>>(std::istream&, libutt::TxOut&);
 namespace libutt {
 
     class TxOut {
+    public:
+        /**
+         * Randomness for an output that does not depend on its recipient or value, along with the commitments
+         * to it, so it can be computed ahead of time (see TxPrecomp).
+         *
+         * WARNING: Must be used for at most one output.
+         */
+        class Precomp {
+        public:
+            Fr d;       // randomness for vcm_2
+            G1 g_d;     // g^d
+            Fr t;       // randomness for icm
+            G1 g_t;     // g^t
+
+            std::optional<RangeProof::Precomp> range;   // if set, must be for this output's value
+
+        public:
+            // 'g' is the randomness base of both ck_val and ck_tx
+            static Precomp random(const G1& g) {
+                Precomp pre;
+                pre.d = Fr::random_element();
+                pre.g_d = pre.d * g;
+                pre.t = Fr::random_element();
+                pre.g_t = pre.t * g;
+                return pre;
+            }
+        };
+
     public:
         Fr coin_type;
         Fr exp_date;
@@ -110,7 +138,8 @@ namespace libutt {
             const Fr& val,
             const Fr& z,
             bool icmPok,
-            bool hasRangeProof
+            bool hasRangeProof,
+            const std::optional<Precomp>& pre = std::nullopt
         );
 
     protected:
@@ -126,6 +155,7 @@ namespace libutt {
             const Fr& z,
             bool icmPok,
             bool hasRangeProof,
+            const std::optional<Precomp>& pre,
             // extra delegation parameters
             CommKey ck_tx,
             Fr pid_hash_recip
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <utt/Address.h>
+#include <utt/Params.h>
+#include <utt/Tx.h>
+
+namespace libutt {
+
+    /**
+     * A pool of TxPrecomp's for a single user, which can be refilled by a background thread, so that creating
+     * a TXN (see Wallet::spendTwoRandomCoins) only has to do the recipient-dependent work.
+     *
+     * Besides the per-TXN randomness, it keeps range proof material for a few common denominations, which is
+     * attached to a TxPrecomp when a TXN pays out one of these values.
+     *
+     * All methods are thread-safe.
+     */
+    class TxPrecompPool {
+    public:
+        // Two outputs for the recipient and the change, plus the budget output
+        constexpr static size_t DefaultNumOuts = 3;
+
+    protected:
+        Params p;
+        AddrSK ask;
+        size_t numOuts;
+        size_t capacity;                // how many TxPrecomp's to keep ready
+        std::vector<size_t> denoms;     // common denominations to precompute range proof material for
+        size_t perDenom;                // how many range proofs to keep ready for each denomination
+
+        mutable std::mutex mutex;
+        std::condition_variable refill;
+        std::deque<TxPrecomp> ready;
+        std::map<size_t, std::deque<RangeProof::Precomp>> readyRanges;
+        // slots reserved by computeOne() for items that are being computed, so that fill() and the background thread
+        // don't compute the same missing item
+        size_t computing = 0;
+        std::map<size_t, size_t> computingRanges;
+
+        bool stopped = false;
+        std::thread worker;
+
+        size_t hits = 0, misses = 0, rangeHits = 0;
+
+    public:
+        TxPrecompPool(const Params& p, const AddrSK& ask, size_t capacity,
+            const std::vector<size_t>& denoms = {}, size_t perDenom = 1, size_t numOuts = DefaultNumOuts);
+
+        ~TxPrecompPool() { stop(); }
+
+        TxPrecompPool(const TxPrecompPool&) = delete;
+        TxPrecompPool& operator=(const TxPrecompPool&) = delete;
+
+    public:
+        /**
+         * Starts a background thread that keeps the pool full. The pool only needs refilling after take() is called.
+         */
+        void start();
+
+        /**
+         * Stops the background thread, if any. Material that is already in the pool can still be taken.
+         */
+        void stop();
+
+        /**
+         * Synchronously fills the pool up to its capacity (e.g., while the wallet is idle, instead of start()).
+         * Items that the background thread is computing at the same time are not computed again.
+         */
+        void fill();
+
+        /**
+         * Returns material for a TXN that pays out the specified values, with range proof material attached for
+         * the values that are common denominations (if available). If the pool is empty, computes the
+         * recipient-independent material inline, so this never blocks on the background thread.
+         */
+        TxPrecomp take(const std::vector<size_t>& vals);
+
+    public:
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return ready.size();
+        }
+
+        size_t numHits() const { std::lock_guard<std::mutex> lock(mutex); return hits; }
+        size_t numMisses() const { std::lock_guard<std::mutex> lock(mutex); return misses; }
+        size_t numRangeHits() const { std::lock_guard<std::mutex> lock(mutex); return rangeHits; }
+
+    protected:
+        bool isFull() const;    // WARNING: 'mutex' must be held; counts the items that are being computed
+
+        /**
+         * Reserves a slot for one missing item (either a TxPrecomp or a range proof precomputation) and computes it
+         * outside the lock. Returns false if nothing was missing.
+         */
+        bool computeOne();
+
+        void workerLoop();
+    };
+
+} // end of namespace libutt
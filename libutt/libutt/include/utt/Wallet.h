@@ -1,14 +1,21 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <tuple>
 #include <vector>
 
 #include <utt/Address.h>
 #include <utt/Coin.h>
 
+#include <xutils/AutoBuf.h>
+
 namespace libutt {
     class RandSig;
+    class RandSigShare;
     class RegAuthPK;
     class Tx;
+    class TxPrecompPool;
     class Wallet;
 }
 
@@ -29,6 +36,24 @@ namespace libutt {
         std::vector<Coin> coins;        // normal coins
         std::optional<Coin> budgetCoin; // single budget coin
 
+        // material for creating this wallet's TXNs, computed ahead of time (shared by copies of this wallet; never serialized)
+        std::shared_ptr<TxPrecompPool> precompPool;
+
+    public:
+        /**
+         * An output of a scanned TXN that is for this wallet's owner, along with its decrypted ciphertext.
+         */
+        struct FoundOutput {
+            size_t txIdx;
+            size_t txoIdx;
+            AutoBuf<unsigned char> ptxt;
+        };
+
+        /**
+         * Returns the signature shares on output #txoIdx of TXN #txIdx and the IDs of the replicas who computed them.
+         */
+        using SigShareFetcher = std::function<std::tuple<std::vector<RandSigShare>, std::vector<size_t>>(size_t txIdx, size_t txoIdx)>;
+
     public:
         void addNormalCoin(const Coin& c);
         void setBudgetCoin(const Coin& c);
@@ -42,6 +67,13 @@ namespace libutt {
             }
         }
 
+        /**
+         * Starts precomputing the recipient-independent material for this wallet's TXNs in a background thread,
+         * keeping 'capacity' TXNs' worth of it ready, plus range proof material for the 'denoms' values.
+         * TXN creation (e.g., Wallet::spendTwoRandomCoins) will then only do the recipient-dependent work.
+         */
+        void startPrecomputing(size_t capacity, const std::vector<size_t>& denoms = {});
+
         size_t numCoins() const { return coins.size(); }
 
         size_t totalValue() const { return Coin::totalValue(coins); }
@@ -59,6 +91,22 @@ namespace libutt {
          */
         Tx spendTwoRandomCoins(const std::string& pid, bool removeFromWallet);
 
+        /**
+         * Trial-decrypts every output of every TXN in 'txs' and returns the ones for this wallet's owner.
+         *
+         * The pairing precomputation for this wallet's encryption SK is shared by all ciphertexts and, when
+         * built with USE_MULTITHREADING, outputs are decrypted in parallel.
+         */
+        std::vector<FoundOutput> findMyOutputs(const std::vector<Tx>& txs) const;
+
+        /**
+         * Scans a batch of TXNs (e.g., after catching up with the ledger) and adds the coins sent to this wallet's owner.
+         *
+         * Signature shares are only needed for outputs that turn out to be ours, so they are fetched lazily via
+         * 'getSigShares'. 'n' is the total number of replicas. Returns the number of coins added.
+         */
+        size_t scan(const std::vector<Tx>& txs, size_t n, const SigShareFetcher& getSigShares);
+
         const std::string& getUserPid() const { return ask.pid; }
 
         void __print() const;
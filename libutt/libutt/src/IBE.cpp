@@ -159,8 +159,12 @@ namespace libutt {
         G1 R = ctxt.R;    // denoted by 'u' in [Srin10], pg 80
 
         // one time key entropy will be T = e(g_1^r, H_1(pid)^\msk) = e(g_1, g_2)^{r h \msk}
-        GT T = ReducedPairing(R, encsk);
-        
+        return decrypt(ctxt, ReducedPairing(R, encsk));
+    }
+
+    std::tuple<bool, AutoBuf<unsigned char>> IBE::EncSK::decrypt(const IBE::Ctxt& ctxt, const GT& T) const {
+        G1 R = ctxt.R;
+
         size_t ptxtSize = ctxt.buf1.size();
         AutoBuf<unsigned char> otk1, otk2;
         std::tie(otk1, otk2) = Params::hashToOneTimeKeys(T, ptxtSize);
@@ -1,6 +1,7 @@
 #include <utt/Configuration.h>
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
 #include <fstream>
 #include <functional>
@@ -229,6 +230,27 @@ namespace libutt {
         return numCores;
     }
 
+    namespace {
+        // 0 means the default
+        std::atomic<size_t> multiExpThreads{0};
+    }
+
+    void setMultiExpThreads(size_t numThreads) {
+        multiExpThreads = numThreads;
+    }
+
+    size_t getMultiExpThreads() {
+        size_t numThreads = multiExpThreads;
+        if(numThreads != 0) {
+            return numThreads;
+        }
+#ifdef USE_MULTITHREADING
+        return getNumCores();
+#else
+        return 1;
+#endif
+    }
+
     std::vector<Fr> get_all_roots_of_unity(size_t n) {
         if(n < 1)
             throw std::runtime_error("Cannot get 0th root-of-unity");
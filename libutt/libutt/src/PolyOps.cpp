@@ -3,6 +3,10 @@
 #include <utt/PolyOps.h>
 #include <utt/NtlLib.h>
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 #include <xassert/XAssert.h>
 
 namespace libutt {
@@ -116,6 +120,58 @@ std::vector<Fr> lagrange_coefficients_naive(const std::vector<Fr>& allOmegas, co
     return __lagrange_coefficients_naive(allOmegas, someOmegas, T);
 }
 
+std::vector<Fr> lagrange_coefficients_cached(size_t n, const std::vector<size_t>& T) {
+    // Number of distinct sets of signers for which we keep the coefficients
+    constexpr size_t capacity = 64;
+    // The coefficients are indexed by signer ID (i.e., a table of size N), so they can be looked up in T's order
+    using Entry = std::pair<std::vector<bool>, std::vector<Fr>>;
+
+    static std::mutex mutex;
+    static std::list<Entry> lru;    // most recently used at the front
+    static std::unordered_map<std::vector<bool>, std::list<Entry>::iterator> entries;
+
+    // the coefficients only depend on N and on T, so the bitmap of T over N bits is the key
+    size_t N = Utils::smallestPowerOfTwoAbove(n);
+    std::vector<bool> key(N, false);
+    for(size_t i : T) {
+        assertStrictlyLessThan(i, N);
+        key[i] = true;
+    }
+
+    std::vector<Fr> L(T.size());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if(it != entries.end()) {
+            lru.splice(lru.begin(), lru, it->second);
+            auto& table = it->second->second;
+            for(size_t j = 0; j < T.size(); j++) {
+                L[j] = table[T[j]];
+            }
+            return L;
+        }
+    }
+
+    L = lagrange_coefficients_naive(n, T);
+
+    std::vector<Fr> table(N, Fr::zero());
+    for(size_t j = 0; j < T.size(); j++) {
+        table[T[j]] = L[j];
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if(entries.count(key) == 0) {
+        if(lru.size() == capacity) {
+            entries.erase(lru.back().first);
+            lru.pop_back();
+        }
+        lru.emplace_front(key, std::move(table));
+        entries[key] = lru.begin();
+    }
+
+    return L;
+}
+
 ZZ_pX poly_from_roots_ntl(const vec_ZZ_p& roots, long startIncl, long endExcl) {
     // base case is startIncl == endExcl - 1, so return (x - root)
     if(startIncl == endExcl - 1) {
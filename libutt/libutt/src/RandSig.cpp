@@ -4,6 +4,8 @@
 #include <utt/PolyOps.h>
 #include <utt/RandSig.h>
 
+#include <xutils/Log.h>
+
 std::ostream& operator<<(std::ostream& out, const libutt::RandSig& sig) {
     out << sig.s1 << endl;
     out << sig.s2 << endl;
@@ -194,6 +196,112 @@ namespace libutt {
         //return lhs == rhs;
     }
     
+    bool RandSigShare::batchVerify(
+        const std::vector<std::vector<Comm>>& c,
+        const std::vector<std::vector<RandSigShare>>& sigShares,
+        const std::vector<RandSigSharePK>& pks)
+    {
+        assertEqual(c.size(), sigShares.size());
+
+        if(c.empty() || pks.empty())
+            return true;
+
+        size_t numComms = c.size();
+        size_t numSigners = pks.size();
+        size_t ell = c[0].size();
+
+        // c[j][i] as G1 elements, grouped by i, so we can multiexp them for each signer below
+        std::vector<std::vector<G1>> cm(ell);
+        for(size_t i = 0; i < ell; i++)
+            cm[i].reserve(numComms);
+
+        for(size_t j = 0; j < numComms; j++) {
+            assertEqual(c[j].size(), ell);
+            assertEqual(sigShares[j].size(), numSigners);
+
+            for(size_t i = 0; i < ell; i++)
+                cm[i].push_back(c[j][i].asG1());
+        }
+
+        std::vector<G1> g1s;
+        std::vector<G2> g2s;
+        g1s.reserve(1 + numSigners * (1 + ell));
+        g2s.reserve(1 + numSigners * (1 + ell));
+
+        // The e(s2, -g_tilde) terms of signers who share the same g_tilde (i.e., all of them, when the shares
+        // come from the same DKG) are merged into a single pairing.
+        std::vector<G1> s2s;
+        std::vector<Fr> s2exps;
+        s2s.reserve(numComms * numSigners);
+        s2exps.reserve(numComms * numSigners);
+
+        std::vector<G1> s1s(numComms);
+        for(size_t k = 0; k < numSigners; k++) {
+            auto& pk = pks[k];
+            assertEqual(pk.Y_tilde.size(), ell);
+
+            // the randomizer for share sigShares[j][k]
+            auto rho = random_field_elems(numComms);
+
+            for(size_t j = 0; j < numComms; j++)
+                s1s[j] = sigShares[j][k].s1;
+
+            if(pk.g_tilde == pks[0].g_tilde) {
+                for(size_t j = 0; j < numComms; j++) {
+                    s2s.push_back(sigShares[j][k].s2);
+                    s2exps.push_back(rho[j]);
+                }
+            } else {
+                std::vector<G1> s2(numComms);
+                for(size_t j = 0; j < numComms; j++)
+                    s2[j] = sigShares[j][k].s2;
+
+                g1s.push_back(multiExp(s2, rho));
+                g2s.push_back(-pk.g_tilde);
+            }
+
+            g1s.push_back(multiExp(s1s, rho));
+            g2s.push_back(pk.X_tilde);
+
+            for(size_t i = 0; i < ell; i++) {
+                g1s.push_back(multiExp(cm[i], rho));
+                g2s.push_back(pk.Y_tilde[i]);
+            }
+        }
+
+        g1s.push_back(multiExp(s2s, s2exps));
+        g2s.push_back(-pks[0].g_tilde);
+
+        return MultiPairing(g1s, g2s) == GT::one();
+    }
+
+    std::vector<size_t> RandSigShare::findInvalidSigners(
+        const std::vector<std::vector<Comm>>& c,
+        const std::vector<std::vector<RandSigShare>>& sigShares,
+        const std::vector<RandSigSharePK>& pks)
+    {
+        std::vector<size_t> badSigners;
+        if(batchVerify(c, sigShares, pks))
+            return badSigners;
+
+        // Some share is bad, so check every signer separately: a signer's shares on all commitment vectors
+        // can still be batched together.
+        for(size_t k = 0; k < pks.size(); k++) {
+            std::vector<std::vector<RandSigShare>> signerShares;
+            signerShares.reserve(sigShares.size());
+            for(auto& shares : sigShares) {
+                signerShares.push_back({ shares.at(k) });
+            }
+
+            if(!batchVerify(c, signerShares, { pks[k] })) {
+                logdbg << "Signer #" << k << " sent an invalid signature share" << endl;
+                badSigners.push_back(k);
+            }
+        }
+
+        return badSigners;
+    }
+
     RandSig RandSigShare::aggregate(size_t n, const std::vector<RandSigShare>& sigShares, const std::vector<size_t>& signerIds, const CommKey& ck, const std::vector<Fr>& r) {
         RandSig sig;
 
@@ -210,7 +318,7 @@ namespace libutt {
             s2.push_back(ss.s2);
         }
 
-        auto lagr = lagrange_coefficients_naive(n, signerIds);
+        auto lagr = lagrange_coefficients_cached(n, signerIds);
 
         sig.s2 = multiExp(s2, lagr);
 
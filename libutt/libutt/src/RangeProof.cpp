@@ -352,35 +352,49 @@ namespace libutt {
         return KzgPedEqProof(kpp, p.ck_val, gammaKzg, val, kzgWit, vcm, z);
     }
     
-    RangeProof::RangeProof(const Params& p, const Comm& vcm, const Fr& val, const Fr& z) {
+    RangeProof::Precomp::Precomp(const Params& p, const Fr& val)
+        : val(val)
+    {
         size_t val64 = val.as_ulong();
         static_assert(sizeof(val64) == Params::MAX_BITS/8, "Expected Fr::as_ulong() to return 64-bit value");
 
         size_t N = Params::MAX_BITS;
         
         // gamma has degree N + 1
-        const auto gamma = __computeGamma(val64, N, val);
+        gamma = __computeGamma(val64, N, val);
         assertEqual(gamma.size() - 1, N + 1);
 
-        auto w2 = __computeW2(gamma);
+        w2 = __computeW2(gamma);
         assertEqual(w2.size() - 1, 3*N + 1);
         __assertZeroOnOmegas(w2);
-        auto w3 = __computeW3(gamma);
+        w3 = __computeW3(gamma);
         assertEqual(w3.size() - 1, 2*N + 3);
         __assertZeroOnOmegas(w3);
 
+        // commit to \gamma
+        kzgGamma = KZG::commit<G1>(p.kpp, gamma);
+    }
+
+    RangeProof::RangeProof(const Params& p, const Comm& vcm, const Fr& val, const Fr& z)
+        : RangeProof(p, vcm, val, z, Precomp(p, val))
+    {}
+
+    RangeProof::RangeProof(const Params& p, const Comm& vcm, const Fr& val, const Fr& z, const Precomp& pre) {
+        assertEqual(pre.val, val);
+        auto& gamma = pre.gamma;
+
         // Fiat-Shamir randomness \tau and \rho
         Fr tau, rho;
         std::tie(tau, rho) = deriveTauAndRho(p, vcm);
 
         // w = w_2 + \tau w_3
         std::vector<Fr> w = poly_add(
-            w2,
-            poly_scale(tau, w3)
+            pre.w2,
+            poly_scale(tau, pre.w3)
         );
 
-        // commit to \gamma and prove \gamma(1) agrees with val committed in vcm
-        kzgGamma = KZG::commit<G1>(p.kpp, gamma);
+        // prove \gamma(1) agrees with val committed in vcm
+        kzgGamma = pre.kzgGamma;
         kzgPed_pi = __computeKzgPedAgreementProof(p, vcm, val, z, kzgGamma, gamma);
 
         // compute quotient q(X) that proves that w(X) is zero at all roots of unity
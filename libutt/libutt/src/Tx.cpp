@@ -45,13 +45,49 @@ std::istream& operator>>(std::istream& in, libutt::Tx& tx) {
 
 namespace libutt {
 
+    TxPrecomp TxPrecomp::random(const Params& p, const AddrSK& ask, size_t numOuts) {
+        TxPrecomp pre;
+
+        pre.rcm = ask.rcm;      // has randomness zero
+        pre.regsig = ask.rs;    // will be rerandomized
+
+        // re-randomize rcm, with randomness 'a', and then regsig
+        pre.a = Fr::random_element();
+        pre.rcm.rerandomize(p.getRegCK(), pre.a);
+        pre.regsig.rerandomize(pre.a, Fr::random_element());
+
+        for(size_t j = 0; j < numOuts; j++) {
+            pre.outs.push_back(TxOut::Precomp::random(p.getValCK().getGen1()));
+        }
+
+        return pre;
+    }
+
+    std::optional<TxOut::Precomp> TxPrecomp::takeOut(size_t j, const Fr& val) {
+        if(j >= outs.size()) {
+            return std::nullopt;
+        }
+
+        TxOut::Precomp out = outs[j];
+        for(auto it = ranges.begin(); it != ranges.end(); it++) {
+            if(it->val == val) {
+                out.range = std::move(*it);
+                ranges.erase(it);
+                break;
+            }
+        }
+
+        return out;
+    }
+
     Tx::Tx(const Params& p, 
         const AddrSK& ask,
         const std::vector<Coin>& coins, 
         std::optional<Coin> b,   // set to std::nullopt, if none
         const std::vector<std::tuple<std::string, Fr>>& recip,
         const RandSigPK& bpk,
-        const RegAuthPK& rpk)
+        const RegAuthPK& rpk,
+        std::optional<TxPrecomp> pre)
     {
 #ifndef NDEBUG
         (void)bpk;
@@ -141,15 +177,14 @@ namespace libutt {
          *  - Copy pre-computed nullifier + consistency proof
          *  - Copy pre-computed (input) value commitment (VCM), whose randomness is later correlated with output VCMs
          */
-        rcm = ask.rcm;          // has randomness zero
-        regsig = ask.rs;        // will be rerandomized
-
-        assertTrue(regsig.verify(rcm, rpk.vk));
+        if(!pre.has_value()) {
+            pre = TxPrecomp::random(p, ask, 0);
+        }
 
-        // re-randomize rcm, with randomness 'a', and then regsig
-        Fr a = Fr::random_element();    // we need to pass this into the SplitProof constructor
-        rcm.rerandomize(p.getRegCK(), a);
-        regsig.rerandomize(a, Fr::random_element());
+        // re-randomized rcm, with randomness 'a', and regsig
+        rcm = pre->rcm;
+        regsig = pre->regsig;
+        Fr a = pre->a;    // we need to pass this into the SplitProof constructor
 
         assertTrue(regsig.verify(rcm, rpk.vk));
 
@@ -230,7 +265,8 @@ namespace libutt {
                 val_recip,
                 z_recip.at(j),
                 icmPok,
-                hasRangeProof);
+                hasRangeProof,
+                pre->takeOut(j, val_recip));
 
             //z_sum_out = z_sum_out + z_recip[j];
         }
@@ -268,7 +304,8 @@ namespace libutt {
                 val_budget_out,
                 z_budget_recip,
                 icmPok,
-                hasRangeProof);
+                hasRangeProof,
+                pre->takeOut(m, val_budget_out));
 
             // add the output budget coin as one of the 'forMeTxos'
             forMeOutputs.insert(outs.size() - 1);
@@ -554,6 +591,28 @@ namespace libutt {
         return { txo.icm, scm, txo.vcm_2, tcm, dcm };
     }
 
+    std::vector<std::vector<Comm>> Tx::getAllCommVectors() const {
+        std::vector<std::vector<Comm>> c;
+        c.reserve(outs.size());
+
+        for(size_t txoIdx = 0; txoIdx < outs.size(); txoIdx++) {
+            // NOTE: H is cached if the client created this TXN (see Tx::verifySigShare)
+            G1 H = outs[txoIdx].H.has_value() ? *outs[txoIdx].H : deriveRandSigBase(txoIdx);
+            c.push_back(getCommVector(txoIdx, H));
+        }
+
+        return c;
+    }
+
+    bool Tx::verifySigShares(const std::vector<std::vector<RandSigShare>>& sigShares, const std::vector<RandSigSharePK>& bpkShares) const {
+        assertEqual(sigShares.size(), outs.size());
+        return RandSigShare::batchVerify(getAllCommVectors(), sigShares, bpkShares);
+    }
+
+    std::vector<size_t> Tx::findInvalidSigShares(const std::vector<std::vector<RandSigShare>>& sigShares, const std::vector<RandSigSharePK>& bpkShares) const {
+        assertEqual(sigShares.size(), outs.size());
+        return RandSigShare::findInvalidSigners(getAllCommVectors(), sigShares, bpkShares);
+    }
     
     RandSigShare Tx::shareSignCoin(size_t txoIdx, const RandSigShareSK& bskShare) const {
         // We have icm and vcm commitments under CK (H, g), but we also need commitments
@@ -590,10 +649,6 @@ namespace libutt {
         // WARNING: Use std::vector<TxOut>::at(j) so it can throw if out of bounds
         auto& txo = outs.at(txoIdx);
 
-        Fr val; // coin value
-        Fr d;   // vcm_2 value commitment randomness
-        Fr t;   // identity commitment randomness
-
         // decrypt the ciphertext
         bool forMe;
         AutoBuf<unsigned char> ptxt;
@@ -606,6 +661,25 @@ namespace libutt {
             logtrace << "TXO #" << txoIdx << " is for pid '" << ask.pid << "'!" << endl;
         }
 
+        return claimCoin(p, txoIdx, ask, ptxt, n, sigShares, signerIds, bpk);
+    }
+
+    Coin Tx::claimCoin(
+        const Params& p,
+        size_t txoIdx,
+        const AddrSK& ask,
+        const AutoBuf<unsigned char>& ptxt,
+        size_t n,
+        const std::vector<RandSigShare>& sigShares,
+        const std::vector<size_t>& signerIds,
+        const RandSigPK& bpk)
+    const {
+        auto& txo = outs.at(txoIdx);
+
+        Fr val; // coin value
+        Fr d;   // vcm_2 value commitment randomness
+        Fr t;   // identity commitment randomness
+
         // parse the plaintext as (value, vcm_2 randomness, icm randomness)
         auto vdt = bytesToFrs(ptxt);
         assertEqual(vdt.size(), 3);
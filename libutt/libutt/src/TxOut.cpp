@@ -69,7 +69,8 @@ namespace libutt {
         const Fr& val,
         const Fr& z,
         bool icmPok,
-        bool hasRangeProof
+        bool hasRangeProof,
+        const std::optional<Precomp>& pre
     )
         : TxOut(
             ck_val,
@@ -83,6 +84,7 @@ namespace libutt {
             z,
             icmPok,
             hasRangeProof,
+            pre,
             // extra delegation parameters
             CommKey({ H, ck_val.getGen1() }),
             AddrSK::pidHash(pid)
@@ -101,6 +103,7 @@ namespace libutt {
         const Fr& z,
         bool icmPok,
         bool hasRangeProof,
+        const std::optional<Precomp>& pre,
         // extra delegation parameters
         CommKey ck_tx,
         Fr pid_hash_recip
@@ -111,12 +114,14 @@ namespace libutt {
           //z(z),
           vcm_1(Comm::create(ck_val, { val, z }, false)),
           // need to pick randomness d for vcm_2 and save it to do proofs
-          d(Fr::random_element()),
-          vcm_2(Comm::create(ck_tx, { val, d }, false)),
+          d(pre.has_value() ? pre->d : Fr::random_element()),
+          // i.e., H^val g^d, with g^d precomputed if possible
+          vcm_2(pre.has_value() ? Comm(val * H + pre->g_d) : Comm::create(ck_tx, { val, d }, false)),
           vcm_eq_pi(ck_val, vcm_1, z, ck_tx, vcm_2, d, val),
           // need to pick randomness t for icm and save it to do proofs
-          t(Fr::random_element()),
-          icm(Comm::create(ck_tx, { pid_hash_recip, t }, false)),
+          t(pre.has_value() ? pre->t : Fr::random_element()),
+          // i.e., H^pid_hash g^t, with g^t precomputed if possible
+          icm(pre.has_value() ? Comm(pid_hash_recip * H + pre->g_t) : Comm::create(ck_tx, { pid_hash_recip, t }, false)),
           ctxt(mpk.encrypt(pid, frsToBytes({ val, d, t })))
     {
         if(icmPok) {
@@ -124,7 +129,11 @@ namespace libutt {
         }
 
         if(hasRangeProof) {
-          range_pi.emplace(rpp, vcm_1, val, z);
+            if(pre.has_value() && pre->range.has_value()) {
+                range_pi.emplace(rpp, vcm_1, val, z, *pre->range);
+            } else {
+                range_pi.emplace(rpp, vcm_1, val, z);
+            }
         }
 
         logtrace << "val: " << val << endl;
@@ -0,0 +1,175 @@
+#include <utt/Configuration.h>
+
+#include <utt/TxPrecompPool.h>
+
+#include <chrono>
+
+#include <xutils/Log.h>
+
+namespace libutt {
+
+    TxPrecompPool::TxPrecompPool(const Params& p, const AddrSK& ask, size_t capacity,
+        const std::vector<size_t>& denoms, size_t perDenom, size_t numOuts)
+        : p(p), ask(ask), numOuts(numOuts), capacity(capacity), denoms(denoms), perDenom(perDenom)
+    {
+        for(auto denom : denoms) {
+            readyRanges[denom];
+            computingRanges[denom] = 0;
+        }
+    }
+
+    void TxPrecompPool::start() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(worker.joinable()) {
+            return;
+        }
+
+        stopped = false;
+        worker = std::thread([this]() { workerLoop(); });
+    }
+
+    void TxPrecompPool::stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        refill.notify_all();
+
+        if(worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    void TxPrecompPool::fill() {
+        while(computeOne())
+            ;
+    }
+
+    TxPrecomp TxPrecompPool::take(const std::vector<size_t>& vals) {
+        std::optional<TxPrecomp> pre;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!ready.empty()) {
+                pre = std::move(ready.front());
+                ready.pop_front();
+                hits++;
+            } else {
+                misses++;
+            }
+
+            if(pre.has_value()) {
+                for(auto val : vals) {
+                    auto it = readyRanges.find(val);
+                    if(it != readyRanges.end() && !it->second.empty()) {
+                        pre->ranges.push_back(std::move(it->second.front()));
+                        it->second.pop_front();
+                        rangeHits++;
+                    }
+                }
+            }
+        }
+        refill.notify_one();
+
+        if(!pre.has_value()) {
+            // NOTE: No point in computing range proof material inline, since Tx::Tx would do the same work
+            logtrace << "TxPrecompPool for '" << ask.pid << "' is empty" << endl;
+            pre = TxPrecomp::random(p, ask, numOuts);
+        }
+
+        return std::move(*pre);
+    }
+
+    bool TxPrecompPool::isFull() const {
+        if(ready.size() + computing < capacity) {
+            return false;
+        }
+
+        for(auto& kv : readyRanges) {
+            if(kv.second.size() + computingRanges.at(kv.first) < perDenom) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool TxPrecompPool::computeOne() {
+        // first, reserve a slot for what is missing (TXN randomness is cheaper and always needed, so do it first)
+        std::optional<size_t> denom;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(ready.size() + computing < capacity) {
+                computing++;
+            } else {
+                for(auto& kv : readyRanges) {
+                    if(kv.second.size() + computingRanges[kv.first] < perDenom) {
+                        denom = kv.first;
+                        computingRanges[kv.first]++;
+                        break;
+                    }
+                }
+
+                if(!denom.has_value()) {
+                    return false;
+                }
+            }
+        }
+
+        // then, compute it without holding the lock, and fill the reserved slot
+        try {
+            if(denom.has_value()) {
+                RangeProof::Precomp range(p.getRangeProofParams(), Fr(static_cast<long>(*denom)));
+
+                std::lock_guard<std::mutex> lock(mutex);
+                readyRanges[*denom].push_back(std::move(range));
+                computingRanges[*denom]--;
+            } else {
+                TxPrecomp pre = TxPrecomp::random(p, ask, numOuts);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                ready.push_back(std::move(pre));
+                computing--;
+            }
+        } catch(...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(denom.has_value()) {
+                computingRanges[*denom]--;
+            } else {
+                computing--;
+            }
+            throw;
+        }
+
+        return true;
+    }
+
+    void TxPrecompPool::workerLoop() {
+        bool failed = false;
+        while(true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if(failed) {
+                    // back off, so that a persistent failure doesn't keep the worker spinning
+                    refill.wait_for(lock, std::chrono::seconds(1), [this]() { return stopped; });
+                }
+                refill.wait(lock, [this]() { return stopped || !isFull(); });
+                if(stopped) {
+                    return;
+                }
+            }
+
+            // NOTE: An exception must not escape the thread. computeOne() releases the slot it reserved, so take()
+            // computes the material inline until the worker succeeds again.
+            failed = true;
+            try {
+                computeOne();
+                failed = false;
+            } catch(const std::exception& e) {
+                logerror << "TxPrecompPool for '" << ask.pid << "' failed to precompute: " << e.what() << endl;
+            } catch(...) {
+                logerror << "TxPrecompPool for '" << ask.pid << "' failed to precompute" << endl;
+            }
+        }
+    }
+
+} // end of namespace libutt
@@ -1,8 +1,10 @@
 #include <utt/Configuration.h>
 
 #include <utt/Coin.h>
+#include <utt/IBE.h>
 #include <utt/RegAuth.h>
 #include <utt/Tx.h>
+#include <utt/TxPrecompPool.h>
 #include <utt/Wallet.h>
 
 #include <utt/Serialization.h> // WARNING: Must include last
@@ -36,6 +38,11 @@ namespace libutt {
         loginfo << "budget coin? " << hasBudgetCoin() << endl;
     }
 
+    void Wallet::startPrecomputing(size_t capacity, const std::vector<size_t>& denoms) {
+        precompPool = std::make_shared<TxPrecompPool>(p, ask, capacity, denoms);
+        precompPool->start();
+    }
+
     void Wallet::addNormalCoin(const Coin& c) {
         if(c.pid_hash != ask.getPidHash()) {
             throw std::runtime_error("You are adding another person's coin to your wallet");
@@ -104,6 +111,65 @@ namespace libutt {
             testAssertFalse(hasBudgetCoin());
         }
 
-        return Tx(p, ask, c, b, recip, bpk, rpk);
+        std::optional<TxPrecomp> pre;
+        if(precompPool != nullptr) {
+            size_t paidOut = static_cast<size_t>(val1.as_ulong());
+            pre = precompPool->take({
+                paidOut,
+                static_cast<size_t>(val2.as_ulong()),
+                b.getValue() - paidOut      // the budget change
+            });
+        }
+
+        return Tx(p, ask, c, b, recip, bpk, rpk, std::move(pre));
+    }
+
+    std::vector<Wallet::FoundOutput> Wallet::findMyOutputs(const std::vector<Tx>& txs) const {
+        // flatten all outputs, so we can parallelize across them rather than across TXNs
+        std::vector<std::tuple<size_t, size_t>> txos;
+        for(size_t i = 0; i < txs.size(); i++) {
+            for(size_t j = 0; j < txs[i].outs.size(); j++) {
+                txos.emplace_back(i, j);
+            }
+        }
+
+        IBE::PrecompEncSK encsk(ask.e);
+        std::vector<char> forMe(txos.size(), 0);
+        std::vector<AutoBuf<unsigned char>> ptxts(txos.size());
+
+#ifdef USE_MULTITHREADING
+#pragma omp parallel for
+#endif
+        for(size_t k = 0; k < txos.size(); k++) {
+            auto& txo = txs[std::get<0>(txos[k])].outs[std::get<1>(txos[k])];
+
+            bool success;
+            std::tie(success, ptxts[k]) = encsk.decrypt(txo.ctxt);
+            forMe[k] = success;
+        }
+
+        std::vector<FoundOutput> found;
+        for(size_t k = 0; k < txos.size(); k++) {
+            if(forMe[k]) {
+                found.push_back(FoundOutput{ std::get<0>(txos[k]), std::get<1>(txos[k]), ptxts[k] });
+            }
+        }
+
+        logtrace << "Found " << found.size() << " out of " << txos.size() << " TXOs for pid '" << ask.pid << "'" << endl;
+        return found;
+    }
+
+    size_t Wallet::scan(const std::vector<Tx>& txs, size_t n, const SigShareFetcher& getSigShares) {
+        auto found = findMyOutputs(txs);
+
+        for(auto& fo : found) {
+            std::vector<RandSigShare> sigShares;
+            std::vector<size_t> signerIds;
+            std::tie(sigShares, signerIds) = getSigShares(fo.txIdx, fo.txoIdx);
+
+            addCoin(txs[fo.txIdx].claimCoin(p, fo.txoIdx, ask, fo.ptxt, n, sigShares, signerIds, bpk));
+        }
+
+        return found.size();
     }
 }
@@ -70,12 +70,13 @@ namespace libutt {
         const CommKey& ck2,
         const Comm& cm2
     ) const {
+        assertEqual(ck1.numMessages(), 1);
         std::vector<G1> X(2, G1::zero());
 
         // i.e., g_0^s_0 g^s_1 / cm_1^e
-        X[0] = Comm::create(ck1, { s[0], s[1] }, false).asG1() - (e * cm1.asG1());
+        X[0] = multiExp<G1, 3>({ ck1.g[0], ck1.getGen1(), cm1.asG1() }, { s[0], s[1], -e });
         // i.e., h_0^s_0 h^s_2 / cm_2^e
-        X[1] = Comm::create(ck1, { s[0], s[2] }, false).asG1() - (e * cm2.asG1());
+        X[1] = multiExp<G1, 3>({ ck1.g[0], ck1.getGen1(), cm2.asG1() }, { s[0], s[2], -e });
 
         return e == hash(ck1, cm1, ck2, cm2, X);
     }
@@ -124,10 +125,7 @@ namespace libutt {
         auto g_1 = ck.g[0];
         auto g   = ck.getGen1();
 
-        std::vector<G1> bases = { g_1,   g, cm.asG1() };
-        std::vector<Fr> exps =  { s_m, s_t, e         };
-
-        auto R = multiExp<G1>(bases, exps);
+        auto R = multiExp<G1, 3>({ g_1, g, cm.asG1() }, { s_m, s_t, e });
         auto h = ZKPoK::hash(ck, cm, R);
 
         return e == h;
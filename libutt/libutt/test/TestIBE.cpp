@@ -63,6 +63,20 @@ int main(int argc, char *argv[]) {
     testAssertEqual(r_1, samer_1);
     testAssertEqual(v, samev);
 
+    // decrypting with the precomputed EncSK must give the same result
+    IBE::PrecompEncSK precompEncSK(encsk);
+    AutoBuf<unsigned char> samePtxt;
+    std::tie(success, samePtxt) = precompEncSK.decrypt(ctxt);
+    testAssertTrue(success);
+    testAssertTrue(ptxt == samePtxt);
+
+    // ...and must not decrypt someone else's ciphertext
+    IBE::Ctxt otherCtxt = mpk.encrypt("otheruser@testdomain.com", frsToBytes({ v, r_1, r_2 }));
+    std::tie(success, samePtxt) = precompEncSK.decrypt(otherCtxt);
+    testAssertFalse(success);
+    std::tie(success, samePtxt) = encsk.decrypt(otherCtxt);
+    testAssertFalse(success);
+
     // Test (in)equality
     auto ctxtCopy = ctxt;
     testAssertEqual(ctxt, ctxtCopy);
@@ -0,0 +1,98 @@
+#include <utt/Configuration.h>
+
+#include <utt/PolyCrypto.h>
+
+#include <array>
+
+#include <xassert/XAssert.h>
+#include <xutils/Log.h>
+
+using namespace libutt;
+
+template<class Group>
+Group multiExpNaive(const std::vector<Group>& bases, const std::vector<Fr>& exps) {
+    Group r = Group::zero();
+    for(size_t i = 0; i < bases.size(); i++) {
+        r = r + exps[i] * bases[i];
+    }
+    return r;
+}
+
+template<class Group, size_t N>
+void testFixedSize() {
+    loginfo << "Testing multiexps of size " << N << endl;
+
+    std::array<Group, N> bases;
+    std::array<Fr, N> exps;
+    for(size_t i = 0; i < N; i++) {
+        bases[i] = Group::random_element();
+        exps[i] = Fr::random_element();
+    }
+    // some of the exponents in commitments are zero
+    exps[N - 1] = Fr::zero();
+    // ...and some are small
+    exps[0] = Fr(3);
+
+    std::vector<Group> b(bases.begin(), bases.end());
+    std::vector<Fr> e(exps.begin(), exps.end());
+    auto expected = multiExpNaive(b, e);
+
+    testAssertEqual(multiExp<Group, N>(bases, exps), expected);
+    testAssertEqual(multiExp<Group>(b, e), expected);
+
+    // all exponents zero
+    std::array<Fr, N> zeros;
+    zeros.fill(Fr::zero());
+    testAssertEqual(multiExp<Group, N>(bases, zeros), Group::zero());
+}
+
+template<class Group>
+void testAllSizes() {
+    testFixedSize<Group, 2>();
+    testFixedSize<Group, 3>();
+    testFixedSize<Group, 4>();
+    testFixedSize<Group, 5>();
+    testFixedSize<Group, 6>();
+    testFixedSize<Group, 7>();
+    testFixedSize<Group, 8>();
+
+    // the 4- and 6-argument variants
+    Group b1 = Group::random_element(), b2 = Group::random_element(), b3 = Group::random_element();
+    Fr e1 = Fr::random_element(), e2 = Fr::random_element(), e3 = Fr::random_element();
+    testAssertEqual(multiExp(b1, b2, e1, e2), e1 * b1 + e2 * b2);
+    testAssertEqual(multiExp(b1, b2, b3, e1, e2, e3), e1 * b1 + e2 * b2 + e3 * b3);
+}
+
+template<class Group>
+void testParallel() {
+    // sizes that do and do not split evenly among the threads
+    for(size_t n : std::vector<size_t>{ 1, 50, 101 }) {
+        auto bases = random_group_elems<Group>(n);
+        auto exps = random_field_elems(n);
+        auto expected = multiExpNaive(bases, exps);
+
+        for(size_t numThreads : std::vector<size_t>{ 1, 2, 3, 8 }) {
+            loginfo << "Testing parallel multiexp of size " << n << " with " << numThreads << " thread(s)" << endl;
+            testAssertEqual(
+                multiExpParallel<Group>(bases.cbegin(), bases.cend(), exps.cbegin(), exps.cend(), numThreads),
+                expected);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    (void)argc; (void)argv;
+
+    libutt::initialize(nullptr, 0);
+
+    testAllSizes<G1>();
+    testAllSizes<G2>();
+
+    testParallel<G1>();
+    testParallel<G2>();
+
+    loginfo << "All is well." << endl;
+
+    return 0;
+}
@@ -74,5 +74,14 @@ int main(int argc, char *argv[])
 
     testAssertEqual(a, c);
 
+    // test 3: cached Lagrange coefficients match the naive ones, on a miss and on a hit, in any order of T
+    std::vector<size_t> T = { 5, 1, 2, 7 };
+    auto naive = lagrange_coefficients_naive(8, T);
+    testAssertEqual(naive, lagrange_coefficients_cached(8, T));
+    testAssertEqual(naive, lagrange_coefficients_cached(8, T));
+
+    std::vector<size_t> sortedT = { 1, 2, 5, 7 };
+    testAssertEqual(lagrange_coefficients_naive(8, sortedT), lagrange_coefficients_cached(8, sortedT));
+
     return 0;
 }
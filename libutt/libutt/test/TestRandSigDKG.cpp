@@ -130,6 +130,51 @@ void testRandSigDKG(size_t t, size_t n, size_t ell) {
     testAssertTrue(threshSig1.verify(cm, dkg.getPK()));
 }
 
+void testBatchVerify(size_t t, size_t n, size_t ell, size_t numComms) {
+    RandSigDKG dkg(t, n, ell);
+    CommKey ck = dkg.getCK();
+
+    std::vector<RandSigSharePK> pkShares;
+    for(size_t i = 0; i < n; i++) {
+        pkShares.push_back(dkg.getShareSK(i).toPK());
+    }
+
+    // every signer signs every commitment vector, each under its own base h (as with the outputs of a TXN)
+    std::vector<std::vector<Comm>> c;
+    std::vector<std::vector<RandSigShare>> sigShares(numComms);
+    for(size_t j = 0; j < numComms; j++) {
+        G1 h = Fr::random_element() * ck.getGen1();
+
+        CommKey ck_ps;
+        ck_ps.g.push_back(h);
+        ck_ps.g.push_back(ck.getGen1());
+        c.push_back(Comm::create(ck_ps, random_field_elems(ell), random_field_elems(ell), false));
+
+        for(size_t i = 0; i < n; i++) {
+            sigShares[j].push_back(dkg.getShareSK(i).shareSign(c[j], h));
+        }
+    }
+
+    testAssertTrue(RandSigShare::batchVerify(c, sigShares, pkShares));
+    testAssertTrue(RandSigShare::findInvalidSigners(c, sigShares, pkShares).empty());
+
+    // corrupt one share of a random signer and make sure exactly that signer is caught
+    size_t badSigner = static_cast<size_t>(rand()) % n;
+    size_t badComm = static_cast<size_t>(rand()) % numComms;
+    sigShares[badComm][badSigner].s2 = sigShares[badComm][badSigner].s2 + G1::one();
+
+    testAssertFalse(RandSigShare::batchVerify(c, sigShares, pkShares));
+    std::vector<size_t> bad = RandSigShare::findInvalidSigners(c, sigShares, pkShares);
+    testAssertEqual(bad.size(), 1);
+    testAssertEqual(bad[0], badSigner);
+
+    // a valid share on the wrong commitment vector must not verify either
+    if(numComms > 1) {
+        sigShares[badComm][badSigner] = dkg.getShareSK(badSigner).shareSign(c[(badComm + 1) % numComms], sigShares[badComm][badSigner].s1);
+        testAssertFalse(RandSigShare::batchVerify(c, sigShares, pkShares));
+    }
+}
+
 int main(int argc, char *argv[]) {
     libutt::initialize(nullptr, 0);
     //srand(static_cast<unsigned int>(time(NULL)));
@@ -141,6 +186,10 @@ int main(int argc, char *argv[]) {
     size_t ell = 5;
     testRandSigDKG(t, n, ell);
 
+    for(size_t numComms : { 1, 2, 5 }) {
+        testBatchVerify(3, 4, ell, numComms);
+    }
+
     loginfo << "All is well." << endl;
 
     return 0;
@@ -8,6 +8,7 @@
 #include <utt/RandSigDKG.h>
 #include <utt/RegAuth.h>
 #include <utt/Tx.h>
+#include <utt/TxPrecompPool.h>
 #include <utt/Utils.h>
 #include <utt/Wallet.h>
 
@@ -17,6 +18,7 @@
 #include <fstream>
 #include <random>
 #include <stdexcept>
+#include <thread>
 #include <vector>
 
 #include <xassert/XAssert.h>
@@ -82,6 +84,10 @@ void testBudgeted2to2Txn(size_t thresh, size_t n, size_t numCycles, bool isBudge
     RegAuthPK rpk = f.getRegAuthPK();
     RandSigPK bpk = f.getBankPK();
     std::vector<RandSigShareSK> bskShares = f.getBankShareSKs();
+    std::vector<RandSigSharePK> bpkShares;
+    for(auto& bskShare : bskShares) {
+        bpkShares.push_back(bskShare.toPK());
+    }
 
     logdbg << "Created decentralized UTT system" << endl;
 
@@ -146,7 +152,14 @@ void testBudgeted2to2Txn(size_t thresh, size_t n, size_t numCycles, bool isBudge
                 nullset.insert(nullif);
             }
 
+            // a copy of the wallets, to check that scanning the TXN finds the same coins as claiming each output below
+            std::vector<Wallet> scanned = w;
+
+            // the number of outputs each wallet claims below
+            std::vector<size_t> numClaimed(w.size(), 0);
+
             // replicas: go through every TX output and sign it
+            std::vector<std::vector<RandSigShare>> allSigShares;
             for(size_t txoIdx = 0; txoIdx < tx.outs.size(); txoIdx++) {
                 // each replica returns its sigshare on this output
                 std::vector<RandSigShare> sigShares;
@@ -168,6 +181,7 @@ void testBudgeted2to2Txn(size_t thresh, size_t n, size_t numCycles, bool isBudge
 
                     sigShares.push_back(sigShare);
                 }
+                allSigShares.push_back(sigShares);
 
                 // first, sample a subset of sigshares to aggregate
                 std::vector<RandSigShare> sigShareSubset;
@@ -197,6 +211,7 @@ void testBudgeted2to2Txn(size_t thresh, size_t n, size_t numCycles, bool isBudge
                 }
                 testAssertTrue(coin.has_value());
                 testAssertNotEqual(foundIdx, w.size());
+                numClaimed[foundIdx]++;
 
                 // assert all of the other wallets do not think this output is theirs
                 for(size_t j = 0; j < w.size(); j++) {
@@ -207,10 +222,97 @@ void testBudgeted2to2Txn(size_t thresh, size_t n, size_t numCycles, bool isBudge
                 }
 
             } // end for all txouts
+
+            // clients: check all sigshares on all outputs at once
+            testAssertTrue(tx.verifySigShares(allSigShares, bpkShares));
+            testAssertTrue(tx.findInvalidSigShares(allSigShares, bpkShares).empty());
+
+            // clients: catch up by scanning the TXN instead
+            std::vector<Tx> txs = { tx };
+            for(size_t j = 0; j < w.size(); j++) {
+                size_t numFound = scanned[j].scan(txs, n, [&](size_t txIdx, size_t txoIdx) {
+                    testAssertEqual(txIdx, 0);
+
+                    std::vector<RandSigShare> sigShareSubset;
+                    std::vector<size_t> signerIdSubset = random_subset(thresh, n);
+                    for(auto id : signerIdSubset) {
+                        sigShareSubset.push_back(allSigShares.at(txoIdx).at(id));
+                    }
+                    return std::make_tuple(sigShareSubset, signerIdSubset);
+                });
+
+                testAssertEqual(numFound, numClaimed[j]);
+                testAssertEqual(scanned[j].findMyOutputs(txs).size(), numClaimed[j]);
+                testAssertEqual(scanned[j].numCoins(), w[j].numCoins());
+                testAssertEqual(scanned[j].totalValue(), w[j].totalValue());
+                testAssertEqual(scanned[j].hasBudgetCoin(), w[j].hasBudgetCoin());
+            }
         } // end for all wallets 
     } // end for all cycles
 }
 
+/**
+ * Tests that TXNs created from material precomputed by a TxPrecompPool are valid.
+ */
+void testPrecomputedTxn(size_t thresh, size_t n) {
+    Factory f(thresh, n);
+    const Params& p = f.getParams();
+    RegAuthPK rpk = f.getRegAuthPK();
+    RandSigPK bpk = f.getBankPK();
+
+    size_t maxDenom = 100;
+    std::vector<Wallet> w = f.randomWallets(2, 2, maxDenom, 2 * maxDenom);
+
+    // range proofs finished from precomputed material must verify
+    Fr val = Fr(static_cast<long>(7)), z = Fr::random_element();
+    Comm vcm = Comm::create(p.getValCK(), { val, z }, false);
+    RangeProof rp(p.getRangeProofParams(), vcm, val, z, RangeProof::Precomp(p.getRangeProofParams(), val));
+    testAssertTrue(rp.verify(p.getRangeProofParams(), vcm));
+
+    // fill the pool synchronously, so the TXN below is guaranteed to use it
+    size_t capacity = 2;
+    auto pool = std::make_shared<TxPrecompPool>(p, w[0].ask, capacity, std::vector<size_t>{ 7 });
+    pool->fill();
+    testAssertEqual(pool->size(), capacity);
+
+    w[0].precompPool = pool;
+    Tx tx = w[0].spendTwoRandomCoins(w[1].getUserPid(), true);
+    testAssertEqual(pool->numHits(), 1);
+    testAssertEqual(pool->numMisses(), 0);
+    testAssertEqual(pool->size(), capacity - 1);
+
+    testAssertTrue(tx.quickPayValidate(p, bpk, rpk));
+    testAssertTrue(tx.validate(p, bpk, rpk));
+
+    // range proof material is only handed out for the precomputed denominations
+    TxPrecomp pre = pool->take({ 7, 8 });
+    testAssertEqual(pre.ranges.size(), 1);
+    testAssertEqual(pool->numRangeHits(), 1);
+    testAssertTrue(pre.takeOut(0, val).has_value());
+    testAssertTrue(pre.ranges.empty());
+
+    // an empty pool still hands out (inline-computed) material
+    testAssertEqual(pool->size(), 0);
+    pre = pool->take({ 7 });
+    testAssertEqual(pool->numMisses(), 1);
+    testAssertEqual(pre.outs.size(), TxPrecompPool::DefaultNumOuts);
+
+    // the background thread refills the pool
+    pool->start();
+    while(pool->size() < capacity) {
+        std::this_thread::yield();
+    }
+    pool->stop();
+
+    // fill() and the background thread don't compute the same missing items, so the pool never overflows
+    pool->take({});
+    pool->take({});
+    pool->start();
+    pool->fill();
+    pool->stop();
+    testAssertEqual(pool->size(), capacity);
+}
+
 int main(int argc, char *argv[]) {
     libutt::initialize(nullptr, 0);
     //srand(static_cast<unsigned int>(time(NULL)));
@@ -219,6 +321,7 @@ int main(int argc, char *argv[]) {
 
     testBudgeted2to2Txn(12, 21, 3, true, true);
     testBudgeted2to2Txn(12, 21, 3, true, false);
+    testPrecomputedTxn(2, 4);
 
     loginfo << "All is well." << endl;
 
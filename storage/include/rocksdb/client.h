@@ -26,6 +26,7 @@
 #include "storage/storage_metrics.h"
 
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -34,6 +35,7 @@ namespace storage {
 namespace rocksdb {
 
 class Client;
+class ColumnFamilyProfiles;
 
 class ClientIterator : public concord::storage::IDBClient::IDBClientIterator {
   friend class Client;
@@ -103,6 +105,12 @@ class Client : public concord::storage::IDBClient {
   void setAggregator(std::shared_ptr<concordMetrics::Aggregator> aggregator) override {
     storage_metrics_.setAggregator(aggregator);
   }
+  // Call before init() in order to apply the selected profiles to the existing column families when the DB is opened.
+  // Column families created via NativeClient::createColumnFamilyWithProfile() use them as well.
+  void setColumnFamilyProfiles(const std::shared_ptr<const ColumnFamilyProfiles>& profiles) {
+    cf_profiles_ = profiles;
+  }
+  std::shared_ptr<const ColumnFamilyProfiles> columnFamilyProfiles() const { return cf_profiles_; }
 
   static logging::Logger& logger() {
     static logging::Logger logger_ = logging::getLogger("concord.storage.rocksdb");
@@ -162,6 +170,9 @@ class Client : public concord::storage::IDBClient {
   std::unique_ptr<const ::rocksdb::Comparator> comparator_;
   std::map<std::string, CfUniquePtr> cf_handles_;
 
+  // Options of the column families, see setColumnFamilyProfiles().
+  std::shared_ptr<const ColumnFamilyProfiles> cf_profiles_;
+
   // Metrics
   mutable RocksDbStorageMetrics storage_metrics_;
 
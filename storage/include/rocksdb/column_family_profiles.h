@@ -0,0 +1,161 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#ifdef USE_ROCKSDB
+
+#include <rocksdb/cache.h>
+#include <rocksdb/db.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/options.h>
+#include <rocksdb/slice_transform.h>
+#include <rocksdb/table.h>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace concord::storage::rocksdb {
+
+// RocksDB options of a column family, tuned for its access pattern.
+struct ColumnFamilyProfile {
+  // The share of the total block cache size that is given to the column families with this profile (0 - no block
+  // cache).
+  double block_cache_share{0};
+
+  // Bits per key of the bloom filter (0 - no bloom filter).
+  int bloom_bits_per_key{10};
+
+  // If not 0, a fixed-size prefix extractor of this length is used. Only suitable for column families that are not
+  // iterated across prefixes.
+  std::size_t prefix_length{0};
+
+  ::rocksdb::CompactionStyle compaction_style{::rocksdb::kCompactionStyleLevel};
+
+  // Skip filters on the last level, for column families in which point lookups rarely miss.
+  bool optimize_filters_for_hits{false};
+};
+
+// A set of named column family profiles that share a block cache size budget. Every profile gets its own block cache
+// that is shared by all column families with that profile, so that column families with different access patterns
+// don't evict each other's blocks. RocksDB doesn't persist block caches, so the profiles need to be applied to the
+// column families every time the DB is opened in order to keep the budget.
+class ColumnFamilyProfiles {
+ public:
+  // Return the profile of a column family by its name.
+  using Selector = std::function<std::string(const std::string &cf)>;
+
+  ColumnFamilyProfiles(std::size_t block_cache_size,
+                       const std::map<std::string, ColumnFamilyProfile> &profiles,
+                       Selector selector = Selector{})
+      : selector_{std::move(selector)} {
+    for (const auto &[name, profile] : profiles) {
+      auto &entry = profiles_[name];
+      entry.profile = profile;
+      const auto cache_size = static_cast<std::size_t>(block_cache_size * profile.block_cache_share);
+      if (cache_size > 0) {
+        entry.block_cache = ::rocksdb::NewLRUCache(cache_size);
+      }
+    }
+  }
+
+  bool hasProfile(const std::string &name) const { return profiles_.find(name) != profiles_.cend(); }
+
+  // Return std::nullopt if there is no selector or the selected profile is unknown.
+  std::optional<std::string> profileOf(const std::string &cf) const {
+    if (!selector_) {
+      return std::nullopt;
+    }
+    auto profile = selector_(cf);
+    if (!hasProfile(profile)) {
+      return std::nullopt;
+    }
+    return profile;
+  }
+
+  // Apply the options of the selected profiles to column families that are about to be opened. Column families
+  // without a profile are left untouched. The compaction style is kept, as RocksDB cannot switch it for existing data.
+  void apply(std::vector<::rocksdb::ColumnFamilyDescriptor> &cf_descs) const {
+    for (auto &cf_desc : cf_descs) {
+      if (const auto profile = profileOf(cf_desc.name)) {
+        const auto compaction_style = cf_desc.options.compaction_style;
+        cf_desc.options = options(*profile, cf_desc.options);
+        cf_desc.options.compaction_style = compaction_style;
+      }
+    }
+  }
+
+  // Returns `base` with the options of the profile applied.
+  // Throws std::invalid_argument if there is no such profile.
+  ::rocksdb::ColumnFamilyOptions options(const std::string &name,
+                                         ::rocksdb::ColumnFamilyOptions base = ::rocksdb::ColumnFamilyOptions{}) const {
+    const auto &[profile, block_cache] = entry(name);
+    auto table_options = ::rocksdb::BlockBasedTableOptions{};
+    if (block_cache) {
+      table_options.block_cache = block_cache;
+    } else {
+      table_options.no_block_cache = true;
+    }
+    if (profile.bloom_bits_per_key > 0) {
+      table_options.filter_policy.reset(::rocksdb::NewBloomFilterPolicy(profile.bloom_bits_per_key, false));
+    }
+    base.table_factory.reset(::rocksdb::NewBlockBasedTableFactory(table_options));
+    if (profile.prefix_length > 0) {
+      base.prefix_extractor.reset(::rocksdb::NewFixedPrefixTransform(profile.prefix_length));
+    }
+    base.compaction_style = profile.compaction_style;
+    base.optimize_filters_for_hits = profile.optimize_filters_for_hits;
+    return base;
+  }
+
+  // Returns nullptr if the profile has no block cache.
+  // Throws std::invalid_argument if there is no such profile.
+  std::shared_ptr<::rocksdb::Cache> blockCache(const std::string &name) const { return entry(name).block_cache; }
+
+  std::map<std::string, ColumnFamilyProfile> profiles() const {
+    auto ret = std::map<std::string, ColumnFamilyProfile>{};
+    for (const auto &[name, entry] : profiles_) {
+      ret[name] = entry.profile;
+    }
+    return ret;
+  }
+
+ private:
+  struct Entry {
+    ColumnFamilyProfile profile;
+    std::shared_ptr<::rocksdb::Cache> block_cache;
+  };
+
+  const Entry &entry(const std::string &name) const {
+    const auto it = profiles_.find(name);
+    if (it == profiles_.cend()) {
+      throw std::invalid_argument{"Unknown RocksDB column family profile: " + name};
+    }
+    return it->second;
+  }
+
+ private:
+  std::map<std::string, Entry> profiles_;
+  const Selector selector_;
+};
+
+}  // namespace concord::storage::rocksdb
+
+#endif  // USE_ROCKSDB
@@ -21,6 +21,7 @@
 #include "rocksdb_exception.h"
 
 #include "client.h"
+#include "column_family_profiles.h"
 
 #include <rocksdb/slice.h>
 #include <rocksdb/utilities/options_util.h>
@@ -154,6 +155,15 @@ class NativeClient : public std::enable_shared_from_this<NativeClient> {
   // Throws if the column family already exists.
   void createColumnFamily(const std::string &cFamily,
                           const ::rocksdb::ColumnFamilyOptions &options = ::rocksdb::ColumnFamilyOptions{});
+  // Creates a column family with the options of the given profile. If no profiles are set or the profile is unknown,
+  // default options are used. Throws if the column family already exists.
+  void createColumnFamilyWithProfile(const std::string &cFamily, const std::string &profile);
+  // Set the profiles used by createColumnFamilyWithProfile(). Profiles are shared by all NativeClient instances that
+  // wrap the same underlying client. Column families that are already open keep their options - in order to apply the
+  // profiles to them, set the profiles on the client before opening the DB (see Client::setColumnFamilyProfiles()).
+  void setColumnFamilyProfiles(const std::shared_ptr<const ColumnFamilyProfiles> &);
+  // Return nullptr if no profiles are set.
+  std::shared_ptr<const ColumnFamilyProfiles> columnFamilyProfiles() const;
   // Return the column family options for an existing column family in this client.
   ::rocksdb::ColumnFamilyOptions columnFamilyOptions(const std::string &cFamily) const;
   // Drops a column family and its data. It is not an error if the column family doesn't exist or if the client is not
@@ -231,6 +231,22 @@ inline void NativeClient::createColumnFamily(const std::string &cFamily,
   client_->cf_handles_[cFamily] = std::move(handle);
 }
 
+inline void NativeClient::createColumnFamilyWithProfile(const std::string &cFamily, const std::string &profile) {
+  const auto &profiles = client_->cf_profiles_;
+  if (!profiles || !profiles->hasProfile(profile)) {
+    return createColumnFamily(cFamily);
+  }
+  createColumnFamily(cFamily, profiles->options(profile));
+}
+
+inline void NativeClient::setColumnFamilyProfiles(const std::shared_ptr<const ColumnFamilyProfiles> &profiles) {
+  client_->setColumnFamilyProfiles(profiles);
+}
+
+inline std::shared_ptr<const ColumnFamilyProfiles> NativeClient::columnFamilyProfiles() const {
+  return client_->columnFamilyProfiles();
+}
+
 inline ::rocksdb::ColumnFamilyOptions NativeClient::columnFamilyOptions(const std::string &cFamily) const {
   auto family = columnFamilyHandle(cFamily);
   auto descriptor = ::rocksdb::ColumnFamilyDescriptor{};
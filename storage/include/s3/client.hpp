@@ -22,6 +22,8 @@
 #include "assertUtils.hpp"
 #include "storage/db_interface.h"
 #include "s3_metrics.hpp"
+#include "thread_pool.hpp"
+#include "diagnostics.h"
 
 #pragma once
 
@@ -35,6 +37,9 @@ struct StoreConfig {
   std::string accessKey;      // from the customer
   std::uint32_t maxWaitTime;  // in milliseconds
   std::string pathPrefix;     // optional path prefix used in the bucket
+  // Maximum number of requests that multiGet(), multiPut(), multiDel() and Transaction::commit() send concurrently.
+  // 1 means that these requests are sent one after the other.
+  std::uint32_t maxInFlightRequests = 1;
 };
 
 /**
@@ -52,14 +57,22 @@ class Client : public concord::storage::IDBClient {
    public:
     Transaction(Client* client) : ITransaction(nextId()), client_{client} {}
     void commit() override {
-      for (auto& pair : multiput_)
-        if (concordUtils::Status s = client_->put(pair.first, pair.second); !s.isOK())
-          throw std::runtime_error("S3 commit failed while putting a value for key: " + pair.first.toString() +
-                                   std::string(" txn id[") + getIdStr() + std::string("], reason: ") + s.toString());
-      for (auto& key : keys_to_delete_)
-        if (concordUtils::Status s = client_->del(key); !s.isOK())
-          throw std::runtime_error("S3 commit failed while deleting a vallue for key: " + key.toString() +
-                                   std::string(" txn id[") + getIdStr() + std::string("], reason: ") + s.toString());
+      std::vector<const SetOfKeyValuePairs::value_type*> puts;
+      puts.reserve(multiput_.size());
+      for (auto& pair : multiput_) puts.push_back(&pair);
+      if (concordUtils::Status s = client_->forEachConcurrently(
+              puts.size(), [&](size_t i) { return client_->put(puts[i]->first, puts[i]->second); });
+          !s.isOK())
+        throw std::runtime_error("S3 commit failed while putting values" + std::string(" txn id[") + getIdStr() +
+                                 std::string("], reason: ") + s.toString());
+      std::vector<const concordUtils::Sliver*> dels;
+      dels.reserve(keys_to_delete_.size());
+      for (auto& key : keys_to_delete_) dels.push_back(&key);
+      if (concordUtils::Status s =
+              client_->forEachConcurrently(dels.size(), [&](size_t i) { return client_->del(*dels[i]); });
+          !s.isOK())
+        throw std::runtime_error("S3 commit failed while deleting values" + std::string(" txn id[") + getIdStr() +
+                                 std::string("], reason: ") + s.toString());
     }
     void rollback() override { multiput_.clear(); }
     void put(const concordUtils::Sliver& key, const concordUtils::Sliver& value) override { multiput_[key] = value; }
@@ -79,7 +92,10 @@ class Client : public concord::storage::IDBClient {
     }
   };
 
-  Client(const StoreConfig& config) : config_{config} { LOG_INFO(logger_, "S3 client created"); }
+  Client(const StoreConfig& config) : config_{config} {
+    if (config_.maxInFlightRequests > 1) pool_ = std::make_unique<util::ThreadPool>(config_.maxInFlightRequests);
+    LOG_INFO(logger_, "S3 client created" << KVLOG(config_.maxInFlightRequests));
+  }
 
   ~Client() {
     /* Destroy LibS3 */
@@ -168,11 +184,7 @@ class Client : public concord::storage::IDBClient {
 
   concordUtils::Status multiGet(const KeysVector& _keysVec, OUT ValuesVector& _valuesVec) override {
     ConcordAssert(_keysVec.size() == _valuesVec.size());
-
-    for (KeysVector::size_type i = 0; i < _keysVec.size(); ++i)
-      if (Status s = get(_keysVec[i], _valuesVec[i]); !s.isOK()) return s;
-
-    return concordUtils::Status::OK();
+    return forEachConcurrently(_keysVec.size(), [&](size_t i) { return get(_keysVec[i], _valuesVec[i]); });
   }
 
   concordUtils::Status multiPut(const SetOfKeyValuePairs& _keyValueMap) override {
@@ -183,9 +195,7 @@ class Client : public concord::storage::IDBClient {
   }
 
   concordUtils::Status multiDel(const KeysVector& _keysVec) override {
-    for (auto&& key : _keysVec)
-      if (Status s = del(key); !s.isOK()) return s;
-    return concordUtils::Status::OK();
+    return forEachConcurrently(_keysVec.size(), [&](size_t i) { return del(_keysVec[i]); });
   }
 
   bool isNew() override { throw std::logic_error("isNew()  Not implemented for S3 object store"); }
@@ -206,12 +216,32 @@ class Client : public concord::storage::IDBClient {
   }
 
   void setAggregator(std::shared_ptr<concordMetrics::Aggregator> aggregator) override {
+    std::lock_guard<std::mutex> g(metricsLock_);
     metrics_.metrics_component.SetAggregator(aggregator);
     metrics_.metrics_component.UpdateAggregator();
   }
 
   ///////////////////////// protected /////////////////////////////
  protected:
+  // Calls f(i) for every i in [0, count), with at most config_.maxInFlightRequests calls running at the same time.
+  // Returns the first status that is not OK. In the concurrent mode, all calls complete before it returns, so the
+  // caller's state that f() refers to outlives them.
+  template <typename F>
+  concordUtils::Status forEachConcurrently(size_t count, F&& f) const {
+    if (!pool_ || count < 2) {
+      for (size_t i = 0; i < count; ++i)
+        if (Status s = f(i); !s.isOK()) return s;
+      return concordUtils::Status::OK();
+    }
+    std::vector<std::future<concordUtils::Status>> results;
+    results.reserve(count);
+    for (size_t i = 0; i < count; ++i) results.push_back(pool_->async([&f, i]() { return f(i); }));
+    concordUtils::Status res = concordUtils::Status::OK();
+    for (auto& r : results)
+      if (Status s = r.get(); !s.isOK() && res.isOK()) res = s;
+    return res;
+  }
+
   // retry forever, increasing the waiting timeout until it reaches the defined maximum
   template <typename F, typename... Args>
   void do_with_retry(const std::string_view msg, Status& r, F&& f, Args&&... args) const {
@@ -311,6 +341,27 @@ class Client : public concord::storage::IDBClient {
   const double delayFactor_ = 1.5;
 
   Metrics metrics_;
+  // Protects metrics_, which is updated by concurrent requests
+  std::mutex metricsLock_;
+  // nullptr if requests are sent one after the other
+  std::unique_ptr<util::ThreadPool> pool_;
+
+  // 1 minute
+  static constexpr int64_t MAX_VALUE_MICROSECONDS = 1000 * 1000 * 60l;
+  struct Recorders {
+    Recorders() {
+      auto& registrar = concord::diagnostics::RegistrarSingleton::getInstance();
+      const auto component = "s3";
+      if (!registrar.perf.isRegisteredComponent(component)) {
+        registrar.perf.registerComponent(component, {get, put, del, head});
+      }
+    }
+    DEFINE_SHARED_RECORDER(get, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
+    DEFINE_SHARED_RECORDER(put, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
+    DEFINE_SHARED_RECORDER(del, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
+    DEFINE_SHARED_RECORDER(head, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
+  };
+  static Recorders histograms_;
 };
 
 }  // namespace concord::storage::s3
@@ -52,7 +52,8 @@ class Metrics {
                                                                                << ") to numeric value.");
       return;
     }
-    last_saved_block_id_.Get().Set(lastSavedBlockVal);
+    // Blocks may be saved concurrently, so keep the highest one
+    if (lastSavedBlockVal > last_saved_block_id_.Get().Get()) last_saved_block_id_.Get().Set(lastSavedBlockVal);
   }
 
   uint64_t getLastSavedBlockId() { return last_saved_block_id_.Get().Get(); }
@@ -17,6 +17,7 @@
 #ifdef USE_ROCKSDB
 
 #include <rocksdb/client.h>
+#include <rocksdb/column_family_profiles.h>
 #include <rocksdb/transaction.h>
 #include <rocksdb/env.h>
 #include <rocksdb/utilities/options_util.h>
@@ -173,6 +174,11 @@ void Client::openRocksDB(bool readOnly,
     }
   }
 
+  // Block caches are not persisted, i.e. profiles have to be applied on every open.
+  if (cf_profiles_) {
+    cf_profiles_->apply(cf_descs);
+  }
+
   if (readOnly) {
     ::rocksdb::DB *db;
     s = ::rocksdb::DB::OpenForReadOnly(db_options, m_dbPath, cf_descs, &raw_cf_handles, &db);
@@ -28,6 +28,8 @@ namespace concord::storage::s3 {
 using namespace std;
 using namespace concordUtils;
 
+Client::Recorders Client::histograms_;
+
 /**
  * @brief Initializing underlying libs3. The S3_initialize function must be
  * called exactly once and only from 1 thread
@@ -71,6 +73,7 @@ void Client::init(bool readOnly) {
 
 Status Client::del(const Sliver& key) {
   ConcordAssert(init_);
+  diagnostics::TimeRecorder<true> scoped_timer(*histograms_.del);
   ResponseData rData;
   S3ResponseHandler rHandler;
   rHandler.completeCallback = responseCompleteCallback;
@@ -94,6 +97,7 @@ Status Client::del(const Sliver& key) {
 Status Client::get_internal(const Sliver& _key, OUT Sliver& _outValue) const {
   ConcordAssert(init_);
   LOG_DEBUG(logger_, "get key: " << _key.toString());
+  diagnostics::TimeRecorder<true> scoped_timer(*histograms_.get);
   GetObjectResponseData cbData(kInitialGetBufferSize_);
   S3GetObjectHandler getObjectHandler;
   getObjectHandler.responseHandler = responseHandler;
@@ -125,6 +129,7 @@ Status Client::get_internal(const Sliver& _key, OUT Sliver& _outValue) const {
 
 Status Client::put_internal(const Sliver& _key, const Sliver& _value) {
   ConcordAssert(init_);
+  diagnostics::TimeRecorder<true> scoped_timer(*histograms_.put);
   PutObjectResponseData cbData(_value.data(), _value.length());
   S3PutObjectHandler putObjectHandler;
   putObjectHandler.responseHandler = responseHandler;
@@ -146,6 +151,7 @@ Status Client::put_internal(const Sliver& _key, const Sliver& _value) {
   string s = string(_key.data());
   S3_put_object(&context_, string(_key.data()).c_str(), _value.length(), NULL, NULL, &putObjectHandler, &cbData);
   if (cbData.status == S3Status::S3StatusOK) {
+    std::lock_guard<std::mutex> g(metricsLock_);
     metrics_.num_keys_transferred++;
     metrics_.bytes_transferred += (_key.length() + _value.length());
     metrics_.updateLastSavedBlockId(_key);
@@ -166,6 +172,7 @@ Status Client::object_exists_internal(const Sliver& key) const {
   S3ResponseHandler rHandler;
   rHandler.completeCallback = responseCompleteCallback;
   rHandler.propertiesCallback = propertiesCallback;
+  diagnostics::TimeRecorder<true> scoped_timer(*histograms_.head);
 
   S3_head_object(&context_, string(key.data()).c_str(), NULL, &rHandler, &rData);
   LOG_DEBUG(
@@ -20,6 +20,10 @@
 #include "sliver.hpp"
 #include "storage/test/storage_test_common.h"
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
 #include <string_view>
 #include <utility>
 
@@ -125,6 +129,83 @@ TEST_F(native_rocksdb_test, family_options_are_persisted) {
   }
 }
 
+TEST_F(native_rocksdb_test, creating_a_family_with_a_profile) {
+  const auto cf = "cf"s;
+  auto profile = ColumnFamilyProfile{};
+  profile.block_cache_share = 0.5;
+  profile.prefix_length = 4;
+  profile.compaction_style = ::rocksdb::kCompactionStyleUniversal;
+  profile.optimize_filters_for_hits = true;
+  db->setColumnFamilyProfiles(
+      std::make_shared<ColumnFamilyProfiles>(1024 * 1024, std::map<std::string, ColumnFamilyProfile>{{"p", profile}}));
+  db->createColumnFamilyWithProfile(cf, "p");
+
+  const auto optsOut = db->columnFamilyOptions(cf);
+  ASSERT_EQ(optsOut.compaction_style, ::rocksdb::kCompactionStyleUniversal);
+  ASSERT_TRUE(optsOut.optimize_filters_for_hits);
+  ASSERT_TRUE(optsOut.prefix_extractor);
+  auto blockCacheCapacity = std::uint64_t{0};
+  ASSERT_TRUE(db->rawDB().GetIntProperty(
+      db->columnFamilyHandle(cf), ::rocksdb::DB::Properties::kBlockCacheCapacity, &blockCacheCapacity));
+  ASSERT_EQ(blockCacheCapacity, 512 * 1024u);
+
+  db->put(cf, key, value);
+  ASSERT_EQ(db->get(cf, key), value);
+}
+
+TEST_F(native_rocksdb_test, creating_a_family_with_an_unknown_profile_uses_default_options) {
+  db->setColumnFamilyProfiles(
+      std::make_shared<ColumnFamilyProfiles>(1024 * 1024, std::map<std::string, ColumnFamilyProfile>{{"p", {}}}));
+  db->createColumnFamilyWithProfile("cf", "unknown");
+  const auto optsOut = db->columnFamilyOptions("cf");
+  ASSERT_EQ(optsOut.compaction_style, ::rocksdb::ColumnFamilyOptions{}.compaction_style);
+  ASSERT_FALSE(optsOut.prefix_extractor);
+  ASSERT_THROW(db->columnFamilyProfiles()->options("unknown"), std::invalid_argument);
+}
+
+TEST_F(native_rocksdb_test, creating_a_family_with_a_profile_without_profiles_uses_default_options) {
+  ASSERT_FALSE(db->columnFamilyProfiles());
+  db->createColumnFamilyWithProfile("cf", "p");
+  const auto optsOut = db->columnFamilyOptions("cf");
+  ASSERT_EQ(optsOut.compaction_style, ::rocksdb::ColumnFamilyOptions{}.compaction_style);
+  ASSERT_FALSE(optsOut.optimize_filters_for_hits);
+}
+
+TEST_F(native_rocksdb_test, profiles_are_applied_when_reopening) {
+  auto profile = ColumnFamilyProfile{};
+  profile.block_cache_share = 0.5;
+  const auto newProfiles = [&profile]() {
+    return std::make_shared<ColumnFamilyProfiles>(
+        1024 * 1024,
+        std::map<std::string, ColumnFamilyProfile>{{"p", profile}},
+        [](const std::string &cf) { return cf == NativeClient::defaultColumnFamily() ? "none"s : "p"s; });
+  };
+  db->setColumnFamilyProfiles(newProfiles());
+  db->createColumnFamilyWithProfile("cf1", "p");
+  db->createColumnFamilyWithProfile("cf2", "p");
+  db.reset();
+
+  // Block caches are not persisted - when reopening, all column families of a profile must share its cache again.
+  const auto profiles = newProfiles();
+  auto client = std::make_shared<Client>(rocksDbPath(defaultDbId));
+  client->setColumnFamilyProfiles(profiles);
+  client->init();
+  db = NativeClient::fromIDBClient(client);
+  const auto blockCache = [this](const std::string &cf) {
+    const auto opts = db->columnFamilyOptions(cf);
+    return static_cast<::rocksdb::BlockBasedTableOptions *>(opts.table_factory->GetOptions())->block_cache;
+  };
+  for (const auto &cf : {"cf1"s, "cf2"s}) {
+    auto blockCacheCapacity = std::uint64_t{0};
+    ASSERT_TRUE(db->rawDB().GetIntProperty(
+        db->columnFamilyHandle(cf), ::rocksdb::DB::Properties::kBlockCacheCapacity, &blockCacheCapacity));
+    ASSERT_EQ(blockCacheCapacity, 512 * 1024u);
+    ASSERT_EQ(blockCache(cf), profiles->blockCache("p"));
+  }
+  // Column families without a profile keep their options.
+  ASSERT_NE(blockCache(NativeClient::defaultColumnFamily()), profiles->blockCache("p"));
+}
+
 TEST_F(native_rocksdb_test, default_family_data_is_persisted) {
   db->put(key, value);
 
@@ -26,6 +26,8 @@ BATCH_FLUSH_PERIOD = "250"
 BATCH_SELF_ADJUSTED = "0"
 BATCH_BY_REQ_SIZE = "1"
 BATCH_BY_REQ_NUM = "2"
+BATCH_LATENCY_TARGET = "4"
+BATCHING_LATENCY_TARGET = "500"
 BATCHING_POLICY = BATCH_SELF_ADJUSTED
 
 def start_replica_cmd(builddir, replica_id):
@@ -45,7 +47,8 @@ def start_replica_cmd(builddir, replica_id):
             "-b", BATCHING_POLICY,
             "-m", MAX_REQS_SIZE_IN_BATCH,
             "-q", MAX_REQ_NUM_IN_BATCH,
-            "-z", BATCH_FLUSH_PERIOD
+            "-z", BATCH_FLUSH_PERIOD,
+            "-L", BATCHING_LATENCY_TARGET
             ]
 
 class SkvbcConsensusBatchingPoliciesTest(unittest.TestCase):
@@ -93,3 +96,15 @@ class SkvbcConsensusBatchingPoliciesTest(unittest.TestCase):
         global BATCHING_POLICY
         BATCHING_POLICY = BATCH_BY_REQ_SIZE
         await self.launch_concurrent_requests(bft_network, tracker)
+
+    @with_trio
+    @with_bft_network(start_replica_cmd, selected_configs=lambda n, f, c: n == 7)
+    @verify_linearizability(pre_exec_enabled=True, no_conflicts=True)
+    async def test_batching_by_latency_target(self, bft_network, tracker):
+        """
+        This test verifies that BATCH_LATENCY_TARGET consensus policy works
+        """
+
+        global BATCHING_POLICY
+        BATCHING_POLICY = BATCH_LATENCY_TARGET
+        await self.launch_concurrent_requests(bft_network, tracker)
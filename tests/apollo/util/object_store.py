@@ -46,7 +46,8 @@ def start_replica_cmd_prefix(builddir, replica_id, config):
                     "s3-protocol: HTTP\n"
                     "s3-url: 127.0.0.1:9000\n"
                     "s3-secret-key: concordbft\n"
-                    "s3-path-prefix: concord")
+                    "s3-path-prefix: concord\n"
+                    "s3-max-in-flight-requests: 8")
         os.makedirs(os.path.join(MINIO_DATA_DIR, "data", bucket))     # create new bucket for this run
 
     ro_params = [ "--s3-config-file",
@@ -99,6 +99,7 @@ void run_replica(int argc, char** argv) {
   auto* blockMetadata = new BlockMetadata(*replica);
 
   if (!setup->GetReplicaConfig().isReadOnly) replica->setReplicaStateSync(new ReplicaStateSyncImp(blockMetadata));
+  if (auto blockArchive = setup->GetBlockArchive()) replica->setBlockArchive(blockArchive);
 
   auto cmdHandler = std::make_shared<InternalCommandsHandler>(replica.get(), replica.get(), blockMetadata, logger);
   replica->set_command_handler(cmdHandler);
@@ -110,6 +110,8 @@ std::unique_ptr<TestSetup> TestSetup::ParseArgs(int argc, char** argv) {
       {"rocksdb-thread-pool",           required_argument, 0, 'J'},
       {"key-file-prefix",               required_argument, 0, 'k'},
       {"log-props-file",                required_argument, 0, 'l'},
+      {"consensus-batching-latency-target", 
+                                        required_argument, 0, 'L'},
       {"consensus-batching-max-reqs-size", 
                                         required_argument, 0, 'm'},
       {"network-config-file",           required_argument, 0, 'n'},
@@ -137,7 +139,7 @@ std::unique_ptr<TestSetup> TestSetup::ParseArgs(int argc, char** argv) {
     LOG_INFO(GL, "Command line options:");
     while ((o = getopt_long(
                 argc, argv, 
-                "3:a:b:B:c:de:E:f:g:i:j:J:k:l:m:n:o:p:q:r:s:t:uU:v:w:xy:Y:z:", 
+                "3:a:b:B:c:de:E:f:g:i:j:J:k:l:L:m:n:o:p:q:r:s:t:uU:v:w:xy:Y:z:", 
                 longOptions, &optionIndex)) != -1) {
       switch (o) {
         case 'i': {
@@ -222,7 +224,7 @@ std::unique_ptr<TestSetup> TestSetup::ParseArgs(int argc, char** argv) {
         }
         case 'b': {
           auto policy = concord::util::to<std::uint32_t>(std::string(optarg));
-          if (policy < bftEngine::BATCH_SELF_ADJUSTED || policy > bftEngine::BATCH_ADAPTIVE)
+          if (policy < bftEngine::BATCH_SELF_ADJUSTED || policy > bftEngine::BATCH_LATENCY_TARGET)
             throw std::runtime_error{"invalid argument for --consensus-batching-policy"};
           replicaConfig.batchingPolicy = policy;
           break;
@@ -235,6 +237,12 @@ std::unique_ptr<TestSetup> TestSetup::ParseArgs(int argc, char** argv) {
           replicaConfig.maxNumOfRequestsInBatch = concord::util::to<std::uint32_t>(std::string(optarg));
           break;
         }
+        case 'L': {
+          const auto latencyTarget = concord::util::to<std::uint32_t>(std::string(optarg));
+          if (!latencyTarget) throw std::runtime_error{"invalid argument for --consensus-batching-latency-target"};
+          replicaConfig.batchingLatencyTargetMillis = latencyTarget;
+          break;
+        }
         case 'z': {
           const auto batchFlushPeriod = concord::util::to<std::uint32_t>(std::string(optarg));
           if (!batchFlushPeriod) throw std::runtime_error{"invalid argument for --consensus-batching-flush-period"};
@@ -377,11 +385,16 @@ concord::storage::s3::StoreConfig TestSetup::ParseS3Config(const std::string& s3
   } catch (std::runtime_error& e) {
     config.pathPrefix = std::to_string(std::chrono::high_resolution_clock::now().time_since_epoch().count());
   }
+  try {
+    config.maxInFlightRequests = std::stoul(get_config_value("s3-max-in-flight-requests"));
+  } catch (std::runtime_error& e) {
+    // not set, requests are sent one after the other
+  }
 
   LOG_INFO(logger_,
            "\nS3 Configuration:"
                << "\nbucket:\t\t" << config.bucketName << "\nprotocol:\t" << config.protocol << "\nurl:\t\t"
-               << config.url);
+               << config.url << "\nin flight:\t" << config.maxInFlightRequests);
   return config;
 }
 #endif
@@ -401,6 +414,18 @@ std::unique_ptr<IStorageFactory> TestSetup::GetStorageFactory() {
   return std::make_unique<v2MerkleTree::RocksDBStorageFactory>(dbPath.str());
 }
 
+std::shared_ptr<categorization::IBlockArchive> TestSetup::GetBlockArchive() {
+#ifdef USE_S3_OBJECT_STORE
+  if (!GetReplicaConfig().isReadOnly && !s3ConfigFile_.empty()) {
+    auto s3Client = std::make_shared<concord::storage::s3::Client>(ParseS3Config(s3ConfigFile_));
+    s3Client->init();
+    return std::make_shared<categorization::DBClientBlockArchive>(
+        s3Client, "replica" + std::to_string(GetReplicaConfig().replicaId));
+  }
+#endif
+  return nullptr;
+}
+
 std::vector<std::string> TestSetup::getKeyDirectories(const std::string& path) {
   std::vector<std::string> result;
   if (!fs::exists(path) || !fs::is_directory(path)) {
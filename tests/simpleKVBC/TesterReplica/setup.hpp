@@ -24,6 +24,7 @@
 #include "config/test_parameters.hpp"
 #include "replica/Params.hpp"
 #include "storage_factory_interface.h"
+#include "categorization/block_archive.h"
 #include "PerformanceManager.hpp"
 
 #ifdef USE_S3_OBJECT_STORE
@@ -37,6 +38,9 @@ class TestSetup {
   static std::unique_ptr<TestSetup> ParseArgs(int argc, char** argv);
 
   std::unique_ptr<IStorageFactory> GetStorageFactory();
+  // Returns an archive of pruned blocks in the S3 object store if an S3 config file is given to a non read-only
+  // replica. Otherwise, returns nullptr.
+  std::shared_ptr<categorization::IBlockArchive> GetBlockArchive();
 
   const bftEngine::ReplicaConfig& GetReplicaConfig() const { return replicaConfig_; }
   bft::communication::ICommunication* GetCommunication() const { return communication_.get(); }
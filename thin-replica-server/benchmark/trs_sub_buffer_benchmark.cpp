@@ -0,0 +1,114 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+// Measures how long the commands handler (producer) spends populating a block
+// to N subscriber buffers at a fixed block rate while the subscribers consume
+// concurrently. Arguments: number of subscribers, blocks per second and the
+// per-update processing time of a subscriber in microseconds (simulates the
+// filtering and the gRPC stream).
+
+#include <benchmark/benchmark.h>
+
+#include "thin-replica-server/subscription_buffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono;
+using concord::kvbc::categorization::ImmutableInput;
+using concord::kvbc::categorization::ImmutableValueUpdate;
+using concord::thin_replica::ConsumerTooSlow;
+using concord::thin_replica::SubBufferList;
+using concord::thin_replica::SubUpdate;
+using concord::thin_replica::SubUpdateBuffer;
+
+constexpr auto kBufferSize = 1000u;
+
+SubUpdate createUpdate() {
+  auto input = ImmutableInput{};
+  for (auto i = 0; i < 10; ++i) {
+    auto val = ImmutableValueUpdate{};
+    val.data = std::string(256, 'v');
+    input.kv.emplace("key" + std::to_string(i), val);
+  }
+  return SubUpdate{0, "CID", input};
+}
+
+void populateSubBuffers(benchmark::State &state) {
+  const auto num_subscribers = state.range(0);
+  const auto block_interval = nanoseconds{seconds{1}} / state.range(1);
+  const auto consumer_delay = microseconds{state.range(2)};
+
+  auto sub_list = SubBufferList{};
+  auto buffers = std::vector<std::shared_ptr<SubUpdateBuffer>>{};
+  auto consumers = std::vector<std::thread>{};
+  auto too_slow = std::atomic_uint64_t{0};
+  for (auto i = 0; i < num_subscribers; ++i) {
+    buffers.push_back(std::make_shared<SubUpdateBuffer>(kBufferSize));
+    sub_list.addBuffer(buffers.back());
+    consumers.emplace_back([buffer = buffers.back(), consumer_delay, &too_slow]() {
+      auto update = SubUpdate{};
+      try {
+        while (true) {
+          buffer->Pop(update);
+          // The last update is used to stop the consumer
+          if (update.correlation_id.empty()) {
+            return;
+          }
+          if (consumer_delay.count() > 0) {
+            std::this_thread::sleep_for(consumer_delay);
+          }
+        }
+      } catch (const ConsumerTooSlow &) {
+        ++too_slow;
+      }
+    });
+  }
+
+  auto update = createUpdate();
+  auto next_block = steady_clock::now();
+  for (auto _ : state) {
+    std::this_thread::sleep_until(next_block);
+    next_block += block_interval;
+    ++update.block_id;
+
+    const auto start = steady_clock::now();
+    sub_list.updateSubBuffers(update);
+    const auto end = steady_clock::now();
+    state.SetIterationTime(duration_cast<duration<double>>(end - start).count());
+  }
+
+  auto stop = SubUpdate{};
+  sub_list.updateSubBuffers(stop);
+  for (auto &consumer : consumers) {
+    consumer.join();
+  }
+  state.counters["too_slow_subscribers"] = static_cast<double>(too_slow.load());
+}
+
+}  // namespace
+
+BENCHMARK(populateSubBuffers)
+    ->ArgsProduct({{1, 8, 32, 128}, {200, 1000}, {0, 50}})
+    ->ArgNames({"subscribers", "blocks_per_sec", "consumer_delay_us"})
+    ->UseManualTime()
+    ->Iterations(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -44,6 +44,10 @@ class ThinReplicaService final : public com::vmware::concord::thin_replica::Thin
                              const com::vmware::concord::thin_replica::ReadStateHashRequest* request,
                              com::vmware::concord::thin_replica::Hash* hash) override;
 
+  grpc::Status ReadEventsProof(grpc::ServerContext* context,
+                               const com::vmware::concord::thin_replica::EventsProofRequest* request,
+                               com::vmware::concord::thin_replica::EventsProof* proof) override;
+
   grpc::Status AckUpdate(grpc::ServerContext* context,
                          const com::vmware::concord::thin_replica::BlockId* block_id,
                          google::protobuf::Empty* empty) override;
@@ -68,8 +72,14 @@ class ThinReplicaService final : public com::vmware::concord::thin_replica::Thin
   struct Recorders {
     Recorders() {
       auto& registrar = concord::diagnostics::RegistrarSingleton::getInstance();
-      registrar.perf.registerComponent(
-          "trs", {readState, readStateHash, ackUpdate, subscribeToUpdates, subscribeToUpdateHashes, unsubscribe});
+      registrar.perf.registerComponent("trs",
+                                       {readState,
+                                        readStateHash,
+                                        readEventsProof,
+                                        ackUpdate,
+                                        subscribeToUpdates,
+                                        subscribeToUpdateHashes,
+                                        unsubscribe});
     }
 
     ~Recorders() {
@@ -79,6 +89,7 @@ class ThinReplicaService final : public com::vmware::concord::thin_replica::Thin
 
     DEFINE_SHARED_RECORDER(readState, 1, MAX_VALUE_MILLISECONDS, 3, concord::diagnostics::Unit::MILLISECONDS);
     DEFINE_SHARED_RECORDER(readStateHash, 1, MAX_VALUE_MILLISECONDS, 3, concord::diagnostics::Unit::MILLISECONDS);
+    DEFINE_SHARED_RECORDER(readEventsProof, 1, MAX_VALUE_MILLISECONDS, 3, concord::diagnostics::Unit::MILLISECONDS);
     DEFINE_SHARED_RECORDER(ackUpdate, 1, MAX_VALUE_MILLISECONDS, 3, concord::diagnostics::Unit::MILLISECONDS);
     DEFINE_SHARED_RECORDER(subscribeToUpdates, 1, MAX_VALUE_MILLISECONDS, 3, concord::diagnostics::Unit::MILLISECONDS);
     DEFINE_SHARED_RECORDER(
@@ -15,14 +15,19 @@
 #define CONCORD_THIN_REPLICA_SUBSCRIPTION_BUFFER_HPP_
 
 #include <categorization/updates.h>
-#include <boost/lockfree/spsc_queue.hpp>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <tuple>
 #include <unordered_set>
+#include <vector>
 #include "Logger.hpp"
 #include "assertUtils.hpp"
+#include "bounded_mpsc_queue.hpp"
 #include "block_update/block_update.hpp"
 #include "block_update/event_group_update.hpp"
 #include "kv_types.hpp"
@@ -38,21 +43,164 @@ class ConsumerTooSlow : public std::runtime_error {
 typedef kvbc::BlockUpdate SubUpdate;
 typedef kvbc::EventGroupUpdate SubEventGroupUpdate;
 
-// Each subscriber creates its own spsc queue and puts it into the shared list
-// of subscriber buffers. This is a thread-safe implementation around boost's
-// spsc queue in order to use an additional wake-up mechanism. We expect a
-// single producer (the commands handler) and a single consumer (the subscriber
-// thread in the thin replica gRPC service).
+// What to do with an update that doesn't fit into a subscriber's buffer.
+enum class SlowConsumerPolicy {
+  // Mark the buffer as unusable right away. The consumer will get a ConsumerTooSlow exception and has to close the
+  // subscription.
+  kCloseSubscription,
+  // Give the consumer a bounded amount of time to make room before closing the subscription. The producer spins
+  // (yielding) for at most the configured wait time, therefore, keep it well below the block commit interval.
+  kBoundedWait,
+};
+
+namespace detail {
+
+// A bounded lock-free queue plus a wake-up mechanism for a single blocking consumer. Producers never take a lock
+// unless the consumer is parked. Once woken up, the consumer drains the queue without going through the mutex again,
+// i.e. a burst of updates results in a single notification (batched wake-ups).
+template <typename UpdateT>
+class SubUpdateQueue {
+ public:
+  SubUpdateQueue(size_t size, SlowConsumerPolicy policy, std::chrono::microseconds max_producer_wait)
+      : queue_(size), policy_(policy), max_producer_wait_(max_producer_wait) {}
+
+  // Returns false if the update was dropped because the consumer is too slow
+  bool push(const UpdateT& update, uint64_t update_id) {
+    if (too_slow_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    // Publish the id before the update, so that the newest id is never older than an update the consumer can see.
+    newest_id_.store(update_id, std::memory_order_release);
+    if (!queue_.tryPush(update) && !pushWithPolicy(update)) {
+      // If we fail to push a new update (because the queue is full) we
+      // indicate that this queue is unusable and the reader should clean-up.
+      // Not stopping the subscription will lead to a failure on the consumer
+      // end (TRC) eventually. Therefore, let's stop it right here.
+      too_slow_.store(true, std::memory_order_release);
+      notifyConsumer();
+      return false;
+    }
+    notifyConsumer();
+    return true;
+  }
+
+  // Block until an update is available or the consumer is marked as too slow
+  void pop(UpdateT& out) {
+    while (true) {
+      if (too_slow_.load(std::memory_order_acquire)) {
+        // We throw an exception because we cannot handle the clean-up ourselves
+        // and it doesn't make sense to continue pushing/popping updates.
+        throw ConsumerTooSlow();
+      }
+      if (queue_.tryPop(out)) {
+        return;
+      }
+      wait([this] { return too_slow_.load(std::memory_order_acquire) || !queue_.empty(); });
+    }
+  }
+
+  void waitUntilNonEmpty() {
+    wait([this] { return !queue_.empty(); });
+  }
+
+  template <typename RepT, typename PeriodT>
+  bool waitUntilNonEmpty(const std::chrono::duration<RepT, PeriodT>& duration) {
+    return wait_for(duration, [this] { return !queue_.empty(); });
+  }
+
+  // Must be called by the consumer (or once the consumer is gone). Producers may still be active.
+  void clear() { queue_.clear(); }
+
+  // Only updates that are completely written count, i.e. if the consumer sees a non-empty queue, front() returns the
+  // oldest update. The newest id might belong to an update that is being pushed.
+  const UpdateT* front() const { return queue_.front(); }
+  uint64_t newestId() const { return newest_id_.load(std::memory_order_acquire); }
+  size_t size() const { return queue_.size(); }
+  bool empty() const { return queue_.empty(); }
+  bool full() const { return queue_.full(); }
+
+ private:
+  bool pushWithPolicy(const UpdateT& update) {
+    if (policy_ != SlowConsumerPolicy::kBoundedWait) {
+      return false;
+    }
+    // Make sure the consumer is awake and drains the queue while we are waiting
+    notifyConsumer();
+    const auto deadline = std::chrono::steady_clock::now() + max_producer_wait_;
+    do {
+      std::this_thread::yield();
+      if (queue_.tryPush(update)) {
+        return true;
+      }
+    } while (std::chrono::steady_clock::now() < deadline);
+    return false;
+  }
+
+  // The producer publishes a notification before checking whether the consumer is sleeping and the consumer announces
+  // that it is going to sleep before re-checking for notifications. Both sides use sequentially consistent operations,
+  // hence, either the producer sees the sleeping consumer and wakes it up under the mutex, or the consumer sees the
+  // new update and doesn't go to sleep.
+  void notifyConsumer() {
+    notifications_.fetch_add(1, std::memory_order_seq_cst);
+    if (consumer_sleeping_.load(std::memory_order_seq_cst)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cv_.notify_one();
+    }
+  }
+
+  template <typename PredT>
+  void wait(PredT pred) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    consumer_sleeping_.store(true, std::memory_order_seq_cst);
+    cv_.wait(lock, [&] {
+      notifications_.load(std::memory_order_seq_cst);
+      return pred();
+    });
+    consumer_sleeping_.store(false, std::memory_order_seq_cst);
+  }
+
+  template <typename RepT, typename PeriodT, typename PredT>
+  bool wait_for(const std::chrono::duration<RepT, PeriodT>& duration, PredT pred) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    consumer_sleeping_.store(true, std::memory_order_seq_cst);
+    auto result = cv_.wait_for(lock, duration, [&] {
+      notifications_.load(std::memory_order_seq_cst);
+      return pred();
+    });
+    consumer_sleeping_.store(false, std::memory_order_seq_cst);
+    return result;
+  }
+
+  concord::util::BoundedMpscQueue<UpdateT> queue_;
+  const SlowConsumerPolicy policy_;
+  const std::chrono::microseconds max_producer_wait_;
+
+  // Indicate whether the consumer doesn't read fast enough
+  std::atomic_bool too_slow_{false};
+  std::atomic_uint64_t newest_id_{0};
+
+  // Only used to park the consumer if there is nothing to read
+  std::atomic_uint64_t notifications_{0};
+  std::atomic_bool consumer_sleeping_{false};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}  // namespace detail
+
+// Each subscriber creates its own queue and puts it into the shared list of
+// subscriber buffers. The queues are bounded and lock-free for the producer
+// (the commands handler): pushing an update never waits on the subscriber. The
+// consumer is the subscriber thread in the thin replica gRPC service and only
+// blocks if there is nothing to read.
 class SubUpdateBuffer {
  public:
-  explicit SubUpdateBuffer(size_t size)
+  explicit SubUpdateBuffer(size_t size,
+                           SlowConsumerPolicy policy = SlowConsumerPolicy::kCloseSubscription,
+                           std::chrono::microseconds max_producer_wait = std::chrono::microseconds{0})
       : logger_(logging::getLogger("concord.thin_replica.sub_buffer")),
-        queue_(size),
-        eg_queue_(size),
-        too_slow_(false),
-        eg_too_slow_(false),
-        newest_block_id_(0),
-        newest_event_group_id_(0) {}
+        queue_(size, policy, max_producer_wait),
+        eg_queue_(size, policy, max_producer_wait) {}
 
   // Let's help ourselves and make sure we don't copy this buffer
   SubUpdateBuffer(const SubUpdateBuffer&) = delete;
@@ -60,198 +208,110 @@ class SubUpdateBuffer {
 
   // Add an update to the queue and notify waiting subscribers
   void Push(const SubUpdate& update) {
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-      if (!too_slow_ && !queue_.push(update)) {
-        // If we fail to push a new update (because the queue is full) we
-        // indicate that this queue is unusable and the reader should clean-up.
-        // Not stopping the subscription will lead to a failure on the consumer
-        // end (TRC) eventually. Therefore, let's stop it right here.
-        too_slow_ = true;
-        LOG_WARN(logger_, "Failed to add update. Consumer too slow.");
-      } else {
-        newest_block_id_ = update.block_id;
-      }
+    if (!queue_.push(update, update.block_id)) {
+      LOG_WARN(logger_, "Failed to add update. Consumer too slow.");
     }
-    cv_.notify_one();
   };
 
   // Add an update to the queue and notify waiting subscribers
   void PushEventGroup(const SubEventGroupUpdate& update) {
-    {
-      std::unique_lock<std::mutex> lock(eg_mutex_);
-      if (!eg_too_slow_ && !eg_queue_.push(update)) {
-        // If we fail to push a new update (because the queue is full) we
-        // indicate that this queue is unusable and the reader should clean-up.
-        // Not stopping the subscription will lead to a failure on the consumer
-        // end (TRC) eventually. Therefore, let's stop it right here.
-        eg_too_slow_ = true;
-        LOG_WARN(logger_, "Failed to add update. Consumer too slow.");
-      } else {
-        newest_event_group_id_ = update.event_group_id;
-      }
+    if (!eg_queue_.push(update, update.event_group_id)) {
+      LOG_WARN(logger_, "Failed to add update. Consumer too slow.");
     }
-    eg_cv_.notify_one();
   };
 
   // Return the oldest update (block if queue is empty)
-  void Pop(SubUpdate& out) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    // Boost's spsc queue is wait-free but we want to block here
-    cv_.wait(lock, [this] { return too_slow_ || queue_.read_available(); });
-
-    if (too_slow_) {
-      // We throw an exception because we cannot handle the clean-up ourselves
-      // and it doesn't make sense to continue pushing/popping updates.
-      throw ConsumerTooSlow();
-    }
-
-    ConcordAssert(queue_.pop(out));
-  };
+  void Pop(SubUpdate& out) { queue_.pop(out); };
 
   // Return the oldest update (event group if queue is empty)
-  void PopEventGroup(SubEventGroupUpdate& out) {
-    std::unique_lock<std::mutex> lock(eg_mutex_);
-    // Boost's spsc queue is wait-free but we want to block here
-    eg_cv_.wait(lock, [this] { return eg_too_slow_ || eg_queue_.read_available(); });
-
-    if (eg_too_slow_) {
-      // We throw an exception because we cannot handle the clean-up ourselves
-      // and it doesn't make sense to continue pushing/popping updates.
-      throw ConsumerTooSlow();
-    }
+  void PopEventGroup(SubEventGroupUpdate& out) { eg_queue_.pop(out); };
 
-    ConcordAssert(eg_queue_.pop(out));
-  };
-
-  void waitUntilNonEmpty() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    cv_.wait(lock, [this] { return queue_.read_available(); });
-  }
+  void waitUntilNonEmpty() { queue_.waitUntilNonEmpty(); }
 
   template <typename RepT, typename PeriodT>
   [[nodiscard]] bool waitUntilNonEmpty(const std::chrono::duration<RepT, PeriodT>& duration) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return cv_.wait_for(lock, duration, [this] { return queue_.read_available(); });
+    return queue_.waitUntilNonEmpty(duration);
   }
 
-  void waitForEventGroupUntilNonEmpty() {
-    std::unique_lock<std::mutex> lock(eg_mutex_);
-    eg_cv_.wait(lock, [this] { return queue_.read_available(); });
-  }
+  void waitForEventGroupUntilNonEmpty() { eg_queue_.waitUntilNonEmpty(); }
 
   template <typename RepT, typename PeriodT>
   [[nodiscard]] bool waitForEventGroupUntilNonEmpty(const std::chrono::duration<RepT, PeriodT>& duration) {
-    std::unique_lock<std::mutex> lock(eg_mutex_);
-    return eg_cv_.wait_for(lock, duration, [this] { return eg_queue_.read_available(); });
+    return eg_queue_.waitUntilNonEmpty(duration);
   }
 
-  // This is not thread-safe and the caller has to make sure that there is no
-  // writer or reader active. This is a trade-off in order to stay lock-free.
-  void removeAllUpdates() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    queue_.reset();
-  }
+  // Has to be called by the consumer or after the consumer is gone. A producer
+  // which still holds a reference to this buffer may push concurrently.
+  void removeAllUpdates() { queue_.clear(); }
 
-  // This is not thread-safe and the caller has to make sure that there is no
-  // writer or reader active. This is a trade-off in order to stay lock-free.
-  void removeAllEventGroupUpdates() {
-    std::unique_lock<std::mutex> lock(eg_mutex_);
-    eg_queue_.reset();
-  }
+  // Has to be called by the consumer or after the consumer is gone. A producer
+  // which still holds a reference to this buffer may push concurrently.
+  void removeAllEventGroupUpdates() { eg_queue_.clear(); }
 
   // The caller needs to make sure that the queue is not empty when calling
   kvbc::BlockId newestBlockId() {
-    std::unique_lock<std::mutex> lock(mutex_);
     // We cannot reach the newest element without consuming the others. Hence,
     // the counter is a workaround but it requires that there is at least one
     // element in the queue.
-    ConcordAssertGT(queue_.read_available(), 0);
-    return newest_block_id_;
+    ConcordAssert(!queue_.empty());
+    return queue_.newestId();
   }
 
   // The caller needs to make sure that the queue is not empty when calling
   kvbc::EventGroupId newestEventGroupId() {
-    std::unique_lock<std::mutex> lock(eg_mutex_);
     // We cannot reach the newest element without consuming the others. Hence,
     // the counter is a workaround but it requires that there is at least one
     // element in the queue.
-    ConcordAssertGT(eg_queue_.read_available(), 0);
-    return newest_event_group_id_;
+    ConcordAssert(!eg_queue_.empty());
+    return eg_queue_.newestId();
   }
 
-  // The caller needs to make sure that the queue is not empty when calling
+  // The caller (consumer) needs to make sure that the queue is not empty when calling
   kvbc::BlockId oldestBlockId() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    // Undefined behavior if the queue is empty
-    ConcordAssertGT(queue_.read_available(), 0);
-    return queue_.front().block_id;
+    auto front = queue_.front();
+    ConcordAssert(front != nullptr);
+    return front->block_id;
   }
 
-  // The caller needs to make sure that the queue is not empty when calling
+  // The caller (consumer) needs to make sure that the queue is not empty when calling
   kvbc::EventGroupId oldestEventGroupId() {
-    std::unique_lock<std::mutex> lock(eg_mutex_);
-    // Undefined behavior if the queue is empty
-    ConcordAssertGT(eg_queue_.read_available(), 0);
-    return eg_queue_.front().event_group_id;
+    auto front = eg_queue_.front();
+    ConcordAssert(front != nullptr);
+    return front->event_group_id;
   }
 
-  bool Empty() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return !queue_.read_available();
-  }
+  bool Empty() { return queue_.empty(); }
 
-  bool EmptyEventGroupQueue() {
-    std::unique_lock<std::mutex> lock(eg_mutex_);
-    return !eg_queue_.read_available();
-  }
+  bool EmptyEventGroupQueue() { return eg_queue_.empty(); }
 
-  bool Full() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return !queue_.write_available();
-  }
+  bool Full() { return queue_.full(); }
 
-  bool FullEventGroupQueue() {
-    std::unique_lock<std::mutex> lock(eg_mutex_);
-    return !eg_queue_.write_available();
-  }
+  bool FullEventGroupQueue() { return eg_queue_.full(); }
 
   // Return the number of elements in the queue
-  size_t Size() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return queue_.read_available();
-  }
+  size_t Size() { return queue_.size(); }
 
   // Return the number of elements in the queue
-  size_t SizeEventGroupQueue() {
-    std::unique_lock<std::mutex> lock(eg_mutex_);
-    return eg_queue_.read_available();
-  }
+  size_t SizeEventGroupQueue() { return eg_queue_.size(); }
 
  private:
   logging::Logger logger_;
-  boost::lockfree::spsc_queue<SubUpdate> queue_;
-  boost::lockfree::spsc_queue<SubEventGroupUpdate> eg_queue_;
-  // lock used for updating the queue as well as the variables below
-  std::mutex mutex_;
-  std::condition_variable cv_;
-  std::mutex eg_mutex_;
-  std::condition_variable eg_cv_;
-
-  // Indidcate whether the consumer doesn't read fast enough
-  bool too_slow_;
-  bool eg_too_slow_;
-  uint64_t newest_block_id_;
-  uint64_t newest_event_group_id_;
+  detail::SubUpdateQueue<SubUpdate> queue_;
+  detail::SubUpdateQueue<SubEventGroupUpdate> eg_queue_;
 };
 
 // Thread-safe list implementation which manages subscriber queues. You can
 // think of this list as the list of subscribers whereby each subscriber is
-// represented by its spsc queue. The presence or absence of a buffer determines
+// represented by its queue. The presence or absence of a buffer determines
 // whether a subscriber is subscribed or unsubscribed respectively.
+// Subscribing and unsubscribing is rare compared to populating updates.
+// Therefore, modifications publish an immutable snapshot of the subscribers
+// which the producer reads without taking the list's lock.
 class SubBufferList {
+  using Snapshot = std::vector<std::shared_ptr<SubUpdateBuffer>>;
+
  public:
-  SubBufferList() {}
+  SubBufferList() : snapshot_(std::make_shared<const Snapshot>()) {}
 
   // Let's help ourselves and make sure we don't copy this list
   SubBufferList(const SubBufferList&) = delete;
@@ -261,6 +321,7 @@ class SubBufferList {
   virtual bool addBuffer(std::shared_ptr<SubUpdateBuffer> elem) {
     std::lock_guard<std::mutex> lock(mutex_);
     auto success = subscriber_.insert(elem).second;
+    publishSnapshot();
     return success;
   }
 
@@ -269,22 +330,23 @@ class SubBufferList {
     std::lock_guard<std::mutex> lock(mutex_);
     // If the assert fires then there is a logic error somewhere
     ConcordAssert(subscriber_.erase(elem) == 1);
+    publishSnapshot();
   }
 
   // Populate updates to all subscribers
   // Note: This is potentially expensive depending on the update size and the
-  // number of subscribers. If TRC/TRS stays then we might want to think about
-  // an optimization.
+  // number of subscribers. A buffer which was removed concurrently might still
+  // receive this update; that's fine because it is not read anymore.
   virtual void updateSubBuffers(SubUpdate& update) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    for (const auto& it : subscriber_) {
+    const auto subscribers = std::atomic_load(&snapshot_);
+    for (const auto& it : *subscribers) {
       it->Push(update);
     }
   }
 
   virtual void updateEventGroupSubBuffers(SubEventGroupUpdate& update) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    for (const auto& it : subscriber_) {
+    const auto subscribers = std::atomic_load(&snapshot_);
+    for (const auto& it : *subscribers) {
       it->PushEventGroup(update);
     }
   }
@@ -297,8 +359,16 @@ class SubBufferList {
   virtual ~SubBufferList() = default;
 
  protected:
+  // Needs to be called with mutex_ held
+  void publishSnapshot() {
+    std::atomic_store(&snapshot_, std::make_shared<const Snapshot>(subscriber_.cbegin(), subscriber_.cend()));
+  }
+
   std::unordered_set<std::shared_ptr<SubUpdateBuffer>> subscriber_;
   std::mutex mutex_;
+
+ private:
+  std::shared_ptr<const Snapshot> snapshot_;
 };
 
 }  // namespace thin_replica
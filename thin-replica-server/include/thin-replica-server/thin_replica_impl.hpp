@@ -25,10 +25,12 @@
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include "Logger.hpp"
 #include "Metrics.hpp"
 
 #include "db_interfaces.h"
+#include "endianness.hpp"
 #include "kv_types.hpp"
 #include "kvbc_app_filter/kvbc_app_filter.h"
 #include "kvbc_app_filter/kvbc_key_types.h"
@@ -50,8 +52,8 @@ struct ThinReplicaServerConfig {
   const std::string tls_trs_cert_path;
   // read-only storage is a concord key-value blockchain's read interface
   const concord::kvbc::IReader* rostorage;
-  // subscriber_list is a list of subscribers where each subscriber is an spsc
-  // queue. The updates are produced by the commands handler (single producer).
+  // subscriber_list is a list of subscribers where each subscriber is a
+  // bounded lock-free queue. The updates are produced by the commands handler
   // and consumed by the subscribers (single consumer) in the subscriber_list.
   // TRS acts as an intermediary, it waits for updates, filters them and sends
   // them to the subscribers.
@@ -61,19 +63,32 @@ struct ThinReplicaServerConfig {
   std::unordered_set<std::string> client_id_set;
   // the threshold after which metrics aggregator is updated
   const uint16_t update_metrics_aggregator_thresh;
+  // the number of live updates a subscriber can lag behind the commands handler
+  const size_t sub_buffer_size;
+  // what to do if a subscriber's live update buffer is full
+  const SlowConsumerPolicy slow_consumer_policy;
+  // how long the commands handler waits for a full buffer to drain (only used
+  // by SlowConsumerPolicy::kBoundedWait)
+  const std::chrono::microseconds slow_consumer_max_wait;
 
   ThinReplicaServerConfig(const bool is_insecure_trs_,
                           const std::string& tls_trs_cert_path_,
                           const concord::kvbc::IReader* rostorage_,
                           SubBufferList& subscriber_list_,
                           std::unordered_set<std::string>& client_id_set_,
-                          const uint16_t update_metrics_aggregator_thresh_ = 100)
+                          const uint16_t update_metrics_aggregator_thresh_ = 100,
+                          const size_t sub_buffer_size_ = 1000u,
+                          const SlowConsumerPolicy slow_consumer_policy_ = SlowConsumerPolicy::kCloseSubscription,
+                          const std::chrono::microseconds slow_consumer_max_wait_ = std::chrono::microseconds{0})
       : is_insecure_trs(is_insecure_trs_),
         tls_trs_cert_path(tls_trs_cert_path_),
         rostorage(rostorage_),
         subscriber_list(subscriber_list_),
         client_id_set(client_id_set_),
-        update_metrics_aggregator_thresh(update_metrics_aggregator_thresh_) {}
+        update_metrics_aggregator_thresh(update_metrics_aggregator_thresh_),
+        sub_buffer_size(sub_buffer_size_),
+        slow_consumer_policy(slow_consumer_policy_),
+        slow_consumer_max_wait(slow_consumer_max_wait_) {}
 };
 
 class ThinReplicaImpl {
@@ -88,7 +103,6 @@ class ThinReplicaImpl {
   };
 
   using KvbAppFilterPtr = std::shared_ptr<kvbc::KvbAppFilter>;
-  static constexpr size_t kSubUpdateBufferSize{1000u};
   const std::string kCorrelationIdTag = "cid";
 
  public:
@@ -200,6 +214,65 @@ class ThinReplicaImpl {
     return grpc::Status::OK;
   }
 
+  template <typename ServerContextT>
+  grpc::Status ReadEventsProof(ServerContextT* context,
+                               const com::vmware::concord::thin_replica::EventsProofRequest* request,
+                               com::vmware::concord::thin_replica::EventsProof* proof) {
+    std::string client_id;
+    try {
+      client_id = getClientId(context);
+    } catch (std::exception& error) {
+      std::stringstream msg;
+      msg << "Failed to get the client id: " << error.what();
+      LOG_ERROR(logger_, msg.str());
+      return grpc::Status(grpc::StatusCode::UNKNOWN, msg.str());
+    }
+
+    const auto block_id = request->block_id();
+    LOG_DEBUG(logger_, "ReadEventsProof" << KVLOG(client_id, block_id, request->keys_size()));
+
+    // Events are stored with the block ID as a key prefix.
+    const auto key_prefix = concordUtils::toBigEndianStringBuffer(block_id);
+    auto keys = std::vector<std::string>{};
+    keys.reserve(request->keys_size());
+    for (const auto& key : request->keys()) {
+      keys.push_back(key_prefix + key);
+    }
+
+    std::optional<kvbc::categorization::MultiKeyValueProof> multi_proof;
+    try {
+      multi_proof =
+          config_->rostorage->getMultiProof(kvbc::categorization::kExecutionEventsCategory, block_id, keys, client_id);
+    } catch (std::exception& error) {
+      LOG_ERROR(logger_, error.what());
+      std::stringstream msg;
+      msg << "Reading events proof for block " << block_id << " failed";
+      return grpc::Status(grpc::StatusCode::UNKNOWN, msg.str());
+    }
+    const auto root_hash = multi_proof ? multi_proof->calculateRootHash() : std::nullopt;
+    if (!root_hash) {
+      std::stringstream msg;
+      msg << "No proof for the given keys in block " << block_id;
+      LOG_WARN(logger_, msg.str());
+      return grpc::Status(grpc::StatusCode::NOT_FOUND, msg.str());
+    }
+
+    proof->set_block_id(block_id);
+    for (auto& [key, value] : multi_proof->key_values) {
+      auto kv = proof->add_data();
+      kv->set_key(std::move(key));
+      kv->set_value(std::move(value));
+    }
+    for (const auto index : multi_proof->key_value_indexes) {
+      proof->add_key_value_indexes(index);
+    }
+    for (const auto& hash : multi_proof->ordered_complement_kv_hashes) {
+      proof->add_ordered_complement_kv_hashes(hash.data(), hash.size());
+    }
+    proof->set_root_hash(root_hash->data(), root_hash->size());
+    return grpc::Status::OK;
+  }
+
   template <typename ServerContextT>
   grpc::Status AckUpdate(ServerContextT* context,
                          const com::vmware::concord::thin_replica::BlockId* block_id,
@@ -896,7 +969,8 @@ class ThinReplicaImpl {
   template <typename RequestT>
   std::tuple<grpc::Status, std::shared_ptr<SubUpdateBuffer>> subscribeToLiveUpdates(RequestT* request,
                                                                                     const std::string& client_id) {
-    auto live_updates = std::make_shared<SubUpdateBuffer>(kSubUpdateBufferSize);
+    auto live_updates = std::make_shared<SubUpdateBuffer>(
+        config_->sub_buffer_size, config_->slow_consumer_policy, config_->slow_consumer_max_wait);
     bool success = config_->subscriber_list.addBuffer(live_updates);
     if (!success) {
       std::stringstream msg;
@@ -18,6 +18,8 @@ using grpc::ServerWriter;
 
 using com::vmware::concord::thin_replica::BlockId;
 using com::vmware::concord::thin_replica::Data;
+using com::vmware::concord::thin_replica::EventsProof;
+using com::vmware::concord::thin_replica::EventsProofRequest;
 using com::vmware::concord::thin_replica::Hash;
 using com::vmware::concord::thin_replica::ReadStateHashRequest;
 using com::vmware::concord::thin_replica::ReadStateRequest;
@@ -42,6 +44,13 @@ grpc::Status ThinReplicaService::ReadStateHash(ServerContext* context,
   return impl_->ReadStateHash(context, request, hash);
 }
 
+grpc::Status ThinReplicaService::ReadEventsProof(ServerContext* context,
+                                                 const EventsProofRequest* request,
+                                                 EventsProof* proof) {
+  diagnostics::TimeRecorder scoped_timer(*histograms_.readEventsProof);
+  return impl_->ReadEventsProof(context, request, proof);
+}
+
 grpc::Status ThinReplicaService::AckUpdate(ServerContext* context,
                                            const BlockId* block_id,
                                            google::protobuf::Empty* empty) {
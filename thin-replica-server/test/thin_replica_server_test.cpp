@@ -33,6 +33,8 @@ using concord::kvbc::BlockId;
 using concord::kvbc::categorization::ImmutableInput;
 
 using com::vmware::concord::thin_replica::Data;
+using com::vmware::concord::thin_replica::EventsProof;
+using com::vmware::concord::thin_replica::EventsProofRequest;
 using com::vmware::concord::thin_replica::Hash;
 using com::vmware::concord::thin_replica::ReadStateHashRequest;
 using com::vmware::concord::thin_replica::ReadStateRequest;
@@ -134,6 +136,28 @@ class FakeStorage : public concord::kvbc::IReader {
     return {};
   }
 
+  // Returns a proof in which the value of each key is the key itself.
+  std::optional<concord::kvbc::categorization::MultiKeyValueProof> getMultiProof(
+      const std::string& category_id,
+      BlockId block_id,
+      const std::vector<std::string>& keys,
+      const std::string& tag) const override {
+    EXPECT_EQ(category_id, concord::kvbc::categorization::kExecutionEventsCategory);
+    EXPECT_EQ(tag, "TEST ID");
+    std::scoped_lock sl(mtx_);
+    if (block_id == 0 || block_id > block_id_) {
+      return std::nullopt;
+    }
+    auto proof = concord::kvbc::categorization::MultiKeyValueProof{};
+    proof.block_id = block_id;
+    for (const auto& key : keys) {
+      proof.key_values.emplace_back(key, key);
+      proof.key_value_indexes.push_back(0);
+    }
+    proof.ordered_complement_kv_hashes.resize(2);
+    return proof;
+  }
+
   BlockId getGenesisBlockId() const override {
     ADD_FAILURE() << "get() should not be called by this test";
     return 0;
@@ -445,6 +469,44 @@ TEST(thin_replica_server_test, ReadStateHash) {
   EXPECT_EQ(hash.events().block_id(), kLastBlockId);
 }
 
+TEST(thin_replica_server_test, ReadEventsProof) {
+  FakeStorage storage{generate_kvp(1, kLastBlockId)};
+  auto live_update_blocks = generate_kvp(0, 0);
+  TestStateMachine<Hash> state_machine{storage, live_update_blocks, 0u};
+  TestSubBufferList<Hash> buffer{state_machine};
+
+  bool is_insecure_trs = true;
+  std::string tls_trs_cert_path;
+  std::unordered_set<std::string> client_id_set;
+  uint16_t update_metrics_aggregator_thresh = 100;
+
+  auto trs_config = std::make_unique<concord::thin_replica::ThinReplicaServerConfig>(
+      is_insecure_trs, tls_trs_cert_path, &storage, buffer, client_id_set, update_metrics_aggregator_thresh);
+  concord::thin_replica::ThinReplicaImpl replica(std::move(trs_config), std::make_shared<concordMetrics::Aggregator>());
+  TestServerContext context;
+  EventsProofRequest request;
+  request.set_block_id(kLastBlockId);
+  request.add_keys("k1");
+  request.add_keys("k2");
+  EventsProof proof;
+  auto status = replica.ReadEventsProof(&context, &request, &proof);
+  EXPECT_EQ(status.error_code(), grpc::StatusCode::OK);
+  EXPECT_EQ(proof.block_id(), kLastBlockId);
+  ASSERT_EQ(proof.data_size(), 2);
+  // Keys are prefixed with the block ID.
+  const auto key_prefix = concordUtils::toBigEndianStringBuffer(kLastBlockId);
+  EXPECT_EQ(proof.data(0).key(), key_prefix + "k1");
+  EXPECT_EQ(proof.data(1).key(), key_prefix + "k2");
+  EXPECT_EQ(proof.key_value_indexes_size(), 2);
+  EXPECT_EQ(proof.ordered_complement_kv_hashes_size(), 2);
+  EXPECT_EQ(proof.root_hash().size(), sizeof(concord::kvbc::categorization::Hash));
+
+  EventsProof no_proof;
+  request.set_block_id(kLastBlockId + 1);
+  status = replica.ReadEventsProof(&context, &request, &no_proof);
+  EXPECT_EQ(status.error_code(), grpc::StatusCode::NOT_FOUND);
+}
+
 TEST(thin_replica_server_test, AckUpdate) {
   FakeStorage storage{generate_kvp(0, 0)};
   auto live_update_blocks = generate_kvp(0, 0);
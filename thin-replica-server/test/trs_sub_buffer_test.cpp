@@ -16,6 +16,7 @@
 #include <atomic>
 #include <future>
 #include <list>
+#include <thread>
 #include "Logger.hpp"
 #include "thin-replica-server/subscription_buffer.hpp"
 
@@ -26,6 +27,7 @@ using concord::kvbc::categorization::ImmutableValueUpdate;
 using concord::kvbc::categorization::EventGroup;
 using concord::kvbc::categorization::Event;
 using concord::thin_replica::ConsumerTooSlow;
+using concord::thin_replica::SlowConsumerPolicy;
 using concord::thin_replica::SubBufferList;
 using concord::thin_replica::SubUpdate;
 using concord::thin_replica::SubEventGroupUpdate;
@@ -170,6 +172,37 @@ TEST(trs_sub_buffer_test, block_consumer_if_no_updates_available_eg) {
   sub_list.updateEventGroupSubBuffers(update);
 }
 
+// Once the consumer was woken up, the oldest and the newest update must be readable while the producer keeps pushing.
+TEST(trs_sub_buffer_test, wait_then_front_with_concurrent_producer) {
+  const auto num_updates = 10000u;
+  auto updates = std::make_shared<SubUpdateBuffer>(16);
+  auto producer = std::async(std::launch::async, [&] {
+    ImmutableInput input;
+    ImmutableValueUpdate val;
+    val.data = "value";
+    input.kv = {{"key", val}};
+    SubUpdate update{0, "CID", input};
+    for (auto i = 1u; i <= num_updates; ++i) {
+      update.block_id = i;
+      while (updates->Full()) {
+        std::this_thread::yield();
+      }
+      updates->Push(update);
+    }
+  });
+
+  SubUpdate update;
+  for (auto i = 1u; i <= num_updates; ++i) {
+    updates->waitUntilNonEmpty();
+    ASSERT_FALSE(updates->Empty());
+    ASSERT_EQ(updates->oldestBlockId(), i);
+    ASSERT_GE(updates->newestBlockId(), i);
+    updates->Pop(update);
+    ASSERT_EQ(update.block_id, i);
+  }
+  producer.get();
+}
+
 TEST(trs_sub_buffer_test, happy_path_w_two_consumers) {
   SubBufferList sub_list;
   ImmutableInput input;
@@ -233,6 +266,94 @@ TEST(trs_sub_buffer_test, happy_path_w_two_consumers_eg) {
   }
 }
 
+// With the bounded wait policy, the producer gives a consumer which is
+// actively reading a chance to make room instead of closing the subscription.
+TEST(trs_sub_buffer_test, bounded_wait_lets_consumer_catch_up) {
+  SubBufferList sub_list;
+  ImmutableInput input;
+  ImmutableValueUpdate val;
+  val.data = "value";
+  input.kv = {{"key", val}};
+  SubUpdate update{0, "CID", input};
+  auto updates = std::make_shared<SubUpdateBuffer>(2, SlowConsumerPolicy::kBoundedWait, std::chrono::seconds{10});
+  int num_updates = 100;
+
+  auto reader = std::async(std::launch::async, [&] {
+    SubUpdate consumer_update;
+    for (int i = 0; i < num_updates; ++i) {
+      updates->Pop(consumer_update);
+      ASSERT_EQ(consumer_update.block_id, i);
+    }
+  });
+
+  sub_list.addBuffer(updates);
+  for (int i = 0; i < num_updates; ++i) {
+    update.block_id = i;
+    sub_list.updateSubBuffers(update);
+  }
+  reader.get();
+}
+
+// The bounded wait policy still closes the subscription if the consumer
+// doesn't make room within the configured time.
+TEST(trs_sub_buffer_test, bounded_wait_throws_if_consumer_too_slow) {
+  SubBufferList sub_list;
+  EventGroup event_group;
+  Event event;
+  event.data = "value";
+  event_group.events.emplace_back(event);
+  SubEventGroupUpdate update{1337, event_group};
+  auto updates =
+      std::make_shared<SubUpdateBuffer>(10, SlowConsumerPolicy::kBoundedWait, std::chrono::milliseconds{1});
+
+  sub_list.addBuffer(updates);
+  for (unsigned i = 0; i < 11; ++i) {
+    sub_list.updateEventGroupSubBuffers(update);
+  }
+
+  SubEventGroupUpdate consumer_update;
+  EXPECT_THROW(updates->PopEventGroup(consumer_update), ConsumerTooSlow);
+}
+
+TEST(trs_sub_buffer_test, wait_until_non_empty_with_timeout) {
+  auto updates = std::make_shared<SubUpdateBuffer>(10);
+  ASSERT_FALSE(updates->waitUntilNonEmpty(std::chrono::milliseconds{1}));
+  ASSERT_FALSE(updates->waitForEventGroupUntilNonEmpty(std::chrono::milliseconds{1}));
+
+  EventGroup event_group;
+  SubEventGroupUpdate update{1337, event_group};
+  updates->PushEventGroup(update);
+  ASSERT_FALSE(updates->waitUntilNonEmpty(std::chrono::milliseconds{1}));
+  ASSERT_TRUE(updates->waitForEventGroupUntilNonEmpty(std::chrono::milliseconds{1}));
+  ASSERT_EQ(updates->oldestEventGroupId(), 1337);
+  ASSERT_EQ(updates->newestEventGroupId(), 1337);
+}
+
+// Subscribers can come and go while the producer is populating updates.
+TEST(trs_sub_buffer_test, subscribe_while_producing) {
+  SubBufferList sub_list;
+  ImmutableInput input;
+  SubUpdate update{0, "CID", input};
+  std::atomic_bool done{false};
+
+  auto producer = std::async(std::launch::async, [&] {
+    for (int i = 0; i < 10000; ++i) {
+      update.block_id = i;
+      sub_list.updateSubBuffers(update);
+    }
+    done = true;
+  });
+
+  while (!done) {
+    auto buffer = std::make_shared<SubUpdateBuffer>(10);
+    sub_list.addBuffer(buffer);
+    sub_list.removeBuffer(buffer);
+    buffer->removeAllUpdates();
+  }
+  producer.get();
+  ASSERT_EQ(sub_list.Size(), 0);
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
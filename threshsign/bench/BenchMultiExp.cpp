@@ -44,28 +44,35 @@ int RelicAppMain(const Library& lib, const std::vector<std::string>& args) {
   // NOTE: srand is not and should not be used for any cryptographic randomness.
   srand(seed);
 
+  // Replica counts from a single fault up to f = 100, combining 2f + 1 shares
+  std::vector<int> numSigners = {4, 7, 16, 31, 64, 100, 151, 201, 301};
+
   LOG_INFO(THRESHSIGN_LOG, "Benchmarking fast exponentiated multiplication in G1...");
-  benchFastMultExp<G1T>(100, 1500, 1000);
+  for (int n : numSigners) {
+    benchFastMultExp<G1T>(100, n, 2 * ((n - 1) / 3) + 1);
+  }
 
   LOG_INFO(THRESHSIGN_LOG, "");
 
   LOG_INFO(THRESHSIGN_LOG, "Benchmarking fast exponentiated multiplication in G2...");
-  benchFastMultExp<G2T>(100, 1500, 1000);
+  for (int n : numSigners) {
+    benchFastMultExp<G2T>(20, n, 2 * ((n - 1) / 3) + 1);
+  }
 
   return 0;
 }
 
 template <class GT>
 void benchFastMultExp(int numIters, int numSigners, int reqSigners) {
-  GT r1, r2, r3;
-  int n = numSigners + (rand() % 2);
-  int k = reqSigners + (rand() % 2);
+  GT r1, r2, r3, r4, r5;
+  int n = numSigners;
+  int k = reqSigners;
   assertLessThanOrEqual(reqSigners, numSigners);
   int maxBits = Library::Get().getG2OrderNumBits();
   // int maxBits = 256;
   LOG_INFO(THRESHSIGN_LOG,
            "iters = " << numIters << ", reqSigners = " << reqSigners << ", numSigners = " << numSigners
-                      << ", max bits = " << maxBits);
+                      << ", max bits = " << maxBits << ", Pippenger window bits = " << pippengerWindowBits(k, maxBits));
 
   VectorOfShares s;
   VectorOfShares::randomSubset(s, n, k);
@@ -83,6 +90,8 @@ void benchFastMultExp(int numIters, int numSigners, int reqSigners) {
   assertEqual(r1, GT::Identity());
   assertEqual(r2, GT::Identity());
   assertEqual(r3, GT::Identity());
+  assertEqual(r4, GT::Identity());
+  assertEqual(r5, GT::Identity());
 
   // Slow way
   AveragingTimer t1("Naive way:      ");
@@ -115,13 +124,30 @@ void benchFastMultExp(int numIters, int numSigners, int reqSigners) {
     t3.endLap();
   }
 
+  AveragingTimer t4("Pippenger:      ");
+  for (int i = 0; i < numIters; i++) {
+    t4.startLap();
+    r4 = multExpPippenger<GT>(s, a, e, maxBits);
+    t4.endLap();
+  }
+
+  // Picks one of the above by the number of shares
+  AveragingTimer t5("multExp:        ");
+  for (int i = 0; i < numIters; i++) {
+    t5.startLap();
+    r5 = multExp<GT>(s, a, e, maxBits);
+    t5.endLap();
+  }
+
   LOG_INFO(THRESHSIGN_LOG, "Ran for " << numIters << " iterations");
   LOG_INFO(THRESHSIGN_LOG, t1);
   LOG_INFO(THRESHSIGN_LOG, t2);
   LOG_INFO(THRESHSIGN_LOG, t3);
+  LOG_INFO(THRESHSIGN_LOG, t4);
+  LOG_INFO(THRESHSIGN_LOG, t5);
 
   // Same way?
-  if (r1 != r2 || r1 != r3) {
+  if (r1 != r2 || r1 != r3 || r1 != r4 || r1 != r5) {
     throw std::runtime_error("Incorrect results returned by one of the implementations.");
   }
 }
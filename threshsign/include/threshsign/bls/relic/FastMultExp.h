@@ -45,5 +45,31 @@ GT fastMultExp(const VectorOfShares& s,
 template <class GT>
 GT fastMultExpTwo(const VectorOfShares& s, const std::vector<GT>& a, const std::vector<BNT>& e);
 
+/**
+ * Computes r = \prod_{i \in s} { a[i]^e[i] } with Pippenger's bucket method: the exponents are split into windows of
+ * windowBits bits and, for every window, each base is added once to the bucket of its digit. Costs about
+ * (maxBits / windowBits) * (|s| + 2^(windowBits + 1)) group additions, versus about maxBits * |s| / 2 for fastMultExp.
+ *
+ * The overload without windowBits picks the window that minimizes the number of additions for |s| shares.
+ */
+template <class GT>
+GT multExpPippenger(const VectorOfShares& s, const std::vector<GT>& a, const std::vector<BNT>& e, int maxBits);
+template <class GT>
+GT multExpPippenger(
+    const VectorOfShares& s, const std::vector<GT>& a, const std::vector<BNT>& e, int maxBits, int windowBits);
+
+constexpr int maxPippengerWindowBits = 16;
+
+/**
+ * Returns the window size for which multExpPippenger does the least group additions for count shares.
+ */
+int pippengerWindowBits(int count, int maxBits);
+
+/**
+ * Computes r = \prod_{i \in s} { a[i]^e[i] } with fastMultExp for a few shares and with multExpPippenger for many.
+ */
+template <class GT>
+GT multExp(const VectorOfShares& s, const std::vector<GT>& a, const std::vector<BNT>& e, int maxBits);
+
 }  // namespace Relic
 }  // namespace BLS
@@ -40,7 +40,7 @@ BlsThresholdAccumulator::BlsThresholdAccumulator(const std::vector<BlsPublicKey>
 }
 
 void BlsThresholdAccumulator::computeLagrangeCoeff() {
-  lagrangeCoeffAccumReduced(validSharesBits, coeffs, BLS::Relic::Library::Get().getG2Order());
+  lagrangeCoeffCached(validSharesBits, coeffs, BLS::Relic::Library::Get().getG2Order());
 }
 
 void BlsThresholdAccumulator::exponentiateLagrangeCoeff() {
@@ -51,7 +51,7 @@ void BlsThresholdAccumulator::exponentiateLagrangeCoeff() {
   //}
 
   int maxBits = Library::Get().getG2OrderNumBits();
-  threshSig = fastMultExp<G1T>(validSharesBits, validShares, coeffs, maxBits);
+  threshSig = multExp<G1T>(validSharesBits, validShares, coeffs, maxBits);
 }
 
 } /* namespace Relic */
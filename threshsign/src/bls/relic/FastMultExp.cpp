@@ -12,6 +12,7 @@
 
 #include "threshsign/VectorOfShares.h"
 #include "threshsign/bls/relic/Library.h"
+#include "threshsign/bls/relic/FastMultExp.h"
 
 #include <vector>
 
@@ -80,6 +81,82 @@ GT fastMultExpTwo(const VectorOfShares& s, const std::vector<GT>& a, const std::
   return r;
 }
 
+namespace {
+
+// Number of group additions done by multExpPippenger with a window of c bits, for count shares
+long pippengerCost(int count, int maxBits, int c) {
+  long numWindows = (maxBits + c - 1) / c;
+  // Each window adds every share to a bucket and then sums up the 2^c - 1 buckets with two additions per bucket
+  return numWindows * (count + (2l << c));
+}
+
+}  // namespace
+
+int pippengerWindowBits(int count, int maxBits) {
+  int best = 1;
+  for (int c = 2; c <= maxPippengerWindowBits; c++) {
+    if (pippengerCost(count, maxBits, c) < pippengerCost(count, maxBits, best)) best = c;
+  }
+  return best;
+}
+
+template <class GT>
+GT multExpPippenger(const VectorOfShares& s, const std::vector<GT>& a, const std::vector<BNT>& e, int maxBits) {
+  return multExpPippenger(s, a, e, maxBits, pippengerWindowBits(s.count(), maxBits));
+}
+
+template <class GT>
+GT multExpPippenger(
+    const VectorOfShares& s, const std::vector<GT>& a, const std::vector<BNT>& e, int maxBits, int windowBits) {
+  assertGreaterThanOrEqual(windowBits, 1);
+  assertLessThanOrEqual(windowBits, maxPippengerWindowBits);
+
+  const int numWindows = (maxBits + windowBits - 1) / windowBits;
+  // buckets[d - 1] accumulates the bases whose exponent has digit d in the current window
+  std::vector<GT> buckets(static_cast<size_t>((1 << windowBits) - 1));
+  GT r, running, windowSum;
+  assertEqual(r, GT::Identity());
+
+  for (int w = numWindows - 1; w >= 0; w--) {
+    for (int j = 0; j < windowBits; j++) r.Double();
+
+    for (auto& bucket : buckets) bucket = GT::Identity();
+    for (ShareID i = s.first(); s.isEnd(i) == false; i = s.next(i)) {
+      size_t idx = static_cast<size_t>(i);
+      assertLessThanOrEqual(e[idx].getBits(), maxBits);
+
+      int digit = 0;
+      for (int j = windowBits - 1; j >= 0; j--) {
+        int bit = w * windowBits + j;
+        digit = (digit << 1) | (bit < maxBits && e[idx].getBit(bit) ? 1 : 0);
+      }
+      if (digit != 0) buckets[static_cast<size_t>(digit - 1)].Add(a[idx]);
+    }
+
+    // windowSum = \sum_d d * buckets[d - 1], computed with running sums from the highest digit down
+    running = GT::Identity();
+    windowSum = GT::Identity();
+    for (auto it = buckets.rbegin(); it != buckets.rend(); ++it) {
+      running.Add(*it);
+      windowSum.Add(running);
+    }
+    r.Add(windowSum);
+  }
+
+  return r;
+}
+
+template <class GT>
+GT multExp(const VectorOfShares& s, const std::vector<GT>& a, const std::vector<BNT>& e, int maxBits) {
+  // fastMultExp adds every share for about half of the bits, while Pippenger adds every share once per window, plus
+  // the cost of summing up the buckets, which only pays off for enough shares.
+  int c = pippengerWindowBits(s.count(), maxBits);
+  if (pippengerCost(s.count(), maxBits, c) < static_cast<long>(s.count()) * maxBits / 2) {
+    return multExpPippenger(s, a, e, maxBits, c);
+  }
+  return fastMultExp(s, a, e, maxBits);
+}
+
 /**
  * Template exports
  */
@@ -104,6 +181,22 @@ template G2T fastMultExp<G2T>(const VectorOfShares& s,
                               const std::vector<BNT>& e,
                               int maxBits);
 
+template G1T multExpPippenger<G1T>(const VectorOfShares& s,
+                                   const std::vector<G1T>& a,
+                                   const std::vector<BNT>& e,
+                                   int maxBits);
+template G1T multExpPippenger<G1T>(
+    const VectorOfShares& s, const std::vector<G1T>& a, const std::vector<BNT>& e, int maxBits, int windowBits);
+template G2T multExpPippenger<G2T>(const VectorOfShares& s,
+                                   const std::vector<G2T>& a,
+                                   const std::vector<BNT>& e,
+                                   int maxBits);
+template G2T multExpPippenger<G2T>(
+    const VectorOfShares& s, const std::vector<G2T>& a, const std::vector<BNT>& e, int maxBits, int windowBits);
+
+template G1T multExp<G1T>(const VectorOfShares& s, const std::vector<G1T>& a, const std::vector<BNT>& e, int maxBits);
+template G2T multExp<G2T>(const VectorOfShares& s, const std::vector<G2T>& a, const std::vector<BNT>& e, int maxBits);
+
 template G1T fastMultExpTwo<G1T>(const VectorOfShares& s, const std::vector<G1T>& a, const std::vector<BNT>& e);
 template G2T fastMultExpTwo<G2T>(const VectorOfShares& s, const std::vector<G2T>& a, const std::vector<BNT>& e);
 
@@ -20,8 +20,12 @@
 #include "Logger.hpp"
 #include "XAssert.h"
 #include "Timer.h"
+#include "lru_cache.hpp"
 
 #include <algorithm>
+#include <mutex>
+#include <optional>
+#include <string>
 
 using std::endl;
 
@@ -445,5 +449,54 @@ void lagrangeCoeffNaive(const VectorOfShares& signers, std::vector<BNT>& coeffs,
   LOG_TRACE(BLS_LOG, "Max denominator bits: " << maxDenomBits);
 #endif
 }
+
+namespace {
+
+// Number of distinct sets of signers for which we keep the coefficients (e.g., the sets of a few view changes)
+constexpr size_t lagrangeCoeffCacheCapacity = 64;
+
+// The key is the field order followed by the bitmap of the signers
+std::string lagrangeCoeffCacheKey(const VectorOfShares& signers, const BNT& fieldOrder) {
+  int orderSize = fieldOrder.getByteCount();
+  std::string key(static_cast<size_t>(orderSize + VectorOfShares::getByteCount()), '\0');
+  auto buf = reinterpret_cast<unsigned char*>(key.data());
+  fieldOrder.toBytes(buf, orderSize);
+  signers.toBytes(buf + orderSize, VectorOfShares::getByteCount());
+  return key;
+}
+
+}  // namespace
+
+void lagrangeCoeffCached(const VectorOfShares& signers, std::vector<BNT>& coeffs, const BNT& fieldOrder) {
+  // The coefficients of the signers, in the order in which they appear in 'signers'
+  static concord::util::LruCache<std::string, std::vector<BNT>> cache(lagrangeCoeffCacheCapacity);
+  static std::mutex cacheLock;
+
+  auto key = lagrangeCoeffCacheKey(signers, fieldOrder);
+  std::optional<std::vector<BNT>> cached;
+  {
+    std::lock_guard<std::mutex> lock(cacheLock);
+    cached = cache.get(key);
+  }
+
+  if (!cached.has_value()) {
+    lagrangeCoeffAccumReduced(signers, coeffs, fieldOrder);
+
+    std::vector<BNT> signerCoeffs;
+    signerCoeffs.reserve(static_cast<size_t>(signers.count()));
+    for (ShareID i = signers.first(); signers.isEnd(i) == false; i = signers.next(i)) {
+      signerCoeffs.push_back(coeffs[static_cast<size_t>(i)]);
+    }
+    std::lock_guard<std::mutex> lock(cacheLock);
+    cache.put(key, signerCoeffs);
+    return;
+  }
+
+  size_t j = 0;
+  for (ShareID i = signers.first(); signers.isEnd(i) == false; i = signers.next(i)) {
+    coeffs[static_cast<size_t>(i)] = (*cached)[j++];
+  }
+}
+
 }  // namespace Relic
 }  // namespace BLS
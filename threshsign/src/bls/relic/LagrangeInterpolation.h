@@ -165,5 +165,14 @@ void lagrangeCoeffNaiveReduced(const VectorOfShares& signers, std::vector<BNT>&
  */
 void lagrangeCoeffAccumReduced(const VectorOfShares& signers, std::vector<BNT>& lagrangeCoeffs, const BNT& fieldOrder);
 
+/**
+ * Same as lagrangeCoeffAccumReduced, but keeps the coefficients of the most recently used sets of signers in an LRU
+ * cache. In steady state the same f+1 (or 2f+1) signers keep on combining signatures, so the coefficients are
+ * computed once per set of signers rather than once per threshold signature.
+ *
+ * NOTE: Thread-safe. Only the entries of the signers in lagrangeCoeffs are written.
+ */
+void lagrangeCoeffCached(const VectorOfShares& signers, std::vector<BNT>& lagrangeCoeffs, const BNT& fieldOrder);
+
 }  // namespace Relic
 }  // namespace BLS
@@ -127,6 +127,16 @@ int RelicAppMain(const Library& lib, const std::vector<std::string>& args) {
       LOG_ERROR(THRESHSIGN_LOG, "  lagrCoeffs[" << pos << "] = " << *result.second);
       throw std::runtime_error("Bad coeffs");
     }
+
+    // The first call fills the cache and the second one is served from it
+    for (int i = 0; i < 2; i++) {
+      std::vector<BNT> cachedCoeffs(static_cast<size_t>(numSigners + 1), BNT(0));
+      lagrangeCoeffCached(signers, cachedCoeffs, lib.getG2Order());
+      if (cachedCoeffs != incrCoeffs) {
+        LOG_ERROR(THRESHSIGN_LOG, "Mismatch for cached coeffs (call #" << i + 1 << ")");
+        throw std::runtime_error("Bad coeffs");
+      }
+    }
   }
   return 0;
 }
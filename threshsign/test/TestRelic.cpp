@@ -186,6 +186,13 @@ void testMultiExp() {
   // Same way?
   testAssertEqual(r1, r2);
   testAssertEqual(r1, r3);
+
+  // Pippenger, for a few window sizes, including one that does not divide maxBits
+  for (int windowBits = 1; windowBits <= 7; windowBits++) {
+    testAssertEqual(r1, multExpPippenger<GT>(s, a, e, maxBits, windowBits));
+  }
+  testAssertEqual(r1, multExpPippenger<GT>(s, a, e, maxBits));
+  testAssertEqual(r1, multExp<GT>(s, a, e, maxBits));
 }
 
 void testFastModulo(const BNT& fieldOrder) {
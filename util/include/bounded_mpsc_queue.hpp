@@ -0,0 +1,154 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "assertUtils.hpp"
+
+namespace concord::util {
+
+// A bounded, lock-free multi-producer single-consumer queue.
+//
+// Every slot carries a "turn" counter which tells producers and the consumer whose turn it is to access the slot:
+// an even turn means the slot is free for the (turn / 2)-th lap of producers, an odd turn means it holds a value for
+// the consumer. Producers claim a position with a CAS on the head and the single consumer advances the tail without
+// any atomic read-modify-write. Works for any capacity >= 1 (no power-of-two rounding), so the bound is exact.
+//
+// Based on Erik Rigtorp's MPMCQueue: https://github.com/rigtorp/MPMCQueue
+template <typename T>
+class BoundedMpscQueue {
+ public:
+  explicit BoundedMpscQueue(std::size_t capacity)
+      : capacity_{capacity}, slots_{std::make_unique<Slot[]>(capacity_)} {
+    ConcordAssertGT(capacity_, 0);
+  }
+
+  BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+  BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+
+  // Thread-safe for any number of producers. Returns false if the queue is full.
+  template <typename U>
+  bool tryPush(U&& value) {
+    auto head = head_.load(std::memory_order_acquire);
+    while (true) {
+      auto& slot = slots_[idx(head)];
+      if (turn(head) * 2 == slot.turn.load(std::memory_order_acquire)) {
+        if (head_.compare_exchange_strong(head, head + 1)) {
+          slot.value.emplace(std::forward<U>(value));
+          slot.turn.store(turn(head) * 2 + 1, std::memory_order_release);
+          return true;
+        }
+      } else {
+        const auto prev_head = head;
+        head = head_.load(std::memory_order_acquire);
+        if (head == prev_head) {
+          return false;
+        }
+      }
+    }
+  }
+
+  // Must only be called from the consumer thread. Returns false if the queue is empty.
+  bool tryPop(T& out) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    auto& slot = slots_[idx(tail)];
+    if (turn(tail) * 2 + 1 != slot.turn.load(std::memory_order_acquire)) {
+      return false;
+    }
+    out = std::move(*slot.value);
+    slot.value.reset();
+    slot.turn.store(turn(tail) * 2 + 2, std::memory_order_release);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Must only be called from the consumer thread. Returns the oldest element or nullptr if the queue is empty. The
+  // pointer stays valid until the element is popped.
+  const T* front() const {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto& slot = slots_[idx(tail)];
+    if (turn(tail) * 2 + 1 != slot.turn.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &*slot.value;
+  }
+
+  // Must only be called from the consumer thread. Drops all elements that are visible at the time of the call.
+  void clear() {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot = slots_[idx(tail)];
+      if (turn(tail) * 2 + 1 != slot.turn.load(std::memory_order_acquire)) {
+        break;
+      }
+      slot.value.reset();
+      slot.turn.store(turn(tail) * 2 + 2, std::memory_order_release);
+      tail_.store(++tail, std::memory_order_release);
+    }
+  }
+
+  // The number of elements the consumer can pop without waiting, i.e. the published elements up to the first one whose
+  // position has been claimed by a producer which didn't finish writing it yet. This is a snapshot only and might be
+  // outdated as soon as it is returned if producers or the consumer are active. Linear in the number of elements.
+  std::size_t size() const {
+    const auto tail = tail_.load(std::memory_order_acquire);
+    const auto head = head_.load(std::memory_order_acquire);
+    auto size = std::size_t{0};
+    for (auto pos = tail; pos < head && published(pos); ++pos) {
+      ++size;
+    }
+    return size;
+  }
+
+  // Whether there is no element the consumer can pop without waiting. If false, front() doesn't return nullptr when
+  // called by the consumer afterwards.
+  bool empty() const { return !published(tail_.load(std::memory_order_acquire)); }
+
+  // Whether a push would fail. Positions claimed by producers count, even if not yet published.
+  bool full() const {
+    const auto tail = tail_.load(std::memory_order_acquire);
+    const auto head = head_.load(std::memory_order_acquire);
+    return head > tail && head - tail >= capacity_;
+  }
+
+  std::size_t capacity() const { return capacity_; }
+
+ private:
+  // Align slots and counters to cache lines in order to avoid false sharing between producers and the consumer.
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  struct alignas(kCacheLineSize) Slot {
+    std::atomic_uint64_t turn{0};
+    std::optional<T> value;
+  };
+
+  std::size_t idx(std::uint64_t pos) const { return pos % capacity_; }
+  std::uint64_t turn(std::uint64_t pos) const { return pos / capacity_; }
+  bool published(std::uint64_t pos) const {
+    return turn(pos) * 2 + 1 == slots_[idx(pos)].turn.load(std::memory_order_acquire);
+  }
+
+  const std::size_t capacity_;
+  const std::unique_ptr<Slot[]> slots_;
+  alignas(kCacheLineSize) std::atomic_uint64_t head_{0};
+  alignas(kCacheLineSize) std::atomic_uint64_t tail_{0};
+};
+
+}  // namespace concord::util
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <functional>
 #include <list>
 #include <optional>
 #include <unordered_map>
@@ -21,7 +22,7 @@
 
 namespace concord::util {
 
-template <typename Key, typename Value>
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
 class LruCache {
  public:
   LruCache(size_t capacity) : capacity_(capacity) { map_.reserve(capacity); }
@@ -54,6 +55,19 @@ class LruCache {
     }
   }
 
+  void erase(const Key& key) {
+    auto iter = map_.find(key);
+    if (iter != map_.end()) {
+      keys_.erase(iter->second.second);
+      map_.erase(iter);
+    }
+  }
+
+  void clear() {
+    map_.clear();
+    keys_.clear();
+  }
+
   size_t size() const {
     ConcordAssertEQ(map_.size(), keys_.size());
     return keys_.size();
@@ -78,7 +92,7 @@ class LruCache {
 
   // Access list from most recently used at the front, to least recently used at the back
   std::list<Key> keys_;
-  std::unordered_map<Key, MapVal> map_;
+  std::unordered_map<Key, MapVal, Hash> map_;
 
   Stats stats_;
 };
@@ -0,0 +1,155 @@
+// Concord
+//
+// Copyright (c) 2021 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0
+// License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+//
+
+#include "gtest/gtest.h"
+#include "bounded_mpsc_queue.hpp"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace concord::util;
+
+TEST(BoundedMpscQueueTest, push_pop_in_order) {
+  auto queue = BoundedMpscQueue<int>(3);
+  ASSERT_TRUE(queue.empty());
+  ASSERT_EQ(nullptr, queue.front());
+
+  ASSERT_TRUE(queue.tryPush(1));
+  ASSERT_TRUE(queue.tryPush(2));
+  ASSERT_TRUE(queue.tryPush(3));
+  ASSERT_TRUE(queue.full());
+  ASSERT_EQ(3, queue.size());
+
+  // The bound is exact and not rounded up.
+  ASSERT_FALSE(queue.tryPush(4));
+
+  ASSERT_EQ(1, *queue.front());
+  auto out = 0;
+  ASSERT_TRUE(queue.tryPop(out));
+  ASSERT_EQ(1, out);
+  ASSERT_TRUE(queue.tryPush(4));
+  for (auto expected : {2, 3, 4}) {
+    ASSERT_TRUE(queue.tryPop(out));
+    ASSERT_EQ(expected, out);
+  }
+  ASSERT_FALSE(queue.tryPop(out));
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(BoundedMpscQueueTest, capacity_of_one) {
+  auto queue = BoundedMpscQueue<std::string>(1);
+  auto out = std::string{};
+  for (auto i = 0; i < 10; ++i) {
+    ASSERT_TRUE(queue.tryPush(std::to_string(i)));
+    ASSERT_FALSE(queue.tryPush("x"));
+    ASSERT_TRUE(queue.tryPop(out));
+    ASSERT_EQ(std::to_string(i), out);
+  }
+}
+
+TEST(BoundedMpscQueueTest, move_only_values) {
+  auto queue = BoundedMpscQueue<std::unique_ptr<int>>(2);
+  ASSERT_TRUE(queue.tryPush(std::make_unique<int>(42)));
+  auto out = std::unique_ptr<int>{};
+  ASSERT_TRUE(queue.tryPop(out));
+  ASSERT_EQ(42, *out);
+}
+
+TEST(BoundedMpscQueueTest, clear) {
+  auto queue = BoundedMpscQueue<int>(4);
+  for (auto i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.tryPush(i));
+  }
+  queue.clear();
+  ASSERT_TRUE(queue.empty());
+  ASSERT_TRUE(queue.tryPush(5));
+  auto out = 0;
+  ASSERT_TRUE(queue.tryPop(out));
+  ASSERT_EQ(5, out);
+}
+
+TEST(BoundedMpscQueueTest, multiple_producers) {
+  constexpr auto kProducers = 4;
+  constexpr auto kPerProducer = 10000;
+  auto queue = BoundedMpscQueue<std::pair<int, int>>(64);
+
+  auto producers = std::vector<std::thread>{};
+  for (auto p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&queue, p]() {
+      for (auto i = 0; i < kPerProducer; ++i) {
+        while (!queue.tryPush(std::make_pair(p, i))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // Elements of a single producer must be received in the order they were pushed.
+  auto next = std::vector<int>(kProducers, 0);
+  auto received = 0;
+  auto out = std::pair<int, int>{};
+  while (received < kProducers * kPerProducer) {
+    if (!queue.tryPop(out)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(next[out.first], out.second);
+    ++next[out.first];
+    ++received;
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  ASSERT_TRUE(queue.empty());
+}
+
+// A position claimed by a producer that didn't finish writing the element yet must not make the queue look non-empty.
+TEST(BoundedMpscQueueTest, non_empty_queue_has_front) {
+  constexpr auto kProducers = 4;
+  constexpr auto kPerProducer = 10000;
+  auto queue = BoundedMpscQueue<std::string>(8);
+
+  auto producers = std::vector<std::thread>{};
+  for (auto p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&queue]() {
+      for (auto i = 0; i < kPerProducer; ++i) {
+        // Large enough to not fit into the small string buffer, i.e. writing the element takes a while.
+        while (!queue.tryPush(std::string(64, 'x'))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  auto received = 0;
+  auto out = std::string{};
+  while (received < kProducers * kPerProducer) {
+    const auto size = queue.size();
+    if (queue.empty()) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_NE(nullptr, queue.front());
+    ASSERT_TRUE(queue.tryPop(out));
+    ASSERT_LE(size, queue.capacity());
+    ++received;
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  ASSERT_TRUE(queue.empty());
+  ASSERT_EQ(0, queue.size());
+}
@@ -81,3 +81,27 @@ TEST(LruTest, lots_of_puts) {
   ASSERT_EQ(5, *cache.get(5));
   ASSERT_EQ(100, *cache.get(1));
 }
+
+TEST(LruTest, erase) {
+  auto cache = LruCache<int, int>(3);
+  cache.put(1, 1);
+  cache.put(2, 2);
+  cache.put(3, 3);
+
+  cache.erase(2);
+  cache.erase(4);
+  ASSERT_EQ(2, cache.size());
+  ASSERT_EQ(std::nullopt, cache.get(2));
+
+  // The erased slot is reused without evicting anything
+  cache.put(4, 4);
+  ASSERT_EQ(1, *cache.get(1));
+  ASSERT_EQ(3, *cache.get(3));
+  ASSERT_EQ(4, *cache.get(4));
+
+  cache.clear();
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(std::nullopt, cache.get(1));
+  cache.put(5, 5);
+  ASSERT_EQ(5, *cache.get(5));
+}